@@ -124,7 +124,8 @@ int32 UContentValidationCommandlet::Main(const FString& FullCommandLine)
 		}
 	}
 
-	int32 MaxPackagesToLoad = 2000;
+	// No limit by default, unchanged packages are skipped through the validation cache
+	int32 MaxPackagesToLoad = 0;
 
 	FString* InPathString = Params.Find(TEXT("InPath"));
 	if (InPathString && !InPathString->IsEmpty())
@@ -135,9 +136,7 @@ int32 UContentValidationCommandlet::Main(const FString& FullCommandLine)
 	FString* OfTypeString = Params.Find(TEXT("OfType"));
 	if (OfTypeString && !OfTypeString->IsEmpty())
 	{
-		const int32 InitialPackages = ChangedPackageNames.Num();
 		GetAllPackagesOfType(*OfTypeString, ChangedPackageNames);
-		MaxPackagesToLoad += ChangedPackageNames.Num() - InitialPackages;
 	}
 
 	FString* SpecificPackagesString = Params.Find(TEXT("Packages"));
@@ -4,6 +4,7 @@
 
 #include "AssetRegistry/ARFilter.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
 #include "Blueprint/BlueprintSupport.h"
 #include "Editor.h"
 #include "EditorValidatorSubsystem.h"
@@ -12,10 +13,16 @@
 #include "ISourceControlProvider.h"
 #include "Logging/MessageLog.h"
 #include "UltraEditor.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
 #include "Misc/MessageDialog.h"
 #include "Misc/PackageName.h"
+#include "Misc/Paths.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
 #include "Settings/ProjectPackagingSettings.h"
 #include "ShaderCompiler.h"
 #include "SourceCodeNavigation.h"
@@ -31,6 +38,162 @@
 int32 GMaxAssetsChangedByAHeader = 200;
 static FAutoConsoleVariableRef CVarMaxAssetsChangedByAHeader(TEXT("EditorValidator.MaxAssetsChangedByAHeader"), GMaxAssetsChangedByAHeader, TEXT("The maximum number of assets to check for content validation based on a single header change."), ECVF_Default);
 
+int32 GValidationLoadBatchSize = 64;
+static FAutoConsoleVariableRef CVarValidationLoadBatchSize(TEXT("EditorValidator.LoadBatchSize"), GValidationLoadBatchSize, TEXT("The number of packages loaded asynchronously and validated together during content validation."), ECVF_Default);
+
+bool GUseValidationCache = true;
+static FAutoConsoleVariableRef CVarUseValidationCache(TEXT("EditorValidator.UseValidationCache"), GUseValidationCache, TEXT("Skip packages that passed validation before if neither they nor their direct dependencies changed since."), ECVF_Default);
+
+namespace UltraValidationCache
+{
+	// Bump whenever a validator changes in a way that should throw away previous passes
+	static const int32 Version = 2;
+
+	static FString GetFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ValidationCache") / TEXT("ValidationCache.txt");
+	}
+
+	/** Everything besides the package contents that can change the outcome of validation */
+	static FString GetVersionKey(const EDataValidationUsecase InValidationUsecase)
+	{
+		TArray<FString> ValidatorClassNames;
+		for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+		{
+			if (ClassIt->IsChildOf(UEditorValidatorBase::StaticClass()) && !ClassIt->HasAnyClassFlags(CLASS_Abstract))
+			{
+				ValidatorClassNames.Add(ClassIt->GetPathName());
+			}
+		}
+		ValidatorClassNames.Sort();
+
+		// Assets are validated against the loaded game and editor code, so any rebuild of a project module
+		// (e.g. after a header change picked up by GetChangedAssetsForCode) invalidates every previous pass
+		TArray<FModuleStatus> ModuleStatuses;
+		FModuleManager::Get().QueryModules(ModuleStatuses);
+		const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+		TArray<FString> ProjectModuleBuilds;
+		for (const FModuleStatus& ModuleStatus : ModuleStatuses)
+		{
+			const FString ModuleFilename = FPaths::ConvertRelativePathToFull(ModuleStatus.FilePath);
+			if (ModuleStatus.bIsLoaded && ModuleFilename.StartsWith(ProjectDir))
+			{
+				ProjectModuleBuilds.Add(FString::Printf(TEXT("%s@%s"), *ModuleStatus.Name, *IFileManager::Get().GetTimeStamp(*ModuleFilename).ToString()));
+			}
+		}
+		ProjectModuleBuilds.Sort();
+
+		FString KeySource = FString::Printf(TEXT("%d|%u|%d|%d|"), Version, FEngineVersion::Current().GetChangelist(), (int32)InValidationUsecase, UEditorValidator::ShouldAllowFullValidation() ? 1 : 0);
+		KeySource += FString::Join(ValidatorClassNames, TEXT(","));
+		KeySource += TEXT("|");
+		KeySource += FString::Join(ProjectModuleBuilds, TEXT(","));
+		return FMD5::HashAnsiString(*KeySource);
+	}
+
+	static void Load(const FString& VersionKey, TMap<FString, FString>& OutEntries)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *GetFilename()) || (Lines.Num() == 0) || (Lines[0] != VersionKey))
+		{
+			return;
+		}
+
+		for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+		{
+			FString PackageName;
+			FString PackageKey;
+			if (Lines[LineIndex].Split(TEXT("="), &PackageName, &PackageKey))
+			{
+				OutEntries.Add(MoveTemp(PackageName), MoveTemp(PackageKey));
+			}
+		}
+	}
+
+	static void Save(const FString& VersionKey, const TMap<FString, FString>& Entries)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(Entries.Num() + 1);
+		Lines.Add(VersionKey);
+		for (const TPair<FString, FString>& Entry : Entries)
+		{
+			Lines.Add(Entry.Key + TEXT("=") + Entry.Value);
+		}
+
+		if (!FFileHelper::SaveStringArrayToFile(Lines, *GetFilename()))
+		{
+			UE_LOG(LogUltraEditor, Warning, TEXT("Failed to write the validation cache to %s"), *GetFilename());
+		}
+	}
+
+	/**
+	 * Computes a key per package from the bytes of the package and of its direct hard dependencies,
+	 * so a package is revalidated when something it references changes or goes away.
+	 * File hashing runs in parallel.
+	 */
+	static void ComputePackageKeys(IAssetRegistry& AssetRegistry, const TArray<FString>& PackageNames, TArray<FString>& OutPackageKeys)
+	{
+		TMap<FName, int32> FileIndices;
+		TArray<FString> Filenames;
+		TArray<TArray<FName>> PackageDependencies;
+		PackageDependencies.SetNum(PackageNames.Num());
+
+		auto AddFileToHash = [&FileIndices, &Filenames](FName PackageName)
+		{
+			if (!FileIndices.Contains(PackageName))
+			{
+				FString Filename;
+				if (FPackageName::DoesPackageExist(PackageName.ToString(), &Filename))
+				{
+					FileIndices.Add(PackageName, Filenames.Add(Filename));
+				}
+				else
+				{
+					FileIndices.Add(PackageName, INDEX_NONE);
+				}
+			}
+		};
+
+		for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+		{
+			const FName PackageFName(*PackageNames[PackageIndex]);
+			AddFileToHash(PackageFName);
+
+			TArray<FName>& Dependencies = PackageDependencies[PackageIndex];
+			AssetRegistry.GetDependencies(PackageFName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+			Dependencies.RemoveAll([](FName Dependency) { return FPackageName::IsScriptPackage(Dependency.ToString()); });
+			Dependencies.Sort(FNameLexicalLess());
+			for (FName Dependency : Dependencies)
+			{
+				AddFileToHash(Dependency);
+			}
+		}
+
+		TArray<FString> FileHashes;
+		FileHashes.SetNum(Filenames.Num());
+		ParallelFor(Filenames.Num(), [&Filenames, &FileHashes](int32 FileIndex)
+		{
+			FileHashes[FileIndex] = LexToString(FMD5Hash::HashFile(*Filenames[FileIndex]));
+		});
+
+		auto GetFileHash = [&FileIndices, &FileHashes](FName PackageName)
+		{
+			const int32 FileIndex = FileIndices.FindChecked(PackageName);
+			return (FileIndex != INDEX_NONE) ? FileHashes[FileIndex] : FString(TEXT("missing"));
+		};
+
+		OutPackageKeys.SetNum(PackageNames.Num());
+		for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+		{
+			FString KeySource = GetFileHash(FName(*PackageNames[PackageIndex]));
+			for (FName Dependency : PackageDependencies[PackageIndex])
+			{
+				KeySource += FString::Printf(TEXT("|%s:%s"), *Dependency.ToString(), *GetFileHash(Dependency));
+			}
+			OutPackageKeys[PackageIndex] = FMD5::HashAnsiString(*KeySource);
+		}
+	}
+}
+
 bool UEditorValidator::bAllowFullValidationInEditor = false;
 TArray<FString> FUltraValidationMessageGatherer::IgnorePatterns;
 
@@ -117,7 +280,7 @@ void UEditorValidator::ValidateCheckedOutContent(bool bInteractive, const EDataV
 		{
 			FScopedSlowTask SlowTask(0.f, LOCTEXT("CheckingContentTask", "Checking content..."));
 			SlowTask.MakeDialog();
-			if (!ValidatePackages(ChangedPackageNames, DeletedPackageNames, 2000, AllWarningsAndErrors, InValidationUsecase))
+			if (!ValidatePackages(ChangedPackageNames, DeletedPackageNames, 0, AllWarningsAndErrors, InValidationUsecase))
 			{
 				bAnyIssuesFound = true;
 			}
@@ -182,102 +345,160 @@ bool UEditorValidator::ValidatePackages(const TArray<FString>& ExistingPackageNa
 	FMessageLog DataValidationLog("AssetCheck");
 	DataValidationLog.NewPage(LOCTEXT("ValidatePackages", "Validate Packages"));
 
-	if (AllPackagesToValidate.Num() > MaxPackagesToLoad)
-	{
-		// Too much changed to verify, just pass it.
-		FString WarningMessage = FString::Printf(TEXT("Assets to validate (%d) exceeded -MaxPackagesToLoad=(%d). Skipping existing package validation."), AllPackagesToValidate.Num(), MaxPackagesToLoad);
-		UE_LOG(LogUltraEditor, Warning, TEXT("%s"), *WarningMessage);
-		OutAllWarningsAndErrors.Add(WarningMessage);
-		DataValidationLog.Warning(FText::FromString(WarningMessage));
-	}
-	else
+	// Find the assets in every package, reporting packages that have none
+	TArray<FString> PackagesWithAssets;
+	TSet<FString> SeenPackageNames;
+	for (const FString& PackageName : AllPackagesToValidate)
 	{
-		// Load all packages that match the file filter string
-		TArray<FAssetData> AssetsToCheck;
-		for (const FString& PackageName : AllPackagesToValidate)
+		bool bAlreadySeen = false;
+		SeenPackageNames.Add(PackageName, &bAlreadySeen);
+		if (!bAlreadySeen && FPackageName::IsValidLongPackageName(PackageName) && !IsInUncookedFolder(PackageName))
 		{
-			if (FPackageName::IsValidLongPackageName(PackageName) && !IsInUncookedFolder(PackageName))
+			TArray<FAssetData> PackageAssets;
+			AssetRegistry.GetAssetsByPackageName(FName(*PackageName), PackageAssets, true);
+			if (PackageAssets.Num() > 0)
+			{
+				PackagesWithAssets.Add(PackageName);
+			}
+			else
 			{
-				int32 OldNumAssets = AssetsToCheck.Num();
-				AssetRegistry.GetAssetsByPackageName(FName(*PackageName), AssetsToCheck, true);
-				if (AssetsToCheck.Num() == OldNumAssets)
+				FString WarningMessage;
+				// See if the file exists at all. Otherwise, the package contains no assets.
+				if (FPackageName::DoesPackageExist(PackageName))
 				{
-					FString WarningMessage;
-					// See if the file exists at all. Otherwise, the package contains no assets.
-					if (FPackageName::DoesPackageExist(PackageName))
-					{
-						WarningMessage = FString::Printf(TEXT("Found no assets in package '%s'"), *PackageName);
-					}
-					else
+					WarningMessage = FString::Printf(TEXT("Found no assets in package '%s'"), *PackageName);
+				}
+				else
+				{
+					if (ISourceControlModule::Get().IsEnabled())
 					{
-						if (ISourceControlModule::Get().IsEnabled())
+						ISourceControlProvider& SourceControlProvider = ISourceControlModule::Get().GetProvider();
+						FString PackageFilename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+						TSharedPtr<ISourceControlState, ESPMode::ThreadSafe> FileState = SourceControlProvider.GetState(PackageFilename, EStateCacheUsage::ForceUpdate);
+						if (FileState->IsAdded())
 						{
-							ISourceControlProvider& SourceControlProvider = ISourceControlModule::Get().GetProvider();
-							FString PackageFilename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-							TSharedPtr<ISourceControlState, ESPMode::ThreadSafe> FileState = SourceControlProvider.GetState(PackageFilename, EStateCacheUsage::ForceUpdate);
-							if (FileState->IsAdded())
-							{
-								WarningMessage = FString::Printf(TEXT("Package '%s' is missing from disk. It is marked for add in perforce but missing from your hard drive."), *PackageName);
-							}
-
-							if (FileState->IsCheckedOut())
-							{
-								WarningMessage = FString::Printf(TEXT("Package '%s' is missing from disk. It is checked out in perforce but missing from your hard drive."), *PackageName);
-							}
+							WarningMessage = FString::Printf(TEXT("Package '%s' is missing from disk. It is marked for add in perforce but missing from your hard drive."), *PackageName);
 						}
 
-						if (WarningMessage.IsEmpty())
+						if (FileState->IsCheckedOut())
 						{
-							WarningMessage = FString::Printf(TEXT("Package '%s' is missing from disk."), *PackageName);
+							WarningMessage = FString::Printf(TEXT("Package '%s' is missing from disk. It is checked out in perforce but missing from your hard drive."), *PackageName);
 						}
 					}
-					ensure(!WarningMessage.IsEmpty());
-					UE_LOG(LogUltraEditor, Warning, TEXT("%s"), *WarningMessage);
-					OutAllWarningsAndErrors.Add(WarningMessage);
-					DataValidationLog.Warning(FText::FromString(WarningMessage));
-					bAnyIssuesFound = true;
+
+					if (WarningMessage.IsEmpty())
+					{
+						WarningMessage = FString::Printf(TEXT("Package '%s' is missing from disk."), *PackageName);
+					}
 				}
+				ensure(!WarningMessage.IsEmpty());
+				UE_LOG(LogUltraEditor, Warning, TEXT("%s"), *WarningMessage);
+				OutAllWarningsAndErrors.Add(WarningMessage);
+				DataValidationLog.Warning(FText::FromString(WarningMessage));
+				bAnyIssuesFound = true;
 			}
 		}
+	}
 
-		if (AssetsToCheck.Num() > 0)
+	// Skip packages that already passed with the same contents, dependencies and validators
+	const bool bUseCache = GUseValidationCache && !FParse::Param(FCommandLine::Get(), TEXT("NoValidationCache"));
+	const FString CacheVersionKey = bUseCache ? UltraValidationCache::GetVersionKey(InValidationUsecase) : FString();
+	TMap<FString, FString> CacheEntries;
+	TArray<FString> PackageKeys;
+	if (bUseCache)
+	{
+		UltraValidationCache::Load(CacheVersionKey, CacheEntries);
+		UltraValidationCache::ComputePackageKeys(AssetRegistry, PackagesWithAssets, PackageKeys);
+	}
+
+	TArray<FString> PackagesToLoad;
+	TArray<FString> PackagesToLoadKeys;
+	for (int32 PackageIndex = 0; PackageIndex < PackagesWithAssets.Num(); ++PackageIndex)
+	{
+		if (bUseCache)
 		{
-			// Preload all assets to check, so load warnings can be handled separately from validation warnings
+			const FString* CachedKey = CacheEntries.Find(PackagesWithAssets[PackageIndex]);
+			if (CachedKey && (*CachedKey == PackageKeys[PackageIndex]))
 			{
-				for (const FAssetData& AssetToCheck : AssetsToCheck)
-				{
-					if (!AssetToCheck.IsAssetLoaded())
-					{
-						UE_LOG(LogUltraEditor, Display, TEXT("Preloading %s..."), *AssetToCheck.GetObjectPathString());
+				continue;
+			}
+			PackagesToLoadKeys.Add(PackageKeys[PackageIndex]);
+		}
+		PackagesToLoad.Add(PackagesWithAssets[PackageIndex]);
+	}
 
-						// Start listening for load warnings
-						FUltraValidationMessageGatherer ScopedPreloadMessageGatherer;
-						
-						// Load the asset
-						AssetToCheck.GetAsset();
+	if (bUseCache)
+	{
+		UE_LOG(LogUltraEditor, Display, TEXT("Validation cache: %d of %d packages unchanged since they last passed, validating %d"), PackagesWithAssets.Num() - PackagesToLoad.Num(), PackagesWithAssets.Num(), PackagesToLoad.Num());
+	}
 
-						if (ScopedPreloadMessageGatherer.GetAllWarningsAndErrors().Num() > 0)
-						{
-							// Repeat all errant load warnings as errors, so other CIS systems can treat them more severely (i.e. Build health will create an issue and assign it to a developer)
-							for (const FString& LoadWarning : ScopedPreloadMessageGatherer.GetAllWarnings())
-							{
-								UE_LOG(LogUltraEditor, Error, TEXT("%s"), *LoadWarning);
-							}
+	if ((MaxPackagesToLoad > 0) && (PackagesToLoad.Num() > MaxPackagesToLoad))
+	{
+		// Too much changed to verify, just pass it.
+		FString WarningMessage = FString::Printf(TEXT("Assets to validate (%d) exceeded -MaxPackagesToLoad=(%d). Skipping existing package validation."), PackagesToLoad.Num(), MaxPackagesToLoad);
+		UE_LOG(LogUltraEditor, Warning, TEXT("%s"), *WarningMessage);
+		OutAllWarningsAndErrors.Add(WarningMessage);
+		DataValidationLog.Warning(FText::FromString(WarningMessage));
+		return !bAnyIssuesFound;
+	}
 
-							OutAllWarningsAndErrors.Append(ScopedPreloadMessageGatherer.GetAllWarningsAndErrors());
-							bAnyIssuesFound = true;
-						}
-					}
+	// Load and validate in batches so the packages of a batch are loaded asynchronously together and, in a commandlet, memory can be reclaimed between batches.
+	// Batches are not prefetched while the previous one is validated, so load warnings stay attributed to the batch that caused them.
+	const int32 BatchSize = FMath::Max(GValidationLoadBatchSize, 1);
+	for (int32 BatchStart = 0; BatchStart < PackagesToLoad.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, PackagesToLoad.Num());
+		bool bBatchPassed = true;
+
+		TArray<FAssetData> AssetsToCheck;
+		for (int32 PackageIndex = BatchStart; PackageIndex < BatchEnd; ++PackageIndex)
+		{
+			AssetRegistry.GetAssetsByPackageName(FName(*PackagesToLoad[PackageIndex]), AssetsToCheck, true);
+		}
+
+		// Preload all assets to check, so load warnings can be handled separately from validation warnings
+		{
+			// Start listening for load warnings
+			FUltraValidationMessageGatherer ScopedPreloadMessageGatherer;
+
+			for (int32 PackageIndex = BatchStart; PackageIndex < BatchEnd; ++PackageIndex)
+			{
+				if (FindPackage(nullptr, *PackagesToLoad[PackageIndex]) == nullptr)
+				{
+					UE_LOG(LogUltraEditor, Display, TEXT("Preloading %s..."), *PackagesToLoad[PackageIndex]);
+					LoadPackageAsync(PackagesToLoad[PackageIndex]);
 				}
 			}
+			FlushAsyncLoading();
 
-			// Run all validators now.
+			// Anything the async load did not bring in is loaded synchronously here
+			for (const FAssetData& AssetToCheck : AssetsToCheck)
+			{
+				AssetToCheck.GetAsset();
+			}
+
+			if (ScopedPreloadMessageGatherer.GetAllWarningsAndErrors().Num() > 0)
+			{
+				// Repeat all errant load warnings as errors, so other CIS systems can treat them more severely (i.e. Build health will create an issue and assign it to a developer)
+				for (const FString& LoadWarning : ScopedPreloadMessageGatherer.GetAllWarnings())
+				{
+					UE_LOG(LogUltraEditor, Error, TEXT("%s"), *LoadWarning);
+				}
+
+				OutAllWarningsAndErrors.Append(ScopedPreloadMessageGatherer.GetAllWarningsAndErrors());
+				bAnyIssuesFound = true;
+				bBatchPassed = false;
+			}
+		}
+
+		// Run all validators now. They touch UObjects, so this stays on the game thread.
+		{
 			FUltraValidationMessageGatherer ScopedMessageGatherer;
 			FValidateAssetsSettings Settings;
 			FValidateAssetsResults Results;
 
 			Settings.bSkipExcludedDirectories = true;
-			Settings.bShowIfNoFailures = true;
+			Settings.bShowIfNoFailures = (BatchEnd == PackagesToLoad.Num());
 			Settings.ValidationUsecase = InValidationUsecase;
 
 			const bool bHasInvalidFiles = GEditor->GetEditorSubsystem<UEditorValidatorSubsystem>()->ValidateAssetsWithSettings(AssetsToCheck, Settings, Results) > 0;
@@ -286,8 +507,35 @@ bool UEditorValidator::ValidatePackages(const TArray<FString>& ExistingPackageNa
 			{
 				OutAllWarningsAndErrors.Append(ScopedMessageGatherer.GetAllWarningsAndErrors());
 				bAnyIssuesFound = true;
+				bBatchPassed = false;
+			}
+		}
+
+		// Messages can't be reliably attributed to a single package, so only a fully clean batch is remembered
+		if (bUseCache)
+		{
+			for (int32 PackageIndex = BatchStart; PackageIndex < BatchEnd; ++PackageIndex)
+			{
+				if (bBatchPassed)
+				{
+					CacheEntries.Add(PackagesToLoad[PackageIndex], PackagesToLoadKeys[PackageIndex]);
+				}
+				else
+				{
+					CacheEntries.Remove(PackagesToLoad[PackageIndex]);
+				}
 			}
 		}
+
+		if (IsRunningCommandlet())
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	if (bUseCache)
+	{
+		UltraValidationCache::Save(CacheVersionKey, CacheEntries);
 	}
 
 	return !bAnyIssuesFound;
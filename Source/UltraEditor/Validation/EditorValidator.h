@@ -86,6 +86,11 @@ public:
 	UEditorValidator();
 
 	static void ValidateCheckedOutContent(bool bInteractive, const EDataValidationUsecase InValidationUsecase);
+	/**
+	 * Loads the packages in asynchronous batches and runs all validators on them.
+	 * Packages that passed before and whose contents, direct dependencies, validators and project module builds are unchanged are skipped (see EditorValidator.UseValidationCache, -NoValidationCache).
+	 * A MaxPackagesToLoad of zero or less means no limit.
+	 */
 	static bool ValidatePackages(const TArray<FString>& ExistingPackageNames, const TArray<FString>& DeletedPackageNames, int32 MaxPackagesToLoad, TArray<FString>& OutAllWarningsAndErrors, const EDataValidationUsecase InValidationUsecase);
 	static bool ValidateProjectSettings();
 
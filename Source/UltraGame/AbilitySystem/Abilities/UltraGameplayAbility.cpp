@@ -15,6 +15,7 @@
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "AbilitySystem/UltraAbilitySourceInterface.h"
 #include "AbilitySystem/UltraGameplayEffectContext.h"
+#include "AbilitySystem/Executions/UltraScoreExecution.h"
 #include "Physics/PhysicalMaterialWithTags.h"
 #include "GameFramework/PlayerState.h"
 #include "Camera/UltraCameraMode.h"
@@ -274,6 +275,100 @@ void UUltraGameplayAbility::ApplyCost(const FGameplayAbilitySpecHandle Handle, c
 	}
 }
 
+TArray<FActiveGameplayEffectHandle> UUltraGameplayAbility::ApplyScoreEffectToTargetsBatched(TSubclassOf<UGameplayEffect> GameplayEffectClass, const FGameplayAbilityTargetDataHandle& TargetData, float GameplayEffectLevel)
+{
+	TArray<FActiveGameplayEffectHandle> EffectHandles;
+
+	const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+	UAbilitySystemComponent* SourceASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+	if (!SourceASC || !GameplayEffectClass || !HasAuthority(&CurrentActivationInfo))
+	{
+		return EffectHandles;
+	}
+
+	// Gather the per-target inputs
+	TArray<FUltraScoreBatchTarget> BatchTargets;
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : TargetData.Data)
+	{
+		if (!Data.IsValid())
+		{
+			continue;
+		}
+
+		const FHitResult* HitResult = Data->GetHitResult();
+		for (const TWeakObjectPtr<AActor>& WeakTargetActor : Data->GetActors())
+		{
+			AActor* TargetActor = WeakTargetActor.Get();
+			UAbilitySystemComponent* TargetASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(TargetActor);
+			if (TargetASC == nullptr)
+			{
+				continue;
+			}
+
+			FUltraScoreBatchTarget& BatchTarget = BatchTargets.AddDefaulted_GetRef();
+			BatchTarget.TargetASC = TargetASC;
+			BatchTarget.HitActor = TargetActor;
+
+			if (HitResult && (HitResult->HitObjectHandle.FetchActor() == TargetActor))
+			{
+				BatchTarget.HitResult = HitResult;
+				BatchTarget.ImpactLocation = HitResult->ImpactPoint;
+				BatchTarget.PhysicalMaterial = HitResult->PhysMaterial.Get();
+			}
+			else
+			{
+				BatchTarget.ImpactLocation = TargetActor->GetActorLocation();
+			}
+		}
+	}
+
+	if (BatchTargets.IsEmpty())
+	{
+		return EffectHandles;
+	}
+
+	// One spec is built and captured for every target, each application then gets its own effect context
+	const FGameplayEffectSpecHandle SpecHandle = MakeOutgoingGameplayEffectSpec(GameplayEffectClass, GameplayEffectLevel);
+	FGameplayEffectSpec* Spec = SpecHandle.Data.Get();
+	if (Spec == nullptr)
+	{
+		return EffectHandles;
+	}
+
+	UUltraScoreExecution::ResolveBatchedScores(*Spec, BatchTargets);
+
+	const FGameplayEffectContextHandle BaseContextHandle = Spec->GetContext();
+	const FGameplayTagContainer BaseTargetSpecTags = Spec->CapturedTargetTags.GetSpecTags();
+
+	EffectHandles.Reserve(BatchTargets.Num());
+	for (const FUltraScoreBatchTarget& BatchTarget : BatchTargets)
+	{
+		FGameplayEffectContextHandle TargetContextHandle = BaseContextHandle.Duplicate();
+		if (BatchTarget.HitResult)
+		{
+			TargetContextHandle.AddHitResult(*BatchTarget.HitResult, /*bReset=*/ true);
+		}
+
+		FUltraGameplayEffectContext* TargetContext = FUltraGameplayEffectContext::ExtractEffectContext(TargetContextHandle);
+		check(TargetContext);
+		TargetContext->bScoreResolvedByBatch = true;
+
+		// Same as ApplyAbilityTagsToGameplayEffectSpec would do for a spec made with this hit result
+		FGameplayTagContainer& TargetSpecTags = Spec->CapturedTargetTags.GetSpecTags();
+		TargetSpecTags = BaseTargetSpecTags;
+		if (const UPhysicalMaterialWithTags* PhysMatWithTags = Cast<const UPhysicalMaterialWithTags>(BatchTarget.PhysicalMaterial))
+		{
+			TargetSpecTags.AppendTags(PhysMatWithTags->Tags);
+		}
+
+		Spec->SetContext(TargetContextHandle, /*bSkipRecaptureSourceActorTags=*/ true);
+		Spec->SetSetByCallerMagnitude(UltraGameplayTags::SetByCaller_ResolvedScore, BatchTarget.ResolvedScore);
+		EffectHandles.Add(SourceASC->ApplyGameplayEffectSpecToTarget(*Spec, BatchTarget.TargetASC, SourceASC->GetPredictionKeyForNewAction()));
+	}
+
+	return EffectHandles;
+}
+
 FGameplayEffectContextHandle UUltraGameplayAbility::MakeEffectContext(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo) const
 {
 	FGameplayEffectContextHandle ContextHandle = Super::MakeEffectContext(Handle, ActorInfo);
@@ -511,6 +606,7 @@ bool UUltraGameplayAbility::ChangeActivationGroup(EUltraAbilityActivationGroup N
 
 		UltraASC->RemoveAbilityFromActivationGroup(ActivationGroup, this);
 		UltraASC->AddAbilityToActivationGroup(NewGroup, this);
+		UltraASC->MoveActiveAbilityToGroup(GetCurrentAbilitySpecHandle(), this, ActivationGroup, NewGroup);
 
 		ActivationGroup = NewGroup;
 	}
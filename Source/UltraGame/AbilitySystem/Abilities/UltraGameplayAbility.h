@@ -43,7 +43,9 @@ enum class EUltraAbilityActivationPolicy : uint8
 	WhileInputActive,
 
 	// Try to activate the ability when an avatar is assigned.
-	OnSpawn
+	OnSpawn,
+
+	MAX	UMETA(Hidden)
 };
 
 
@@ -137,6 +139,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ultra|Ability")
 	void ClearCameraMode();
 
+	// Applies a score gameplay effect to every actor in the target data using one shared spec, with an effect context per target.
+	// The per-target rules are resolved in a single pass (see UUltraScoreExecution::ResolveBatchedScores).
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ultra|Ability")
+	TArray<FActiveGameplayEffectHandle> ApplyScoreEffectToTargetsBatched(TSubclassOf<UGameplayEffect> GameplayEffectClass, const FGameplayAbilityTargetDataHandle& TargetData, float GameplayEffectLevel = 1.0f);
+
 	void OnAbilityFailedToActivate(const FGameplayTagContainer& FailedReason) const
 	{
 		NativeOnAbilityFailedToActivate(FailedReason);
@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UltraAttributeInitCache.h"
+
+#include "AttributeSet.h"
+#include "Engine/DataTable.h"
+#include "HAL/IConsoleManager.h"
+#include "UltraLogChannels.h"
+#include "UObject/Package.h"
+
+void FUltraBakedAttributeInit::Apply(UAttributeSet* AttributeSet) const
+{
+	check(AttributeSet && AttributeSet->IsA(AttributeSetClass));
+
+	uint8* SetData = reinterpret_cast<uint8*>(AttributeSet);
+	for (const FBakedValue& Baked : Values)
+	{
+		void* ValuePtr = SetData + Baked.Offset;
+		if (Baked.NumericProperty)
+		{
+			Baked.NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Baked.Value);
+		}
+		else
+		{
+			FGameplayAttributeData* AttributeData = static_cast<FGameplayAttributeData*>(ValuePtr);
+			AttributeData->SetBaseValue(Baked.Value);
+			AttributeData->SetCurrentValue(Baked.Value);
+		}
+	}
+
+	AttributeSet->PrintDebug();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+FUltraAttributeInitCache& FUltraAttributeInitCache::Get()
+{
+	static FUltraAttributeInitCache Cache;
+	return Cache;
+}
+
+const FUltraBakedAttributeInit& FUltraAttributeInitCache::FindOrBake(TSubclassOf<UAttributeSet> SetClass, const UDataTable* DataTable)
+{
+	check(IsInGameThread());
+	check(SetClass && DataTable);
+
+	const TPair<TObjectKey<UClass>, TObjectKey<UDataTable>> Key(SetClass.Get(), DataTable);
+	if (const FUltraBakedAttributeInit* Existing = BakedInits.Find(Key))
+	{
+		return *Existing;
+	}
+
+	FUltraBakedAttributeInit& Baked = BakedInits.Add(Key);
+	Bake(SetClass, DataTable, Baked);
+
+#if WITH_EDITOR
+	// Tables can be edited or reimported while the editor is running, drop everything baked from them when that happens
+	if (!WatchedTables.Contains(DataTable))
+	{
+		WatchedTables.Add(DataTable);
+		const_cast<UDataTable*>(DataTable)->OnDataTableChanged().AddRaw(this, &FUltraAttributeInitCache::OnDataTableChanged, TObjectKey<UDataTable>(DataTable));
+	}
+#endif
+
+	return Baked;
+}
+
+void FUltraAttributeInitCache::InitAttributeSet(UAttributeSet* AttributeSet, const UDataTable* DataTable)
+{
+	check(AttributeSet);
+	if (DataTable)
+	{
+		FindOrBake(AttributeSet->GetClass(), DataTable).Apply(AttributeSet);
+	}
+}
+
+void FUltraAttributeInitCache::Reset()
+{
+	BakedInits.Reset();
+}
+
+void FUltraAttributeInitCache::Bake(UClass* SetClass, const UDataTable* DataTable, FUltraBakedAttributeInit& OutBaked) const
+{
+	OutBaked.AttributeSetClass = SetClass;
+	OutBaked.Values.Reset();
+
+	const UScriptStruct* RowStruct = DataTable->GetRowStruct();
+	if ((RowStruct == nullptr) || !RowStruct->IsChildOf(FAttributeMetaData::StaticStruct()))
+	{
+		UE_LOG(LogUltraAbilitySystem, Error, TEXT("Attribute init table [%s] does not use FAttributeMetaData rows, [%s] will not be initialized from it."), *GetNameSafe(DataTable), *GetNameSafe(SetClass));
+		return;
+	}
+
+	// Same property walk and row naming as UAttributeSet::InitFromMetaDataTable, done once
+	static const FString Context(TEXT("FUltraAttributeInitCache::Bake"));
+	for (TFieldIterator<FProperty> It(SetClass, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		FProperty* Property = *It;
+
+		const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+		if ((NumericProperty == nullptr) && !FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			continue;
+		}
+
+		const FString RowNameStr = FString::Printf(TEXT("%s.%s"), *Property->GetOwnerVariant().GetName(), *Property->GetName());
+		if (const FAttributeMetaData* MetaData = DataTable->FindRow<FAttributeMetaData>(FName(*RowNameStr), Context, /*bWarnIfRowMissing=*/ false))
+		{
+			FUltraBakedAttributeInit::FBakedValue& Baked = OutBaked.Values.AddDefaulted_GetRef();
+			Baked.Offset = Property->GetOffset_ForInternal();
+			Baked.Value = MetaData->BaseValue;
+			Baked.NumericProperty = NumericProperty;
+		}
+	}
+
+	OutBaked.Values.Shrink();
+}
+
+#if WITH_EDITOR
+void FUltraAttributeInitCache::OnDataTableChanged(TObjectKey<UDataTable> DataTableKey)
+{
+	for (auto It = BakedInits.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Value == DataTableKey)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs GUltraAttributeInitBenchmarkCmd(
+	TEXT("Ultra.AbilitySystem.AttributeInitBenchmark"),
+	TEXT("Creates attribute sets the way a pawn spawn does and initializes them from an init table, first with InitFromMetaDataTable and then with the baked table, and logs the cost per set. Usage: Ultra.AbilitySystem.AttributeInitBenchmark <AttributeSetClassPath> <DataTablePath> [Iterations=1000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World)
+{
+	if (Params.Num() < 2)
+	{
+		UE_LOG(LogUltraAbilitySystem, Error, TEXT("Ultra.AbilitySystem.AttributeInitBenchmark: expected <AttributeSetClassPath> <DataTablePath> [Iterations]"));
+		return;
+	}
+
+	UClass* SetClass = LoadClass<UAttributeSet>(nullptr, *Params[0]);
+	const UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *Params[1]);
+	const int32 Iterations = (Params.Num() > 2) ? FMath::Max(FCString::Atoi(*Params[2]), 1) : 1000;
+
+	if ((SetClass == nullptr) || (DataTable == nullptr))
+	{
+		UE_LOG(LogUltraAbilitySystem, Error, TEXT("Ultra.AbilitySystem.AttributeInitBenchmark: could not load attribute set class [%s] or table [%s]"), *Params[0], *Params[1]);
+		return;
+	}
+
+	UObject* Outer = GetTransientPackage();
+	TArray<UAttributeSet*> Sets;
+	Sets.Reserve(Iterations * 2);
+
+	const double TableStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		UAttributeSet* NewSet = NewObject<UAttributeSet>(Outer, SetClass);
+		NewSet->InitFromMetaDataTable(DataTable);
+		Sets.Add(NewSet);
+	}
+	const double TableSeconds = FPlatformTime::Seconds() - TableStartTime;
+
+	FUltraAttributeInitCache& Cache = FUltraAttributeInitCache::Get();
+	const double BakeStartTime = FPlatformTime::Seconds();
+	const FUltraBakedAttributeInit& Baked = Cache.FindOrBake(SetClass, DataTable);
+	const double BakeSeconds = FPlatformTime::Seconds() - BakeStartTime;
+
+	const double BakedStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		UAttributeSet* NewSet = NewObject<UAttributeSet>(Outer, SetClass);
+		Baked.Apply(NewSet);
+		Sets.Add(NewSet);
+	}
+	const double BakedSeconds = FPlatformTime::Seconds() - BakedStartTime;
+
+	for (UAttributeSet* Set : Sets)
+	{
+		Set->MarkAsGarbage();
+	}
+
+	UE_LOG(LogUltraAbilitySystem, Display, TEXT("Attribute init benchmark: %d x %s from %s (%d baked values)"), Iterations, *SetClass->GetName(), *DataTable->GetName(), Baked.Num());
+	UE_LOG(LogUltraAbilitySystem, Display, TEXT("  InitFromMetaDataTable: %.2f ms total, %.2f us per set"), TableSeconds * 1000.0, (TableSeconds / Iterations) * 1000000.0);
+	UE_LOG(LogUltraAbilitySystem, Display, TEXT("  Baked: %.2f ms total, %.2f us per set (%.1fx), %.2f us to bake (first use only)"),
+		BakedSeconds * 1000.0, (BakedSeconds / Iterations) * 1000000.0, (BakedSeconds > 0.0) ? (TableSeconds / BakedSeconds) : 0.0, BakeSeconds * 1000000.0);
+}));
+
+#endif // !UE_BUILD_SHIPPING
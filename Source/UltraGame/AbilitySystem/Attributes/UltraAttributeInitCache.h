@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
+
+class FNumericProperty;
+class UAttributeSet;
+class UDataTable;
+
+/**
+ * FUltraBakedAttributeInit
+ *
+ *	The values of an attribute init table (FAttributeMetaData rows named "<Class>.<Property>") resolved against one attribute set class.
+ *	Applying it is a walk over property offsets, producing the same result as UAttributeSet::InitFromMetaDataTable without any row lookups.
+ */
+struct ULTRAGAME_API FUltraBakedAttributeInit
+{
+public:
+	void Apply(UAttributeSet* AttributeSet) const;
+
+	int32 Num() const { return Values.Num(); }
+
+private:
+	friend class FUltraAttributeInitCache;
+
+	struct FBakedValue
+	{
+		int32 Offset = 0;
+		float Value = 0.0f;
+
+		// Set for plain numeric properties, null for FGameplayAttributeData properties
+		const FNumericProperty* NumericProperty = nullptr;
+	};
+
+	const UClass* AttributeSetClass = nullptr;
+	TArray<FBakedValue> Values;
+};
+
+/**
+ * FUltraAttributeInitCache
+ *
+ *	Process wide cache of baked attribute init tables, keyed by attribute set class and table.
+ *	Tables are baked the first time they are used (or up front via FindOrBake) and reused for every attribute set created afterwards.
+ */
+class ULTRAGAME_API FUltraAttributeInitCache
+{
+public:
+	static FUltraAttributeInitCache& Get();
+
+	// Returns the baked values of DataTable for SetClass, baking them if this is the first request for the pair
+	const FUltraBakedAttributeInit& FindOrBake(TSubclassOf<UAttributeSet> SetClass, const UDataTable* DataTable);
+
+	// Initializes a newly created attribute set from DataTable, replacement for UAttributeSet::InitFromMetaDataTable
+	void InitAttributeSet(UAttributeSet* AttributeSet, const UDataTable* DataTable);
+
+	void Reset();
+
+private:
+	void Bake(UClass* SetClass, const UDataTable* DataTable, FUltraBakedAttributeInit& OutBaked) const;
+
+#if WITH_EDITOR
+	void OnDataTableChanged(TObjectKey<UDataTable> DataTableKey);
+	TSet<TObjectKey<UDataTable>> WatchedTables;
+#endif
+
+	TMap<TPair<TObjectKey<UClass>, TObjectKey<UDataTable>>, FUltraBakedAttributeInit> BakedInits;
+};
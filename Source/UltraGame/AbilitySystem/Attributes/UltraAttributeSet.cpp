@@ -24,4 +24,17 @@ UWorld* UUltraAttributeSet::GetWorld() const
 UUltraAbilitySystemComponent* UUltraAttributeSet::GetUltraAbilitySystemComponent() const
 {
 	return Cast<UUltraAbilitySystemComponent>(GetOwningAbilitySystemComponent());
-}
\ No newline at end of file
+}
+
+void UUltraAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	if (OldValue != NewValue)
+	{
+		if (UUltraAbilitySystemComponent* UltraASC = GetUltraAbilitySystemComponent())
+		{
+			UltraASC->NotifyReplicatedAttributeChanged();
+		}
+	}
+}
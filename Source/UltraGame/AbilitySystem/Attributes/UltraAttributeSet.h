@@ -52,4 +52,8 @@ public:
 	UWorld* GetWorld() const override;
 
 	UUltraAbilitySystemComponent* GetUltraAbilitySystemComponent() const;
+
+	//~UAttributeSet interface
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+	//~End of UAttributeSet interface
 };
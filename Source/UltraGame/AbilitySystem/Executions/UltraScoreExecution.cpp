@@ -5,8 +5,11 @@
 #include "AbilitySystem/Attributes/UltraScoreSet.h"
 #include "AbilitySystem/UltraGameplayEffectContext.h"
 #include "AbilitySystem/UltraAbilitySourceInterface.h"
+#include "AbilitySystemComponent.h"
 #include "Engine/World.h"
+#include "Physics/PhysicalMaterialWithTags.h"
 #include "Teams/UltraTeamSubsystem.h"
+#include "UltraGameplayTags.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraScoreExecution)
 
@@ -26,6 +29,56 @@ static FScoreStatics& ScoreStatics()
 	return Statics;
 }
 
+// Applies the distance, physical material, and team rules for a single target on top of the base score
+static float CalculateScoreForTarget(float BaseScore, const FUltraGameplayEffectContext& Context, const AActor* HitActor, const FVector& ImpactLocation,
+	const UPhysicalMaterial* PhysMat, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, const UUltraTeamSubsystem* TeamSubsystem, const UGameplayEffect* EffectDef)
+{
+	const AActor* EffectCauser = Context.GetEffectCauser();
+
+	// Apply rules for team score/self score/etc...
+	float ScoreInteractionAllowedMultiplier = 0.0f;
+	if (HitActor)
+	{
+		if (ensure(TeamSubsystem))
+		{
+			ScoreInteractionAllowedMultiplier = TeamSubsystem->CanCauseScore(EffectCauser, HitActor) ? 1.0 : 0.0;
+		}
+	}
+
+	// Determine distance
+	double Distance = WORLD_MAX;
+
+	if (Context.HasOrigin())
+	{
+		Distance = FVector::Dist(Context.GetOrigin(), ImpactLocation);
+	}
+	else if (EffectCauser)
+	{
+		Distance = FVector::Dist(EffectCauser->GetActorLocation(), ImpactLocation);
+	}
+	else
+	{
+		ensureMsgf(false, TEXT("Score Calculation cannot deduce a source location for score coming from %s; Falling back to WORLD_MAX dist!"), *GetPathNameSafe(EffectDef));
+	}
+
+	// Apply ability source modifiers
+	float PhysicalMaterialAttenuation = 1.0f;
+	float DistanceAttenuation = 1.0f;
+	if (const IUltraAbilitySourceInterface* AbilitySource = Context.GetAbilitySource())
+	{
+		if (PhysMat)
+		{
+			PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, TargetTags);
+		}
+
+		DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
+	}
+	DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
+
+	// Clamping is done when score is converted to -health
+	return FMath::Max(BaseScore * DistanceAttenuation * PhysicalMaterialAttenuation * ScoreInteractionAllowedMultiplier, 0.0f);
+}
+
 
 UUltraScoreExecution::UUltraScoreExecution()
 {
@@ -36,9 +89,25 @@ void UUltraScoreExecution::Execute_Implementation(const FGameplayEffectCustomExe
 {
 #if WITH_SERVER_CODE
 	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
+
 	FUltraGameplayEffectContext* TypedContext = FUltraGameplayEffectContext::ExtractEffectContext(Spec.GetContext());
 	check(TypedContext);
 
+	// Batched applications have already resolved the score for this target (see ResolveBatchedScores).
+	// The resolved value is only trusted when it came from the batch path, anything else is recalculated below.
+	if (TypedContext->bScoreResolvedByBatch)
+	{
+		const float ResolvedScore = Spec.GetSetByCallerMagnitude(UltraGameplayTags::SetByCaller_ResolvedScore, /*WarnIfNotFound=*/ false, /*DefaultIfNotFound=*/ -1.0f);
+		if (ResolvedScore >= 0.0f)
+		{
+			if (ResolvedScore > 0.0f)
+			{
+				OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UUltraStyleSet::GetScoreAttribute(), EGameplayModOp::Additive, ResolvedScore));
+			}
+			return;
+		}
+	}
+
 	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
 	const FGameplayTagContainer* TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
 
@@ -49,7 +118,6 @@ void UUltraScoreExecution::Execute_Implementation(const FGameplayEffectCustomExe
 	float BaseScore = 0.0f;
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(ScoreStatics().BaseScoreDef, EvaluateParameters, BaseScore);
 
-	const AActor* EffectCauser = TypedContext->GetEffectCauser();
 	const FHitResult* HitActorResult = TypedContext->GetHitResult();
 
 	AActor* HitActor = nullptr;
@@ -85,54 +153,55 @@ void UUltraScoreExecution::Execute_Implementation(const FGameplayEffectCustomExe
 		}
 	}
 
-	// Apply rules for team score/self score/etc...
-	float ScoreInteractionAllowedMultiplier = 0.0f;
-	if (HitActor)
+	const UUltraTeamSubsystem* TeamSubsystem = HitActor ? HitActor->GetWorld()->GetSubsystem<UUltraTeamSubsystem>() : nullptr;
+	const float ScoreDone = CalculateScoreForTarget(BaseScore, *TypedContext, HitActor, ImpactLocation, TypedContext->GetPhysicalMaterial(), SourceTags, TargetTags, TeamSubsystem, Spec.Def);
+
+	if (ScoreDone > 0.0f)
 	{
-		UUltraTeamSubsystem* TeamSubsystem = HitActor->GetWorld()->GetSubsystem<UUltraTeamSubsystem>();
-		if (ensure(TeamSubsystem))
-		{
-			ScoreInteractionAllowedMultiplier = TeamSubsystem->CanCauseScore(EffectCauser, HitActor) ? 1.0 : 0.0;
-		}
+		// Apply a score modifier, this gets turned into - health on the target
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UUltraStyleSet::GetScoreAttribute(), EGameplayModOp::Additive, ScoreDone));
 	}
+#endif // #if WITH_SERVER_CODE
+}
 
-	// Determine distance
-	double Distance = WORLD_MAX;
+void UUltraScoreExecution::ResolveBatchedScores(const FGameplayEffectSpec& Spec, TArrayView<FUltraScoreBatchTarget> Targets)
+{
+#if WITH_SERVER_CODE
+	FUltraGameplayEffectContext* TypedContext = FUltraGameplayEffectContext::ExtractEffectContext(Spec.GetContext());
+	check(TypedContext);
 
-	if (TypedContext->HasOrigin())
-	{
-		Distance = FVector::Dist(TypedContext->GetOrigin(), ImpactLocation);
-	}
-	else if (EffectCauser)
-	{
-		Distance = FVector::Dist(EffectCauser->GetActorLocation(), ImpactLocation);
-	}
-	else
-	{
-		ensureMsgf(false, TEXT("Score Calculation cannot deduce a source location for score coming from %s; Falling back to WORLD_MAX dist!"), *GetPathNameSafe(Spec.Def));
-	}
+	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	const FGameplayEffectAttributeCaptureSpec* BaseScoreCapture = Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(ScoreStatics().BaseScoreDef, true);
 
-	// Apply ability source modifiers
-	float PhysicalMaterialAttenuation = 1.0f;
-	float DistanceAttenuation = 1.0f;
-	if (const IUltraAbilitySourceInterface* AbilitySource = TypedContext->GetAbilitySource())
+	const AActor* EffectCauser = TypedContext->GetEffectCauser();
+	const UWorld* World = EffectCauser ? EffectCauser->GetWorld() : nullptr;
+	const UUltraTeamSubsystem* TeamSubsystem = World ? World->GetSubsystem<UUltraTeamSubsystem>() : nullptr;
+
+	FGameplayTagContainer TargetTags;
+	for (FUltraScoreBatchTarget& Target : Targets)
 	{
-		if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
+		// Mirror what the spec would have captured for this target (owned tags plus the tags of the surface that was hit)
+		TargetTags.Reset();
+		if (Target.TargetASC)
 		{
-			PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, TargetTags);
+			Target.TargetASC->GetOwnedGameplayTags(TargetTags);
+		}
+		if (const UPhysicalMaterialWithTags* PhysMatWithTags = Cast<const UPhysicalMaterialWithTags>(Target.PhysicalMaterial))
+		{
+			TargetTags.AppendTags(PhysMatWithTags->Tags);
 		}
 
-		DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
-	}
-	DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
-
-	// Clamping is done when score is converted to -health
-	const float ScoreDone = FMath::Max(BaseScore * DistanceAttenuation * PhysicalMaterialAttenuation * ScoreInteractionAllowedMultiplier, 0.0f);
+		// Base score modifiers can have target tag requirements, so evaluate it against this target's tags
+		float BaseScore = 0.0f;
+		if (BaseScoreCapture)
+		{
+			FAggregatorEvaluateParameters EvaluateParameters;
+			EvaluateParameters.SourceTags = SourceTags;
+			EvaluateParameters.TargetTags = &TargetTags;
+			BaseScoreCapture->AttemptCalculateAttributeMagnitude(EvaluateParameters, BaseScore);
+		}
 
-	if (ScoreDone > 0.0f)
-	{
-		// Apply a score modifier, this gets turned into - health on the target
-		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UUltraStyleSet::GetScoreAttribute(), EGameplayModOp::Additive, ScoreDone));
+		Target.ResolvedScore = CalculateScoreForTarget(BaseScore, *TypedContext, Target.HitActor, Target.ImpactLocation, Target.PhysicalMaterial, SourceTags, &TargetTags, TeamSubsystem, Spec.Def);
 	}
 #endif // #if WITH_SERVER_CODE
-}
\ No newline at end of file
+}
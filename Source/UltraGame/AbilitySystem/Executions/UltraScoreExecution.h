@@ -6,7 +6,38 @@
 
 #include "UltraScoreExecution.generated.h"
 
+class AActor;
+class UAbilitySystemComponent;
 class UObject;
+class UPhysicalMaterial;
+struct FGameplayEffectSpec;
+struct FHitResult;
+
+/**
+ * FUltraScoreBatchTarget
+ *
+ *	Per-target inputs (and the resolved output) of a batched score application.
+ */
+struct FUltraScoreBatchTarget
+{
+	// The ability system the score will be applied to
+	UAbilitySystemComponent* TargetASC = nullptr;
+
+	// The actor that was hit (usually the avatar of TargetASC)
+	AActor* HitActor = nullptr;
+
+	// Where the target was hit, used for distance attenuation
+	FVector ImpactLocation = FVector::ZeroVector;
+
+	// The hit result for this target, if the target data had one
+	const FHitResult* HitResult = nullptr;
+
+	// The surface that was hit, if any
+	const UPhysicalMaterial* PhysicalMaterial = nullptr;
+
+	// The final score for this target, filled in by UUltraScoreExecution::ResolveBatchedScores
+	float ResolvedScore = 0.0f;
+};
 
 
 /**
@@ -23,6 +54,14 @@ public:
 
 	UUltraScoreExecution();
 
+	/**
+	 * Resolves the score for many targets of a single outgoing spec.
+	 * Captured source attributes and distance, physical material, and team rules are evaluated per target in one pass.
+	 * The results are applied through SetByCaller.ResolvedScore, which this execution only passes straight through
+	 * when the effect context is flagged with bScoreResolvedByBatch; any other spec is fully recalculated.
+	 */
+	static void ResolveBatchedScores(const FGameplayEffectSpec& Spec, TArrayView<FUltraScoreBatchTarget> Targets);
+
 protected:
 
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
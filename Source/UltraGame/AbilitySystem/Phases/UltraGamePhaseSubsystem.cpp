@@ -4,7 +4,10 @@
 
 #include "AbilitySystem/UltraAbilitySystemComponent.h"
 #include "Engine/World.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/GameStateBase.h"
+#include "Messages/UltraVerbMessage.h"
+#include "NativeGameplayTags.h"
 #include "UltraGamePhaseAbility.h"
 #include "UltraGamePhaseLog.h"
 
@@ -15,6 +18,8 @@ class UObject;
 
 DEFINE_LOG_CATEGORY(LogUltraGamePhase);
 
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Ultra_GamePhase_Started_Message, "Ultra.GamePhase.Started.Message");
+
 //////////////////////////////////////////////////////////////////////
 // UUltraGamePhaseSubsystem
 
@@ -98,11 +103,7 @@ void UUltraGamePhaseSubsystem::K2_WhenPhaseEnds(FGameplayTag PhaseTag, EPhaseTag
 
 void UUltraGamePhaseSubsystem::WhenPhaseStartsOrIsActive(FGameplayTag PhaseTag, EPhaseTagMatchType MatchType, const FUltraGamePhaseTagDelegate& WhenPhaseActive)
 {
-	FPhaseObserver Observer;
-	Observer.PhaseTag = PhaseTag;
-	Observer.MatchType = MatchType;
-	Observer.PhaseCallback = WhenPhaseActive;
-	PhaseStartObservers.Add(Observer);
+	PhaseStartObservers.Add(PhaseTag, MatchType, WhenPhaseActive);
 
 	if (IsPhaseActive(PhaseTag))
 	{
@@ -112,25 +113,32 @@ void UUltraGamePhaseSubsystem::WhenPhaseStartsOrIsActive(FGameplayTag PhaseTag,
 
 void UUltraGamePhaseSubsystem::WhenPhaseEnds(FGameplayTag PhaseTag, EPhaseTagMatchType MatchType, const FUltraGamePhaseTagDelegate& WhenPhaseEnd)
 {
-	FPhaseObserver Observer;
-	Observer.PhaseTag = PhaseTag;
-	Observer.MatchType = MatchType;
-	Observer.PhaseCallback = WhenPhaseEnd;
-	PhaseEndObservers.Add(Observer);
+	PhaseEndObservers.Add(PhaseTag, MatchType, WhenPhaseEnd);
 }
 
 bool UUltraGamePhaseSubsystem::IsPhaseActive(const FGameplayTag& PhaseTag) const
 {
-	for (const auto& KVP : ActivePhaseMap)
+	// Active if PhaseTag or any of its children is active
+	return ActivePhaseTags.HasTag(PhaseTag);
+}
+
+void UUltraGamePhaseSubsystem::AddActivePhaseTag(const FGameplayTag& PhaseTag)
+{
+	int32& Count = ActivePhaseTagCounts.FindOrAdd(PhaseTag);
+	if (Count++ == 0)
 	{
-		const FUltraGamePhaseEntry& PhaseEntry = KVP.Value;
-		if (PhaseEntry.PhaseTag.MatchesTag(PhaseTag))
-		{
-			return true;
-		}
+		ActivePhaseTags.AddTagFast(PhaseTag);
 	}
+}
 
-	return false;
+void UUltraGamePhaseSubsystem::RemoveActivePhaseTag(const FGameplayTag& PhaseTag)
+{
+	int32* Count = ActivePhaseTagCounts.Find(PhaseTag);
+	if (ensure(Count) && (--(*Count) == 0))
+	{
+		ActivePhaseTagCounts.Remove(PhaseTag);
+		ActivePhaseTags.RemoveTag(PhaseTag);
+	}
 }
 
 void UUltraGamePhaseSubsystem::OnBeginPhase(const UUltraGamePhaseAbility* PhaseAbility, const FGameplayAbilitySpecHandle PhaseAbilityHandle)
@@ -143,50 +151,31 @@ void UUltraGamePhaseSubsystem::OnBeginPhase(const UUltraGamePhaseAbility* PhaseA
 	UUltraAbilitySystemComponent* GameState_ASC = World->GetGameState()->FindComponentByClass<UUltraAbilitySystemComponent>();
 	if (ensure(GameState_ASC))
 	{
-		TArray<FGameplayAbilitySpec*> ActivePhases;
-		for (const auto& KVP : ActivePhaseMap)
-		{
-			const FGameplayAbilitySpecHandle ActiveAbilityHandle = KVP.Key;
-			if (FGameplayAbilitySpec* Spec = GameState_ASC->FindAbilitySpecFromHandle(ActiveAbilityHandle))
-			{
-				ActivePhases.Add(Spec);
-			}
-		}
+		TArray<FGameplayAbilitySpecHandle> PhasesToEnd;
+		GetPhasesEndedBy(IncomingPhaseTag, PhasesToEnd);
 
-		for (const FGameplayAbilitySpec* ActivePhase : ActivePhases)
+		for (const FGameplayAbilitySpecHandle& HandleToEnd : PhasesToEnd)
 		{
-			const UUltraGamePhaseAbility* ActivePhaseAbility = CastChecked<UUltraGamePhaseAbility>(ActivePhase->Ability);
-			const FGameplayTag ActivePhaseTag = ActivePhaseAbility->GetGamePhaseTag();
-			
-			// So if the active phase currently matches the incoming phase tag, we allow it.
-			// i.e. multiple gameplay abilities can all be associated with the same phase tag.
-			// For example,
-			// You can be in the, Game.Playing, phase, and then start a sub-phase, like Game.Playing.SuddenDeath
-			// Game.Playing phase will still be active, and if someone were to push another one, like,
-			// Game.Playing.ActualSuddenDeath, it would end Game.Playing.SuddenDeath phase, but Game.Playing would
-			// continue.  Similarly if we activated Game.GameOver, all the Game.Playing* phases would end.
-			if (!IncomingPhaseTag.MatchesTag(ActivePhaseTag))
+			if (const FGameplayAbilitySpec* ActivePhase = GameState_ASC->FindAbilitySpecFromHandle(HandleToEnd))
 			{
-				UE_LOG(LogUltraGamePhase, Log, TEXT("\tEnding Phase '%s' (%s)"), *ActivePhaseTag.ToString(), *GetNameSafe(ActivePhaseAbility));
+				UE_LOG(LogUltraGamePhase, Log, TEXT("\tEnding Phase '%s' (%s)"), *ActivePhaseMap.FindChecked(HandleToEnd).PhaseTag.ToString(), *GetNameSafe(ActivePhase->Ability));
 
-				FGameplayAbilitySpecHandle HandleToEnd = ActivePhase->Handle;
 				GameState_ASC->CancelAbilitiesByFunc([HandleToEnd](const UUltraGameplayAbility* UltraAbility, FGameplayAbilitySpecHandle Handle) {
 					return Handle == HandleToEnd;
 				}, true);
 			}
 		}
 
-		FUltraGamePhaseEntry& Entry = ActivePhaseMap.FindOrAdd(PhaseAbilityHandle);
-		Entry.PhaseTag = IncomingPhaseTag;
+		RecordPhaseStarted(PhaseAbilityHandle, IncomingPhaseTag);
 
-		// Notify all observers of this phase that it has started.
-		for (const FPhaseObserver& Observer : PhaseStartObservers)
-		{
-			if (Observer.IsMatch(IncomingPhaseTag))
-			{
-				Observer.PhaseCallback.ExecuteIfBound(IncomingPhaseTag);
-			}
-		}
+		// Send a standardized verb message that other systems (e.g., the replay event index) can observe
+		FUltraVerbMessage Message;
+		Message.Verb = TAG_Ultra_GamePhase_Started_Message;
+		Message.Instigator = GameState_ASC->GetOwner();
+		Message.ContextTags.AddTag(IncomingPhaseTag);
+
+		UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(this);
+		MessageSystem.BroadcastMessage(Message.Verb, Message);
 	}
 }
 
@@ -198,27 +187,99 @@ void UUltraGamePhaseSubsystem::OnEndPhase(const UUltraGamePhaseAbility* PhaseAbi
 	const FUltraGamePhaseEntry& Entry = ActivePhaseMap.FindChecked(PhaseAbilityHandle);
 	Entry.PhaseEndedCallback.ExecuteIfBound(PhaseAbility);
 
-	ActivePhaseMap.Remove(PhaseAbilityHandle);
+	RecordPhaseEnded(PhaseAbilityHandle);
+}
 
-	// Notify all observers of this phase that it has ended.
-	for (const FPhaseObserver& Observer : PhaseEndObservers)
+void UUltraGamePhaseSubsystem::GetPhasesEndedBy(const FGameplayTag& IncomingPhaseTag, TArray<FGameplayAbilitySpecHandle>& OutPhaseHandles) const
+{
+	for (const auto& KVP : ActivePhaseMap)
 	{
-		if (Observer.IsMatch(EndedPhaseTag))
+		const FGameplayTag& ActivePhaseTag = KVP.Value.PhaseTag;
+
+		// So if the active phase currently matches the incoming phase tag, we allow it.
+		// i.e. multiple gameplay abilities can all be associated with the same phase tag.
+		// For example,
+		// You can be in the, Game.Playing, phase, and then start a sub-phase, like Game.Playing.SuddenDeath
+		// Game.Playing phase will still be active, and if someone were to push another one, like,
+		// Game.Playing.ActualSuddenDeath, it would end Game.Playing.SuddenDeath phase, but Game.Playing would
+		// continue.  Similarly if we activated Game.GameOver, all the Game.Playing* phases would end.
+		if (ActivePhaseTag.IsValid() && !IncomingPhaseTag.MatchesTag(ActivePhaseTag))
 		{
-			Observer.PhaseCallback.ExecuteIfBound(EndedPhaseTag);
+			OutPhaseHandles.Add(KVP.Key);
 		}
 	}
 }
 
-bool UUltraGamePhaseSubsystem::FPhaseObserver::IsMatch(const FGameplayTag& ComparePhaseTag) const
+void UUltraGamePhaseSubsystem::RecordPhaseStarted(const FGameplayAbilitySpecHandle PhaseAbilityHandle, const FGameplayTag& PhaseTag)
 {
-	switch(MatchType)
+	FUltraGamePhaseEntry& Entry = ActivePhaseMap.FindOrAdd(PhaseAbilityHandle);
+	if (Entry.PhaseTag.IsValid())
+	{
+		RemoveActivePhaseTag(Entry.PhaseTag);
+	}
+	Entry.PhaseTag = PhaseTag;
+	AddActivePhaseTag(PhaseTag);
+
+	// Notify all observers of this phase that it has started.
+	PhaseStartObservers.Broadcast(PhaseTag);
+}
+
+void UUltraGamePhaseSubsystem::RecordPhaseEnded(const FGameplayAbilitySpecHandle PhaseAbilityHandle)
+{
+	FUltraGamePhaseEntry Entry;
+	if (!ActivePhaseMap.RemoveAndCopyValue(PhaseAbilityHandle, Entry) || !Entry.PhaseTag.IsValid())
+	{
+		return;
+	}
+
+	RemoveActivePhaseTag(Entry.PhaseTag);
+
+	// Notify all observers of this phase that it has ended.
+	PhaseEndObservers.Broadcast(Entry.PhaseTag);
+}
+
+//////////////////////////////////////////////////////////////////////
+// UUltraGamePhaseSubsystem::FPhaseObserverMap
+
+void UUltraGamePhaseSubsystem::FPhaseObserverMap::Add(const FGameplayTag& PhaseTag, EPhaseTagMatchType MatchType, const FUltraGamePhaseTagDelegate& PhaseCallback)
+{
+	switch (MatchType)
 	{
 	case EPhaseTagMatchType::ExactMatch:
-		return ComparePhaseTag == PhaseTag;
+		ExactObservers.FindOrAdd(PhaseTag).Add(PhaseCallback);
+		break;
 	case EPhaseTagMatchType::PartialMatch:
-		return ComparePhaseTag.MatchesTag(PhaseTag);
+		PartialObservers.FindOrAdd(PhaseTag).Add(PhaseCallback);
+		break;
 	}
+}
 
-	return false;
+void UUltraGamePhaseSubsystem::FPhaseObserverMap::Broadcast(const FGameplayTag& PhaseTag) const
+{
+	// Gather first, observers are free to register more observers from their callback
+	TArray<FUltraGamePhaseTagDelegate, TInlineAllocator<8>> Callbacks;
+
+	if (const TArray<FUltraGamePhaseTagDelegate>* Exact = ExactObservers.Find(PhaseTag))
+	{
+		Callbacks.Append(*Exact);
+	}
+
+	// A partial observer of A.B matches A.B and everything below it, so look up the phase tag and each of its parents.
+	// The parent list comes precomputed from the tag node.
+	if (PartialObservers.Num() > 0)
+	{
+		const FGameplayTagContainer PhaseTagAndParents = PhaseTag.GetGameplayTagParents();
+		for (const FGameplayTag& Tag : PhaseTagAndParents)
+		{
+			if (const TArray<FUltraGamePhaseTagDelegate>* Partial = PartialObservers.Find(Tag))
+			{
+				Callbacks.Append(*Partial);
+			}
+		}
+	}
+
+	for (const FUltraGamePhaseTagDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(PhaseTag);
+	}
 }
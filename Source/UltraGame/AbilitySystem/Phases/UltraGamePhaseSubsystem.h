@@ -89,18 +89,33 @@ private:
 
 	TMap<FGameplayAbilitySpecHandle, FUltraGamePhaseEntry> ActivePhaseMap;
 
-	struct FPhaseObserver
+	// Tags of the active phases, with the number of active phase abilities using each one
+	FGameplayTagContainer ActivePhaseTags;
+	TMap<FGameplayTag, int32> ActivePhaseTagCounts;
+
+	void AddActivePhaseTag(const FGameplayTag& PhaseTag);
+	void RemoveActivePhaseTag(const FGameplayTag& PhaseTag);
+
+	// Phase bookkeeping behind OnBeginPhase/OnEndPhase, kept apart from the ability system so it can be tested on its own
+	void GetPhasesEndedBy(const FGameplayTag& IncomingPhaseTag, TArray<FGameplayAbilitySpecHandle>& OutPhaseHandles) const;
+	void RecordPhaseStarted(const FGameplayAbilitySpecHandle PhaseAbilityHandle, const FGameplayTag& PhaseTag);
+	void RecordPhaseEnded(const FGameplayAbilitySpecHandle PhaseAbilityHandle);
+
+	// Observers bucketed by the tag they registered for, so a phase change only visits the buckets of the phase tag and its parents
+	struct FPhaseObserverMap
 	{
 	public:
-		bool IsMatch(const FGameplayTag& ComparePhaseTag) const;
-	
-		FGameplayTag PhaseTag;
-		EPhaseTagMatchType MatchType = EPhaseTagMatchType::ExactMatch;
-		FUltraGamePhaseTagDelegate PhaseCallback;
+		void Add(const FGameplayTag& PhaseTag, EPhaseTagMatchType MatchType, const FUltraGamePhaseTagDelegate& PhaseCallback);
+		void Broadcast(const FGameplayTag& PhaseTag) const;
+
+	private:
+		TMap<FGameplayTag, TArray<FUltraGamePhaseTagDelegate>> ExactObservers;
+		TMap<FGameplayTag, TArray<FUltraGamePhaseTagDelegate>> PartialObservers;
 	};
 
-	TArray<FPhaseObserver> PhaseStartObservers;
-	TArray<FPhaseObserver> PhaseEndObservers;
+	FPhaseObserverMap PhaseStartObservers;
+	FPhaseObserverMap PhaseEndObservers;
 
 	friend class UUltraGamePhaseAbility;
+	friend class FUltraGamePhaseSubsystemTest;
 };
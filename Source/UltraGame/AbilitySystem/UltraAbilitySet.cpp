@@ -3,6 +3,7 @@
 #include "UltraAbilitySet.h"
 
 #include "AbilitySystem/Abilities/UltraGameplayAbility.h"
+#include "AbilitySystem/Attributes/UltraAttributeInitCache.h"
 #include "UltraAbilitySystemComponent.h"
 #include "UltraLogChannels.h"
 
@@ -137,6 +138,10 @@ void UUltraAbilitySet::GiveToAbilitySystem(UUltraAbilitySystemComponent* UltraAS
 		}
 
 		UAttributeSet* NewSet = NewObject<UAttributeSet>(UltraASC->GetOwner(), SetToGrant.AttributeSet);
+		if (SetToGrant.InitializationData)
+		{
+			FUltraAttributeInitCache::Get().InitAttributeSet(NewSet, SetToGrant.InitializationData);
+		}
 		UltraASC->AddAttributeSetSubobject(NewSet);
 
 		if (OutGrantedHandles)
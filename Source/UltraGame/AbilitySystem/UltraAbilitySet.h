@@ -11,6 +11,7 @@
 #include "UltraAbilitySet.generated.h"
 
 class UAttributeSet;
+class UDataTable;
 class UGameplayEffect;
 class UUltraAbilitySystemComponent;
 class UUltraGameplayAbility;
@@ -79,6 +80,9 @@ public:
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UAttributeSet> AttributeSet;
 
+	// Optional FAttributeMetaData table to initialize the attribute set with (baked once, see FUltraAttributeInitCache).
+	UPROPERTY(EditDefaultsOnly)
+	TObjectPtr<const UDataTable> InitializationData;
 };
 
 /**
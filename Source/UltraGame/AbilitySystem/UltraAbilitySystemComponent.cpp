@@ -7,6 +7,10 @@
 #include "Animation/UltraAnimInstance.h"
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/UnrealNetwork.h"
+#include "UObject/UObjectIterator.h"
+#include "UltraGameplayTags.h"
 #include "UltraGlobalAbilitySystem.h"
 #include "UltraLogChannels.h"
 #include "System/UltraAssetManager.h"
@@ -24,6 +28,15 @@ UUltraAbilitySystemComponent::UUltraAbilitySystemComponent(const FObjectInitiali
 	InputHeldSpecHandles.Reset();
 
 	FMemory::Memset(ActivationGroupCounts, 0, sizeof(ActivationGroupCounts));
+
+	ReplicatedDynamicTags.SetOwner(this);
+}
+
+void UUltraAbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ThisClass, ReplicatedDynamicTags);
 }
 
 void UUltraAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -55,11 +68,14 @@ void UUltraAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AA
 
 			if (UltraAbilityCDO->GetInstancingPolicy() != EGameplayAbilityInstancingPolicy::NonInstanced)
 			{
-				TArray<UGameplayAbility*> Instances = AbilitySpec.GetAbilityInstances();
-				for (UGameplayAbility* AbilityInstance : Instances)
+				// Walk the instance arrays directly rather than copying them with GetAbilityInstances()
+				for (UGameplayAbility* AbilityInstance : AbilitySpec.ReplicatedInstances)
+				{
+					CastChecked<UUltraGameplayAbility>(AbilityInstance)->OnPawnAvatarSet();
+				}
+				for (UGameplayAbility* AbilityInstance : AbilitySpec.NonReplicatedInstances)
 				{
-					UUltraGameplayAbility* UltraAbilityInstance = CastChecked<UUltraGameplayAbility>(AbilityInstance);
-					UltraAbilityInstance->OnPawnAvatarSet();
+					CastChecked<UUltraGameplayAbility>(AbilityInstance)->OnPawnAvatarSet();
 				}
 			}
 			else
@@ -94,60 +110,124 @@ void UUltraAbilitySystemComponent::TryActivateAbilitiesOnSpawn()
 }
 
 void UUltraAbilitySystemComponent::CancelAbilitiesByFunc(TShouldCancelAbilityFunc ShouldCancelFunc, bool bReplicateCancelAbility)
+{
+	CancelActiveAbilitiesInBuckets(MAX_uint32, MAX_uint32, ShouldCancelFunc, bReplicateCancelAbility);
+}
+
+void UUltraAbilitySystemComponent::CancelActiveAbilitiesInBuckets(uint32 GroupMask, uint32 PolicyMask, TShouldCancelAbilityFunc ShouldCancelFunc, bool bReplicateCancelAbility)
 {
 	ABILITYLIST_SCOPE_LOCK();
-	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+
+	// Gather first, canceling an ability ends it and removes it from the index
+	TArray<FActiveAbilityEntry, TInlineAllocator<16>> EntriesToCancel;
+	for (uint8 Group = 0; Group < (uint8)EUltraAbilityActivationGroup::MAX; ++Group)
 	{
-		if (!AbilitySpec.IsActive())
+		if ((GroupMask & (1u << Group)) == 0)
 		{
 			continue;
 		}
 
-		UUltraGameplayAbility* UltraAbilityCDO = CastChecked<UUltraGameplayAbility>(AbilitySpec.Ability);
-
-		if (UltraAbilityCDO->GetInstancingPolicy() != EGameplayAbilityInstancingPolicy::NonInstanced)
+		for (uint8 Policy = 0; Policy < (uint8)EUltraAbilityActivationPolicy::MAX; ++Policy)
 		{
-			// Cancel all the spawned instances, not the CDO.
-			TArray<UGameplayAbility*> Instances = AbilitySpec.GetAbilityInstances();
-			for (UGameplayAbility* AbilityInstance : Instances)
+			if ((PolicyMask & (1u << Policy)) == 0)
 			{
-				UUltraGameplayAbility* UltraAbilityInstance = CastChecked<UUltraGameplayAbility>(AbilityInstance);
+				continue;
+			}
 
-				if (ShouldCancelFunc(UltraAbilityInstance, AbilitySpec.Handle))
+			for (const FActiveAbilityEntry& Entry : ActiveAbilityIndex[Group][Policy])
+			{
+				if (ShouldCancelFunc(Entry.Ability, Entry.Handle))
 				{
-					if (UltraAbilityInstance->CanBeCanceled())
-					{
-						UltraAbilityInstance->CancelAbility(AbilitySpec.Handle, AbilityActorInfo.Get(), UltraAbilityInstance->GetCurrentActivationInfo(), bReplicateCancelAbility);
-					}
-					else
-					{
-						UE_LOG(LogUltraAbilitySystem, Error, TEXT("CancelAbilitiesByFunc: Can't cancel ability [%s] because CanBeCanceled is false."), *UltraAbilityInstance->GetName());
-					}
+					EntriesToCancel.Add(Entry);
 				}
 			}
 		}
+	}
+
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> CanceledNonInstancedHandles;
+	for (const FActiveAbilityEntry& Entry : EntriesToCancel)
+	{
+		UUltraGameplayAbility* UltraAbility = Entry.Ability;
+
+		if (UltraAbility->GetInstancingPolicy() != EGameplayAbilityInstancingPolicy::NonInstanced)
+		{
+			// An earlier cancel may already have ended this instance.
+			if (!UltraAbility->IsActive())
+			{
+				continue;
+			}
+
+			if (UltraAbility->CanBeCanceled())
+			{
+				UltraAbility->CancelAbility(Entry.Handle, AbilityActorInfo.Get(), UltraAbility->GetCurrentActivationInfo(), bReplicateCancelAbility);
+			}
+			else
+			{
+				UE_LOG(LogUltraAbilitySystem, Error, TEXT("CancelAbilitiesByFunc: Can't cancel ability [%s] because CanBeCanceled is false."), *UltraAbility->GetName());
+			}
+		}
 		else
 		{
-			// Cancel the non-instanced ability CDO.
-			if (ShouldCancelFunc(UltraAbilityCDO, AbilitySpec.Handle))
+			// A non-instanced ability has one entry per activation but is canceled once per spec.
+			if (CanceledNonInstancedHandles.Contains(Entry.Handle))
+			{
+				continue;
+			}
+			CanceledNonInstancedHandles.Add(Entry.Handle);
+
+			const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(Entry.Handle);
+			if ((AbilitySpec == nullptr) || !AbilitySpec->IsActive())
 			{
-				// Non-instanced abilities can always be canceled.
-				check(UltraAbilityCDO->CanBeCanceled());
-				UltraAbilityCDO->CancelAbility(AbilitySpec.Handle, AbilityActorInfo.Get(), FGameplayAbilityActivationInfo(), bReplicateCancelAbility);
+				continue;
 			}
+
+			// Non-instanced abilities can always be canceled.
+			check(UltraAbility->CanBeCanceled());
+			UltraAbility->CancelAbility(Entry.Handle, AbilityActorInfo.Get(), FGameplayAbilityActivationInfo(), bReplicateCancelAbility);
 		}
 	}
 }
 
 void UUltraAbilitySystemComponent::CancelInputActivatedAbilities(bool bReplicateCancelAbility)
 {
-	auto ShouldCancelFunc = [this](const UUltraGameplayAbility* UltraAbility, FGameplayAbilitySpecHandle Handle)
+	auto ShouldCancelFunc = [](const UUltraGameplayAbility* UltraAbility, FGameplayAbilitySpecHandle Handle)
 	{
-		const EUltraAbilityActivationPolicy ActivationPolicy = UltraAbility->GetActivationPolicy();
-		return ((ActivationPolicy == EUltraAbilityActivationPolicy::OnInputTriggered) || (ActivationPolicy == EUltraAbilityActivationPolicy::WhileInputActive));
+		return true;
 	};
 
-	CancelAbilitiesByFunc(ShouldCancelFunc, bReplicateCancelAbility);
+	const uint32 PolicyMask = (1u << (uint8)EUltraAbilityActivationPolicy::OnInputTriggered) | (1u << (uint8)EUltraAbilityActivationPolicy::WhileInputActive);
+	CancelActiveAbilitiesInBuckets(MAX_uint32, PolicyMask, ShouldCancelFunc, bReplicateCancelAbility);
+}
+
+void UUltraAbilitySystemComponent::AddToActiveAbilityIndex(FGameplayAbilitySpecHandle Handle, UUltraGameplayAbility* UltraAbility)
+{
+	FActiveAbilityEntry& Entry = ActiveAbilityIndex[(uint8)UltraAbility->GetActivationGroup()][(uint8)UltraAbility->GetActivationPolicy()].AddDefaulted_GetRef();
+	Entry.Ability = UltraAbility;
+	Entry.Handle = Handle;
+}
+
+void UUltraAbilitySystemComponent::RemoveFromActiveAbilityIndex(FGameplayAbilitySpecHandle Handle, UUltraGameplayAbility* UltraAbility)
+{
+	TArray<FActiveAbilityEntry>& Bucket = ActiveAbilityIndex[(uint8)UltraAbility->GetActivationGroup()][(uint8)UltraAbility->GetActivationPolicy()];
+	const int32 EntryIndex = Bucket.IndexOfByPredicate([Handle, UltraAbility](const FActiveAbilityEntry& Entry) { return (Entry.Ability == UltraAbility) && (Entry.Handle == Handle); });
+	if (EntryIndex != INDEX_NONE)
+	{
+		Bucket.RemoveAtSwap(EntryIndex, 1, /*bAllowShrinking=*/ false);
+	}
+}
+
+void UUltraAbilitySystemComponent::MoveActiveAbilityToGroup(FGameplayAbilitySpecHandle Handle, UUltraGameplayAbility* UltraAbility, EUltraAbilityActivationGroup OldGroup, EUltraAbilityActivationGroup NewGroup)
+{
+	check(UltraAbility);
+
+	const uint8 Policy = (uint8)UltraAbility->GetActivationPolicy();
+	TArray<FActiveAbilityEntry>& OldBucket = ActiveAbilityIndex[(uint8)OldGroup][Policy];
+	const int32 EntryIndex = OldBucket.IndexOfByPredicate([Handle, UltraAbility](const FActiveAbilityEntry& Entry) { return (Entry.Ability == UltraAbility) && (Entry.Handle == Handle); });
+	if (EntryIndex != INDEX_NONE)
+	{
+		ActiveAbilityIndex[(uint8)NewGroup][Policy].Add(OldBucket[EntryIndex]);
+		OldBucket.RemoveAtSwap(EntryIndex, 1, /*bAllowShrinking=*/ false);
+	}
 }
 
 void UUltraAbilitySystemComponent::AbilitySpecInputPressed(FGameplayAbilitySpec& Spec)
@@ -317,6 +397,7 @@ void UUltraAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbility
 
 	UUltraGameplayAbility* UltraAbility = CastChecked<UUltraGameplayAbility>(Ability);
 
+	AddToActiveAbilityIndex(Handle, UltraAbility);
 	AddAbilityToActivationGroup(UltraAbility->GetActivationGroup(), UltraAbility);
 }
 
@@ -342,6 +423,7 @@ void UUltraAbilitySystemComponent::NotifyAbilityEnded(FGameplayAbilitySpecHandle
 
 	UUltraGameplayAbility* UltraAbility = CastChecked<UUltraGameplayAbility>(Ability);
 
+	RemoveFromActiveAbilityIndex(Handle, UltraAbility);
 	RemoveAbilityFromActivationGroup(UltraAbility->GetActivationGroup(), UltraAbility);
 }
 
@@ -463,12 +545,12 @@ void UUltraAbilitySystemComponent::RemoveAbilityFromActivationGroup(EUltraAbilit
 
 void UUltraAbilitySystemComponent::CancelActivationGroupAbilities(EUltraAbilityActivationGroup Group, UUltraGameplayAbility* IgnoreUltraAbility, bool bReplicateCancelAbility)
 {
-	auto ShouldCancelFunc = [this, Group, IgnoreUltraAbility](const UUltraGameplayAbility* UltraAbility, FGameplayAbilitySpecHandle Handle)
+	auto ShouldCancelFunc = [Group, IgnoreUltraAbility](const UUltraGameplayAbility* UltraAbility, FGameplayAbilitySpecHandle Handle)
 	{
 		return ((UltraAbility->GetActivationGroup() == Group) && (UltraAbility != IgnoreUltraAbility));
 	};
 
-	CancelAbilitiesByFunc(ShouldCancelFunc, bReplicateCancelAbility);
+	CancelActiveAbilitiesInBuckets((1u << (uint8)Group), MAX_uint32, ShouldCancelFunc, bReplicateCancelAbility);
 }
 
 void UUltraAbilitySystemComponent::AddDynamicTagGameplayEffect(const FGameplayTag& Tag)
@@ -509,6 +591,58 @@ void UUltraAbilitySystemComponent::RemoveDynamicTagGameplayEffect(const FGamepla
 	RemoveActiveEffects(Query);
 }
 
+void UUltraAbilitySystemComponent::AddReplicatedDynamicTag(const FGameplayTag& Tag, int32 Count)
+{
+	if (!IsOwnerActorAuthoritative())
+	{
+		UE_LOG(LogUltraAbilitySystem, Warning, TEXT("AddReplicatedDynamicTag: [%s] can only be added with authority."), *Tag.ToString());
+		return;
+	}
+
+	ReplicatedDynamicTags.AddTag(Tag, Count);
+}
+
+void UUltraAbilitySystemComponent::RemoveReplicatedDynamicTag(const FGameplayTag& Tag)
+{
+	if (!IsOwnerActorAuthoritative())
+	{
+		UE_LOG(LogUltraAbilitySystem, Warning, TEXT("RemoveReplicatedDynamicTag: [%s] can only be removed with authority."), *Tag.ToString());
+		return;
+	}
+
+	ReplicatedDynamicTags.RemoveAllOfTag(Tag);
+}
+
+uint32 UUltraAbilitySystemComponent::GetReplicatedStateKey() const
+{
+	// Fast array replication keys only ever increase when an item is marked dirty, so their sum changes with any of them
+	uint32 Key = ReplicatedAttributeChangeCount;
+	Key += (uint32)ActiveGameplayEffects.ArrayReplicationKey;
+	Key += (uint32)ActivatableAbilities.ArrayReplicationKey;
+	Key += (uint32)ActiveGameplayCues.ArrayReplicationKey;
+	Key += (uint32)MinimalReplicationGameplayCues.ArrayReplicationKey;
+	Key += (uint32)ReplicatedPredictionKeyMap.ArrayReplicationKey;
+	Key += (uint32)ReplicatedDynamicTags.ArrayReplicationKey;
+
+	// Minimal and loose tag maps bump their map id on every add or remove
+	Key += (uint32)MinimalReplicationTags.MapID;
+	Key += (uint32)ReplicatedLooseTags.MapID;
+
+	// The montage info is rewritten in place while a montage plays, so hash what is sent
+	uint32 MontageKey = GetTypeHash(RepAnimMontageInfo.Animation);
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.PlayRate));
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.Position));
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.BlendTime));
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.NextSectionID));
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.PlayInstanceId));
+	MontageKey = HashCombine(MontageKey, (uint32)RepAnimMontageInfo.IsStopped);
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.SectionIdToPlay));
+	MontageKey = HashCombine(MontageKey, GetTypeHash(RepAnimMontageInfo.PredictionKey.Current));
+	Key += MontageKey;
+
+	return Key;
+}
+
 void UUltraAbilitySystemComponent::GetAbilityTargetData(const FGameplayAbilitySpecHandle AbilityHandle, FGameplayAbilityActivationInfo ActivationInfo, FGameplayAbilityTargetDataHandle& OutTargetDataHandle)
 {
 	TSharedPtr<FAbilityReplicatedDataCache> ReplicatedData = AbilityTargetDataMap.Find(FGameplayAbilitySpecHandleAndPredictionKey(AbilityHandle, ActivationInfo.GetActivationPredictionKey()));
@@ -518,3 +652,89 @@ void UUltraAbilitySystemComponent::GetAbilityTargetData(const FGameplayAbilitySp
 	}
 }
 
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs GUltraDynamicTagBenchmarkCmd(
+	TEXT("Ultra.AbilitySystem.DynamicTagBenchmark"),
+	TEXT("Adds and removes a dynamic tag on the authoritative ability system components in the world, first with the dynamic tag gameplay effect and then with replicated loose tags, and logs the CPU cost of each. Usage: Ultra.AbilitySystem.DynamicTagBenchmark [NumPawns=64] [Iterations=100] [Tag=Cheat.UnlimitedHealth]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World)
+{
+	const int32 NumPawns = (Params.Num() > 0) ? FMath::Max(FCString::Atoi(*Params[0]), 1) : 64;
+	const int32 Iterations = (Params.Num() > 1) ? FMath::Max(FCString::Atoi(*Params[1]), 1) : 100;
+	const FGameplayTag Tag = (Params.Num() > 2) ? FGameplayTag::RequestGameplayTag(FName(*Params[2]), /*ErrorIfNotFound=*/ false) : UltraGameplayTags::Cheat_UnlimitedHealth;
+
+	if (!Tag.IsValid())
+	{
+		UE_LOG(LogUltraAbilitySystem, Error, TEXT("Ultra.AbilitySystem.DynamicTagBenchmark: unknown tag %s"), *Params[2]);
+		return;
+	}
+
+	TArray<UUltraAbilitySystemComponent*> ASCs;
+	for (TObjectIterator<UUltraAbilitySystemComponent> It; It && (ASCs.Num() < NumPawns); ++It)
+	{
+		if ((It->GetWorld() == World) && It->IsOwnerActorAuthoritative() && (It->GetAvatarActor() != nullptr))
+		{
+			ASCs.Add(*It);
+		}
+	}
+
+	if (ASCs.Num() == 0)
+	{
+		UE_LOG(LogUltraAbilitySystem, Error, TEXT("Ultra.AbilitySystem.DynamicTagBenchmark: no authoritative ability system components with an avatar in the world"));
+		return;
+	}
+
+	if (ASCs.Num() < NumPawns)
+	{
+		UE_LOG(LogUltraAbilitySystem, Warning, TEXT("Ultra.AbilitySystem.DynamicTagBenchmark: only found %d of %d pawns, add bots to reach the full count"), ASCs.Num(), NumPawns);
+	}
+
+	int32 PeakActiveEffects = 0;
+	const double EffectStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (UUltraAbilitySystemComponent* ASC : ASCs)
+		{
+			ASC->AddDynamicTagGameplayEffect(Tag);
+		}
+		if (Iteration == 0)
+		{
+			for (const UUltraAbilitySystemComponent* ASC : ASCs)
+			{
+				PeakActiveEffects += ASC->GetNumActiveGameplayEffects();
+			}
+		}
+		for (UUltraAbilitySystemComponent* ASC : ASCs)
+		{
+			ASC->RemoveDynamicTagGameplayEffect(Tag);
+		}
+	}
+	const double EffectSeconds = FPlatformTime::Seconds() - EffectStartTime;
+
+	const double LooseTagStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (UUltraAbilitySystemComponent* ASC : ASCs)
+		{
+			ASC->AddReplicatedDynamicTag(Tag);
+		}
+		for (UUltraAbilitySystemComponent* ASC : ASCs)
+		{
+			ASC->RemoveReplicatedDynamicTag(Tag);
+		}
+	}
+	const double LooseTagSeconds = FPlatformTime::Seconds() - LooseTagStartTime;
+
+	const double NumOperations = (double)ASCs.Num() * Iterations;
+	UE_LOG(LogUltraAbilitySystem, Display, TEXT("Dynamic tag benchmark: %d pawns x %d add/remove pairs of %s"), ASCs.Num(), Iterations, *Tag.ToString());
+	UE_LOG(LogUltraAbilitySystem, Display, TEXT("  Gameplay effect: %.2f ms total, %.2f us per add/remove, %d active effects across all pawns while applied"),
+		EffectSeconds * 1000.0, (EffectSeconds / NumOperations) * 1000000.0, PeakActiveEffects);
+	UE_LOG(LogUltraAbilitySystem, Display, TEXT("  Replicated loose tag: %.2f ms total, %.2f us per add/remove (%.1fx)"),
+		LooseTagSeconds * 1000.0, (LooseTagSeconds / NumOperations) * 1000000.0, (LooseTagSeconds > 0.0) ? (EffectSeconds / LooseTagSeconds) : 0.0);
+}));
+
+#endif // !UE_BUILD_SHIPPING
@@ -5,6 +5,7 @@
 #include "Abilities/UltraGameplayAbility.h"
 #include "AbilitySystemComponent.h"
 #include "NativeGameplayTags.h"
+#include "UltraReplicatedLooseTags.h"
 
 #include "UltraAbilitySystemComponent.generated.h"
 
@@ -31,6 +32,10 @@ public:
 
 	UUltraAbilitySystemComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	//~UObject interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	//~End of UObject interface
+
 	//~UActorComponent interface
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~End of UActorComponent interface
@@ -53,12 +58,29 @@ public:
 	void RemoveAbilityFromActivationGroup(EUltraAbilityActivationGroup Group, UUltraGameplayAbility* UltraAbility);
 	void CancelActivationGroupAbilities(EUltraAbilityActivationGroup Group, UUltraGameplayAbility* IgnoreUltraAbility, bool bReplicateCancelAbility);
 
+	// Moves an active ability between activation group buckets of the active ability index (see ActiveAbilityIndex).
+	void MoveActiveAbilityToGroup(FGameplayAbilitySpecHandle Handle, UUltraGameplayAbility* UltraAbility, EUltraAbilityActivationGroup OldGroup, EUltraAbilityActivationGroup NewGroup);
+
 	// Uses a gameplay effect to add the specified dynamic granted tag.
 	void AddDynamicTagGameplayEffect(const FGameplayTag& Tag);
 
 	// Removes all active instances of the gameplay effect that was used to add the specified dynamic granted tag.
 	void RemoveDynamicTagGameplayEffect(const FGameplayTag& Tag);
 
+	// Adds a replicated loose tag without going through a gameplay effect (authority only).
+	void AddReplicatedDynamicTag(const FGameplayTag& Tag, int32 Count = 1);
+
+	// Removes every count of a tag added with AddReplicatedDynamicTag (authority only).
+	void RemoveReplicatedDynamicTag(const FGameplayTag& Tag);
+
+	// Returns a value that changes whenever this component has new state to replicate (active effects, granted abilities,
+	// gameplay cues, prediction keys, dynamic, loose and minimal tags, the replicated montage or attribute values).
+	// Cheap enough to poll, only meaningful on the authority.
+	uint32 GetReplicatedStateKey() const;
+
+	// Called by UUltraAttributeSet when an attribute value changes so GetReplicatedStateKey picks it up.
+	void NotifyReplicatedAttributeChanged() { ++ReplicatedAttributeChangeCount; }
+
 	/** Gets the ability target data associated with the given ability handle and activation info */
 	void GetAbilityTargetData(const FGameplayAbilitySpecHandle AbilityHandle, FGameplayAbilityActivationInfo ActivationInfo, FGameplayAbilityTargetDataHandle& OutTargetDataHandle);
 
@@ -72,6 +94,12 @@ protected:
 
 	void TryActivateAbilitiesOnSpawn();
 
+	// Cancels the active abilities in the index buckets selected by the group and policy masks (bit per enum value) that pass ShouldCancelFunc.
+	void CancelActiveAbilitiesInBuckets(uint32 GroupMask, uint32 PolicyMask, TShouldCancelAbilityFunc ShouldCancelFunc, bool bReplicateCancelAbility);
+
+	void AddToActiveAbilityIndex(FGameplayAbilitySpecHandle Handle, UUltraGameplayAbility* UltraAbility);
+	void RemoveFromActiveAbilityIndex(FGameplayAbilitySpecHandle Handle, UUltraGameplayAbility* UltraAbility);
+
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
@@ -103,4 +131,24 @@ protected:
 
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)EUltraAbilityActivationGroup::MAX];
+
+	// An ability that is currently running: the instance for instanced abilities, the CDO for non-instanced ones
+	struct FActiveAbilityEntry
+	{
+		UUltraGameplayAbility* Ability = nullptr;
+		FGameplayAbilitySpecHandle Handle;
+	};
+
+	// Running abilities bucketed by activation group and activation policy, updated as abilities activate and end
+	// so cancellation only visits what is active instead of every activatable spec.
+	TArray<FActiveAbilityEntry> ActiveAbilityIndex[(uint8)EUltraAbilityActivationGroup::MAX][(uint8)EUltraAbilityActivationPolicy::MAX];
+
+private:
+
+	// Dynamic tags added on the server, replicated as tag counts and applied as loose tags on every machine
+	UPROPERTY(Replicated)
+	FUltraReplicatedLooseTagContainer ReplicatedDynamicTags;
+
+	// Number of attribute value changes seen on this component, part of GetReplicatedStateKey
+	uint32 ReplicatedAttributeChangeCount = 0;
 };
@@ -6,6 +6,11 @@
 #include "GameplayCueSet.h"
 #include "AbilitySystemGlobals.h"
 #include "GameplayTagsManager.h"
+#include "GameModes/UltraExperienceDefinition.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "UObject/UObjectThreadContext.h"
 #include "Async/Async.h"
 
@@ -34,6 +39,61 @@ namespace UltraGameplayCueManagerCvars
 		TEXT("Shows all assets that were loaded via UltraGameplayCueManager and are currently in memory."),
 		FConsoleCommandWithArgsDelegate::CreateStatic(UUltraGameplayCueManager::DumpGameplayCues));
 
+	static FAutoConsoleCommand CVarDumpGameplayCueUsage(
+		TEXT("Ultra.DumpGameplayCueUsage"),
+		TEXT("Shows the hits, misses and late loads of every gameplay cue executed so far and what handling them cost. Pass Reset to clear the counters."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(UUltraGameplayCueManager::DumpGameplayCueUsage));
+
+	static FAutoConsoleCommand CVarSaveGameplayCueManifest(
+		TEXT("Ultra.GameplayCues.SaveManifest"),
+		TEXT("Saves the gameplay cues executed under each experience to Saved/GameplayCueManifests/, to be preloaded the next time the experience loads."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (UUltraGameplayCueManager* GCM = UUltraGameplayCueManager::Get())
+			{
+				GCM->SaveRecordedManifests();
+			}
+		}));
+
+#if WITH_EDITOR
+	static FAutoConsoleCommand CVarApplyGameplayCueManifest(
+		TEXT("Ultra.GameplayCues.ApplyManifestToExperience"),
+		TEXT("Adds the gameplay cues executed under each experience to the GameplayCueManifest of the experience asset, so they are cooked with it. The assets still need to be saved."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (UUltraGameplayCueManager* GCM = UUltraGameplayCueManager::Get())
+			{
+				GCM->ApplyRecordedManifestsToExperiences();
+			}
+		}));
+#endif
+
+#if !UE_BUILD_SHIPPING
+	// Off by default since it adds a lookup to every executed cue, manifest recording runs turn it on with -RecordGameplayCueManifest
+	static bool bRecordCueUsage = false;
+	static FAutoConsoleVariableRef CVarRecordCueUsage(
+		TEXT("Ultra.GameplayCues.RecordUsage"),
+		bRecordCueUsage,
+		TEXT("Record which gameplay cues are executed under each experience and whether they were loaded in time. Also enabled by -RecordGameplayCueManifest."),
+		ECVF_Default);
+#else
+	static constexpr bool bRecordCueUsage = false;
+#endif
+
+	static bool bPreloadManifestCues = true;
+	static FAutoConsoleVariableRef CVarPreloadManifestCues(
+		TEXT("Ultra.GameplayCues.PreloadManifest"),
+		bPreloadManifestCues,
+		TEXT("Load the gameplay cues in the manifest of an experience as part of loading the experience."),
+		ECVF_Default);
+
+	static bool bAutoSaveManifest = !UE_BUILD_SHIPPING;
+	static FAutoConsoleVariableRef CVarAutoSaveManifest(
+		TEXT("Ultra.GameplayCues.AutoSaveManifest"),
+		bAutoSaveManifest,
+		TEXT("Save the recorded gameplay cue manifest of an experience when it is unloaded."),
+		ECVF_Default);
+
 	static EUltraEditorLoadMode LoadMode = EUltraEditorLoadMode::LoadUpfront;
 }
 
@@ -65,6 +125,13 @@ void UUltraGameplayCueManager::OnCreated()
 {
 	Super::OnCreated();
 
+#if !UE_BUILD_SHIPPING
+	if (FParse::Param(FCommandLine::Get(), TEXT("RecordGameplayCueManifest")))
+	{
+		UltraGameplayCueManagerCvars::bRecordCueUsage = true;
+	}
+#endif
+
 	UpdateDelayLoadDelegateListeners();
 }
 
@@ -123,6 +190,295 @@ bool UUltraGameplayCueManager::ShouldAsyncLoadMissingGameplayCues() const
 	return true;
 }
 
+void UUltraGameplayCueManager::HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+	// Removal only ever follows an execution that was already recorded
+	const FGameplayCueNotifyData* CueData = (UltraGameplayCueManagerCvars::bRecordCueUsage && (EventType != EGameplayCueEvent::Removed)) ? FindCueData(GameplayCueTag) : nullptr;
+	if (CueData == nullptr)
+	{
+		Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+		return;
+	}
+
+	// Copy what we need before handling the cue, a missing cue load can add to the cue set
+	const FGameplayCueNotifyData CueDataCopy = *CueData;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+	RecordCueExecution(CueDataCopy, FPlatformTime::Seconds() - StartTime);
+}
+
+const FGameplayCueNotifyData* UUltraGameplayCueManager::FindCueData(const FGameplayTag& Tag) const
+{
+	const UGameplayCueSet* CueSet = RuntimeGameplayCueObjectLibrary.CueSet;
+	const int32* DataIdx = CueSet ? CueSet->GameplayCueDataMap.Find(Tag) : nullptr;
+	if (DataIdx && CueSet->GameplayCueData.IsValidIndex(*DataIdx))
+	{
+		return &CueSet->GameplayCueData[*DataIdx];
+	}
+	return nullptr;
+}
+
+void UUltraGameplayCueManager::RecordCueExecution(const FGameplayCueNotifyData& CueData, double HandleSeconds)
+{
+	// Record the tag of the notify rather than the executed tag, which may be a child handled by its parent's notify
+	const FGameplayTag& Tag = CueData.GameplayCueTag;
+
+	FGameplayCueUsage& Usage = CueUsage.FindOrAdd(Tag);
+	Usage.HandleSeconds += HandleSeconds;
+	Usage.bInManifest = RecordingExperienceManifest.HasTagExact(Tag);
+
+	if (RecordingExperienceId.IsValid())
+	{
+		RecordedCueManifests.FindOrAdd(RecordingExperienceId).AddTag(Tag);
+	}
+
+	if (CueData.LoadedGameplayCueClass || CueData.GameplayCueNotifyObj.ResolveObject())
+	{
+		++Usage.NumHits;
+		return;
+	}
+
+	++Usage.NumMisses;
+
+	// Time how long the notify takes to show up, the missing cue load started by the base class shares this request
+	if (!PendingLateLoads.Contains(Tag))
+	{
+		PendingLateLoads.Add(Tag);
+		StreamableManager.RequestAsyncLoad(CueData.GameplayCueNotifyObj, FStreamableDelegate::CreateUObject(this, &ThisClass::OnMissedCueLoadComplete, Tag, FPlatformTime::Seconds()), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("GameplayCueManager"));
+	}
+}
+
+void UUltraGameplayCueManager::OnMissedCueLoadComplete(FGameplayTag Tag, double RequestTime)
+{
+	PendingLateLoads.Remove(Tag);
+
+	if (FGameplayCueUsage* Usage = CueUsage.Find(Tag))
+	{
+		const double LoadSeconds = FPlatformTime::Seconds() - RequestTime;
+		++Usage->NumLateLoads;
+		Usage->LateLoadSeconds += LoadSeconds;
+		Usage->MaxLateLoadSeconds = FMath::Max(Usage->MaxLateLoadSeconds, LoadSeconds);
+	}
+}
+
+FGameplayTagContainer UUltraGameplayCueManager::GetManifestTags(const UUltraExperienceDefinition* Experience) const
+{
+	FGameplayTagContainer ManifestTags = Experience->GameplayCueManifest;
+
+#if !UE_BUILD_SHIPPING
+	// Pick up manifests recorded locally that were not applied to the asset yet
+	TArray<FString> SavedTagNames;
+	if (FFileHelper::LoadFileToStringArray(SavedTagNames, *GetSavedManifestFilename(Experience->GetPrimaryAssetId())))
+	{
+		UGameplayTagsManager& TagManager = UGameplayTagsManager::Get();
+		for (const FString& TagName : SavedTagNames)
+		{
+			const FGameplayTag Tag = TagManager.RequestGameplayTag(FName(*TagName.TrimStartAndEnd()), /*ErrorIfNotFound=*/ false);
+			if (Tag.IsValid())
+			{
+				ManifestTags.AddTag(Tag);
+			}
+		}
+	}
+#endif
+
+	return ManifestTags;
+}
+
+void UUltraGameplayCueManager::GetManifestCuePaths(const UUltraExperienceDefinition* Experience, TArray<FSoftObjectPath>& OutPaths) const
+{
+	if ((Experience == nullptr) || !UltraGameplayCueManagerCvars::bPreloadManifestCues)
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : GetManifestTags(Experience))
+	{
+		if (const FGameplayCueNotifyData* CueData = FindCueData(Tag))
+		{
+			if ((CueData->LoadedGameplayCueClass == nullptr) && CueData->GameplayCueNotifyObj.IsValid())
+			{
+				OutPaths.AddUnique(CueData->GameplayCueNotifyObj);
+			}
+		}
+	}
+}
+
+void UUltraGameplayCueManager::OnExperienceLoaded(const UUltraExperienceDefinition* Experience)
+{
+	if (Experience == nullptr)
+	{
+		return;
+	}
+
+	RecordingExperienceId = Experience->GetPrimaryAssetId();
+	RecordingExperienceManifest = GetManifestTags(Experience);
+
+	if (UltraGameplayCueManagerCvars::bPreloadManifestCues)
+	{
+		// The notifies were loaded with the experience, reference them from it so they stay loaded until it goes away
+		UObject* OwningObject = const_cast<UUltraExperienceDefinition*>(Experience);
+		int32 NumRegistered = 0;
+		for (const FGameplayTag& Tag : RecordingExperienceManifest)
+		{
+			const FGameplayCueNotifyData* CueData = FindCueData(Tag);
+			if (UClass* LoadedGameplayCueClass = CueData ? Cast<UClass>(CueData->GameplayCueNotifyObj.ResolveObject()) : nullptr)
+			{
+				RegisterPreloadedCue(LoadedGameplayCueClass, OwningObject);
+				++NumRegistered;
+			}
+		}
+
+		UE_LOG(LogUltra, Log, TEXT("Preloaded %d of %d gameplay cues in the manifest of %s"), NumRegistered, RecordingExperienceManifest.Num(), *RecordingExperienceId.ToString());
+	}
+}
+
+void UUltraGameplayCueManager::OnExperienceUnloaded(const UUltraExperienceDefinition* Experience)
+{
+	if ((Experience == nullptr) || (Experience->GetPrimaryAssetId() != RecordingExperienceId))
+	{
+		return;
+	}
+
+	if (UltraGameplayCueManagerCvars::bAutoSaveManifest)
+	{
+		SaveRecordedManifests();
+	}
+
+	RecordingExperienceId = FPrimaryAssetId();
+	RecordingExperienceManifest.Reset();
+}
+
+FString UUltraGameplayCueManager::GetSavedManifestFilename(const FPrimaryAssetId& ExperienceId)
+{
+	return FPaths::ProjectSavedDir() / TEXT("GameplayCueManifests") / (ExperienceId.PrimaryAssetName.ToString() + TEXT(".txt"));
+}
+
+void UUltraGameplayCueManager::SaveRecordedManifests() const
+{
+	UGameplayTagsManager& TagManager = UGameplayTagsManager::Get();
+
+	for (const auto& KVP : RecordedCueManifests)
+	{
+		const FString Filename = GetSavedManifestFilename(KVP.Key);
+
+		// Merge with earlier sessions, a single play session rarely executes every cue
+		TSet<FString> TagNames;
+		TArray<FString> SavedTagNames;
+		if (FFileHelper::LoadFileToStringArray(SavedTagNames, *Filename))
+		{
+			for (const FString& TagName : SavedTagNames)
+			{
+				const FString TrimmedName = TagName.TrimStartAndEnd();
+				if (TagManager.RequestGameplayTag(FName(*TrimmedName), /*ErrorIfNotFound=*/ false).IsValid())
+				{
+					TagNames.Add(TrimmedName);
+				}
+			}
+		}
+
+		for (const FGameplayTag& Tag : KVP.Value)
+		{
+			TagNames.Add(Tag.ToString());
+		}
+
+		TArray<FString> SortedTagNames = TagNames.Array();
+		SortedTagNames.Sort();
+
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+		if (FFileHelper::SaveStringArrayToFile(SortedTagNames, *Filename))
+		{
+			UE_LOG(LogUltra, Log, TEXT("Saved gameplay cue manifest of %s (%d cues) to %s"), *KVP.Key.ToString(), SortedTagNames.Num(), *Filename);
+		}
+		else
+		{
+			UE_LOG(LogUltra, Error, TEXT("Failed to save gameplay cue manifest of %s to %s"), *KVP.Key.ToString(), *Filename);
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UUltraGameplayCueManager::ApplyRecordedManifestsToExperiences() const
+{
+	for (const auto& KVP : RecordedCueManifests)
+	{
+		const FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(KVP.Key);
+		UUltraExperienceDefinition* Experience = Cast<UUltraExperienceDefinition>(AssetPath.TryLoad());
+		if (Experience == nullptr)
+		{
+			UE_LOG(LogUltra, Warning, TEXT("ApplyManifestToExperience: could not load experience %s"), *KVP.Key.ToString());
+			continue;
+		}
+
+		if (Experience->GameplayCueManifest.HasAllExact(KVP.Value))
+		{
+			continue;
+		}
+
+		Experience->Modify();
+		Experience->GameplayCueManifest.AppendTags(KVP.Value);
+		Experience->MarkPackageDirty();
+
+		UE_LOG(LogUltra, Log, TEXT("ApplyManifestToExperience: %s now lists %d gameplay cues"), *KVP.Key.ToString(), Experience->GameplayCueManifest.Num());
+	}
+}
+#endif
+
+void UUltraGameplayCueManager::DumpGameplayCueUsage(const TArray<FString>& Args)
+{
+	UUltraGameplayCueManager* GCM = Cast<UUltraGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
+	if (!GCM)
+	{
+		UE_LOG(LogUltra, Error, TEXT("DumpGameplayCueUsage failed. No UUltraGameplayCueManager found."));
+		return;
+	}
+
+	if (Args.Contains(TEXT("Reset")))
+	{
+		GCM->CueUsage.Reset();
+		UE_LOG(LogUltra, Log, TEXT("Gameplay cue usage counters reset"));
+		return;
+	}
+
+	// Worst offenders first
+	TArray<FGameplayTag> SortedTags;
+	GCM->CueUsage.GenerateKeyArray(SortedTags);
+	SortedTags.Sort([GCM](const FGameplayTag& A, const FGameplayTag& B)
+	{
+		const FGameplayCueUsage& UsageA = GCM->CueUsage.FindChecked(A);
+		const FGameplayCueUsage& UsageB = GCM->CueUsage.FindChecked(B);
+		return (UsageA.NumMisses != UsageB.NumMisses) ? (UsageA.NumMisses > UsageB.NumMisses) : (UsageA.HandleSeconds > UsageB.HandleSeconds);
+	});
+
+	UE_LOG(LogUltra, Log, TEXT("=========== Dumping Gameplay Cue Usage (%s) ==========="), GCM->RecordingExperienceId.IsValid() ? *GCM->RecordingExperienceId.ToString() : TEXT("no experience"));
+
+	int32 TotalHits = 0;
+	int32 TotalMisses = 0;
+	int32 TotalLateLoads = 0;
+	int32 NumNotInManifest = 0;
+	double TotalHandleSeconds = 0.0;
+	for (const FGameplayTag& Tag : SortedTags)
+	{
+		const FGameplayCueUsage& Usage = GCM->CueUsage.FindChecked(Tag);
+		const double AvgLateLoadMs = (Usage.NumLateLoads > 0) ? (Usage.LateLoadSeconds * 1000.0 / Usage.NumLateLoads) : 0.0;
+		UE_LOG(LogUltra, Log, TEXT("  %s: %d hits, %d misses, %d late loads (avg %.2fms, max %.2fms), handled in %.3fms total%s"),
+			*Tag.ToString(), Usage.NumHits, Usage.NumMisses, Usage.NumLateLoads, AvgLateLoadMs, Usage.MaxLateLoadSeconds * 1000.0, Usage.HandleSeconds * 1000.0,
+			Usage.bInManifest ? TEXT("") : TEXT(" [not in manifest]"));
+
+		TotalHits += Usage.NumHits;
+		TotalMisses += Usage.NumMisses;
+		TotalLateLoads += Usage.NumLateLoads;
+		TotalHandleSeconds += Usage.HandleSeconds;
+		NumNotInManifest += Usage.bInManifest ? 0 : 1;
+	}
+
+	UE_LOG(LogUltra, Log, TEXT("=========== Gameplay Cue Usage summary ==========="));
+	UE_LOG(LogUltra, Log, TEXT("  ... %d cues executed, %d of them not in the manifest"), SortedTags.Num(), NumNotInManifest);
+	UE_LOG(LogUltra, Log, TEXT("  ... %d hits, %d misses, %d late loads (%d still pending)"), TotalHits, TotalMisses, TotalLateLoads, GCM->PendingLateLoads.Num());
+	UE_LOG(LogUltra, Log, TEXT("  ... %.3fms spent handling cues"), TotalHandleSeconds * 1000.0);
+}
+
 void UUltraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 {
 	UUltraGameplayCueManager* GCM = Cast<UUltraGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
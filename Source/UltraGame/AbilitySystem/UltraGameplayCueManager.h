@@ -9,7 +9,9 @@
 class FString;
 class UClass;
 class UObject;
+class UUltraExperienceDefinition;
 class UWorld;
+struct FGameplayCueNotifyData;
 struct FObjectKey;
 
 /**
@@ -32,9 +34,28 @@ public:
 	virtual bool ShouldAsyncLoadRuntimeObjectLibraries() const override;
 	virtual bool ShouldSyncLoadMissingGameplayCues() const override;
 	virtual bool ShouldAsyncLoadMissingGameplayCues() const override;
+	virtual void HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
 	//~End of UGameplayCueManager interface
 
 	static void DumpGameplayCues(const TArray<FString>& Args);
+	static void DumpGameplayCueUsage(const TArray<FString>& Args);
+
+	// Gathers the notifies in the cue manifest of an experience that still have to be loaded, so they can be loaded along with it
+	void GetManifestCuePaths(const UUltraExperienceDefinition* Experience, TArray<FSoftObjectPath>& OutPaths) const;
+
+	// Called once an experience has loaded: keeps its manifest cues loaded for as long as it exists and starts recording the cues it executes
+	void OnExperienceLoaded(const UUltraExperienceDefinition* Experience);
+
+	// Called when an experience is torn down: stops recording and saves its manifest if Ultra.GameplayCues.AutoSaveManifest is set
+	void OnExperienceUnloaded(const UUltraExperienceDefinition* Experience);
+
+	// Writes the cues recorded for each experience to Saved/GameplayCueManifests/<Experience>.txt, merged with what was saved before
+	void SaveRecordedManifests() const;
+
+#if WITH_EDITOR
+	// Adds the recorded cues to the GameplayCueManifest of each experience asset so they are cooked with it
+	void ApplyRecordedManifestsToExperiences() const;
+#endif
 
 	// When delay loading cues, this will load the cues that must be always loaded anyway
 	void LoadAlwaysLoadedCues();
@@ -53,6 +74,13 @@ private:
 	void UpdateDelayLoadDelegateListeners();
 	bool ShouldDelayLoadGameplayCues() const;
 
+	FGameplayTagContainer GetManifestTags(const UUltraExperienceDefinition* Experience) const;
+	const FGameplayCueNotifyData* FindCueData(const FGameplayTag& Tag) const;
+	void RecordCueExecution(const FGameplayCueNotifyData& CueData, double HandleSeconds);
+	void OnMissedCueLoadComplete(FGameplayTag Tag, double RequestTime);
+
+	static FString GetSavedManifestFilename(const FPrimaryAssetId& ExperienceId);
+
 private:
 	struct FLoadedGameplayTagToProcessData
 	{
@@ -63,6 +91,25 @@ private:
 		FLoadedGameplayTagToProcessData(const FGameplayTag& InTag, const TWeakObjectPtr<UObject>& InWeakOwner) : Tag(InTag), WeakOwner(InWeakOwner) {}
 	};
 
+	struct FGameplayCueUsage
+	{
+		// Executions where the notify was already loaded
+		int32 NumHits = 0;
+
+		// Executions where the notify was not loaded yet, these are dropped or played late once the load finishes
+		int32 NumMisses = 0;
+
+		// Loads started by a miss and how long they took
+		int32 NumLateLoads = 0;
+		double LateLoadSeconds = 0.0;
+		double MaxLateLoadSeconds = 0.0;
+
+		// Time spent handling the cue on the game thread
+		double HandleSeconds = 0.0;
+
+		bool bInManifest = false;
+	};
+
 private:
 	// Cues that were preloaded on the client due to being referenced by content
 	UPROPERTY(transient)
@@ -76,4 +123,13 @@ private:
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
+
+	// Usage of each executed cue since the last reset, see Ultra.DumpGameplayCueUsage
+	TMap<FGameplayTag, FGameplayCueUsage> CueUsage;
+	TSet<FGameplayTag> PendingLateLoads;
+
+	// Cues executed while each experience was loaded
+	TMap<FPrimaryAssetId, FGameplayTagContainer> RecordedCueManifests;
+	FPrimaryAssetId RecordingExperienceId;
+	FGameplayTagContainer RecordingExperienceManifest;
 };
@@ -32,6 +32,7 @@ bool FUltraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap*
 
 	// Not serialized for post-activation use:
 	// CartridgeID
+	// bScoreResolvedByBatch
 
 	return true;
 }
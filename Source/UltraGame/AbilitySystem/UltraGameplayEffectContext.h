@@ -64,6 +64,10 @@ public:
 	UPROPERTY()
 	int32 CartridgeID = -1;
 
+	/** True when SetByCaller.ResolvedScore was resolved for this context's target by a batched score application. Server only, NOT replicated */
+	UPROPERTY()
+	bool bScoreResolvedByBatch = false;
+
 protected:
 	/** Ability Source object (should implement IUltraAbilitySourceInterface). NOT replicated currently */
 	UPROPERTY()
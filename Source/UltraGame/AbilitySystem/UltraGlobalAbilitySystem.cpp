@@ -3,9 +3,23 @@
 #include "UltraGlobalAbilitySystem.h"
 
 #include "AbilitySystem/UltraAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "GameplayEffect.h"
+#include "TimerManager.h"
+#include "UltraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraGlobalAbilitySystem)
 
+namespace UltraGlobalAbilitySystem
+{
+	static int32 MaxGrantsPerFrame = 16;
+	static FAutoConsoleVariableRef CVarMaxGrantsPerFrame(
+		TEXT("Ultra.GlobalAbilitySystem.MaxGrantsPerFrame"),
+		MaxGrantsPerFrame,
+		TEXT("Maximum number of global ability/effect grants applied per frame when applying to all registered ASCs (<= 0 applies everything immediately)."),
+		ECVF_Default);
+};
+
 void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability, UUltraAbilitySystemComponent* ASC)
 {
 	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
@@ -19,6 +33,19 @@ void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability,
 	Handles.Add(ASC, AbilitySpecHandle);
 }
 
+void FGlobalAppliedAbilityList::AddSpecToASC(const FGameplayAbilitySpec& AbilitySpec, UUltraAbilitySystemComponent* ASC)
+{
+	if (Handles.Contains(ASC))
+	{
+		RemoveFromASC(ASC);
+	}
+
+	FGameplayAbilitySpec SpecForASC = AbilitySpec;
+	SpecForASC.Handle.GenerateNewHandle();
+	const FGameplayAbilitySpecHandle AbilitySpecHandle = ASC->GiveAbility(SpecForASC);
+	Handles.Add(ASC, AbilitySpecHandle);
+}
+
 void FGlobalAppliedAbilityList::RemoveFromASC(UUltraAbilitySystemComponent* ASC)
 {
 	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
@@ -44,12 +71,16 @@ void FGlobalAppliedAbilityList::RemoveFromAll()
 
 void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, UUltraAbilitySystemComponent* ASC)
 {
-	if (FActiveGameplayEffectHandle* EffectHandle = Handles.Find(ASC))
+	AddToASC(Effect->GetDefaultObject<UGameplayEffect>(), ASC);
+}
+
+void FGlobalAppliedEffectList::AddToASC(const UGameplayEffect* GameplayEffectCDO, UUltraAbilitySystemComponent* ASC)
+{
+	if (Handles.Contains(ASC))
 	{
 		RemoveFromASC(ASC);
 	}
 
-	const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
 	const FActiveGameplayEffectHandle GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
 	Handles.Add(ASC, GameplayEffectHandle);
 }
@@ -83,11 +114,9 @@ void UUltraGlobalAbilitySystem::ApplyAbilityToAll(TSubclassOf<UGameplayAbility>
 {
 	if ((Ability.Get() != nullptr) && (!AppliedAbilities.Contains(Ability)))
 	{
-		FGlobalAppliedAbilityList& Entry = AppliedAbilities.Add(Ability);		
-		for (UUltraAbilitySystemComponent* ASC : RegisteredASCs)
-		{
-			Entry.AddToASC(Ability, ASC);
-		}
+		AppliedAbilities.Add(Ability);
+		LateJoinerBundle.bUpToDate = false;
+		QueueGrantForAll(Ability, nullptr);
 	}
 }
 
@@ -95,11 +124,9 @@ void UUltraGlobalAbilitySystem::ApplyEffectToAll(TSubclassOf<UGameplayEffect> Ef
 {
 	if ((Effect.Get() != nullptr) && (!AppliedEffects.Contains(Effect)))
 	{
-		FGlobalAppliedEffectList& Entry = AppliedEffects.Add(Effect);
-		for (UUltraAbilitySystemComponent* ASC : RegisteredASCs)
-		{
-			Entry.AddToASC(Effect, ASC);
-		}
+		AppliedEffects.Add(Effect);
+		LateJoinerBundle.bUpToDate = false;
+		QueueGrantForAll(nullptr, Effect);
 	}
 }
 
@@ -107,9 +134,12 @@ void UUltraGlobalAbilitySystem::RemoveAbilityFromAll(TSubclassOf<UGameplayAbilit
 {
 	if ((Ability.Get() != nullptr) && AppliedAbilities.Contains(Ability))
 	{
+		PendingGrants.RemoveAll([Ability](const FGlobalPendingGrant& Grant) { return Grant.Ability == Ability; });
+
 		FGlobalAppliedAbilityList& Entry = AppliedAbilities[Ability];
 		Entry.RemoveFromAll();
 		AppliedAbilities.Remove(Ability);
+		LateJoinerBundle.bUpToDate = false;
 	}
 }
 
@@ -117,9 +147,12 @@ void UUltraGlobalAbilitySystem::RemoveEffectFromAll(TSubclassOf<UGameplayEffect>
 {
 	if ((Effect.Get() != nullptr) && AppliedEffects.Contains(Effect))
 	{
+		PendingGrants.RemoveAll([Effect](const FGlobalPendingGrant& Grant) { return Grant.Effect == Effect; });
+
 		FGlobalAppliedEffectList& Entry = AppliedEffects[Effect];
 		Entry.RemoveFromAll();
 		AppliedEffects.Remove(Effect);
+		LateJoinerBundle.bUpToDate = false;
 	}
 }
 
@@ -127,14 +160,9 @@ void UUltraGlobalAbilitySystem::RegisterASC(UUltraAbilitySystemComponent* ASC)
 {
 	check(ASC);
 
-	for (auto& Entry : AppliedAbilities)
-	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
-	}
-	for (auto& Entry : AppliedEffects)
-	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
-	}
+	// Late joiners get everything that is currently active in one go, rather than trickling in with the time-sliced grants
+	PendingGrants.RemoveAll([ASC](const FGlobalPendingGrant& Grant) { return Grant.ASC == ASC; });
+	ApplyGlobalBundleToASC(ASC);
 
 	RegisteredASCs.AddUnique(ASC);
 }
@@ -142,6 +170,9 @@ void UUltraGlobalAbilitySystem::RegisterASC(UUltraAbilitySystemComponent* ASC)
 void UUltraGlobalAbilitySystem::UnregisterASC(UUltraAbilitySystemComponent* ASC)
 {
 	check(ASC);
+
+	PendingGrants.RemoveAll([ASC](const FGlobalPendingGrant& Grant) { return Grant.ASC == ASC; });
+
 	for (auto& Entry : AppliedAbilities)
 	{
 		Entry.Value.RemoveFromASC(ASC);
@@ -154,3 +185,127 @@ void UUltraGlobalAbilitySystem::UnregisterASC(UUltraAbilitySystemComponent* ASC)
 	RegisteredASCs.Remove(ASC);
 }
 
+void UUltraGlobalAbilitySystem::QueueGrantForAll(TSubclassOf<UGameplayAbility> Ability, TSubclassOf<UGameplayEffect> Effect)
+{
+	PendingGrants.Reserve(PendingGrants.Num() + RegisteredASCs.Num());
+	for (UUltraAbilitySystemComponent* ASC : RegisteredASCs)
+	{
+		FGlobalPendingGrant& Grant = PendingGrants.AddDefaulted_GetRef();
+		Grant.ASC = ASC;
+		Grant.Ability = Ability;
+		Grant.Effect = Effect;
+	}
+
+	if (UltraGlobalAbilitySystem::MaxGrantsPerFrame <= 0)
+	{
+		ProcessPendingGrants();
+	}
+	else
+	{
+		SchedulePendingGrants();
+	}
+}
+
+void UUltraGlobalAbilitySystem::SchedulePendingGrants()
+{
+	if (!bPendingGrantsScheduled && (PendingGrants.Num() > 0))
+	{
+		if (UWorld* World = GetWorld())
+		{
+			bPendingGrantsScheduled = true;
+			World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::ProcessPendingGrants));
+		}
+	}
+}
+
+void UUltraGlobalAbilitySystem::ProcessPendingGrants()
+{
+	bPendingGrantsScheduled = false;
+
+	const int32 Budget = (UltraGlobalAbilitySystem::MaxGrantsPerFrame > 0) ? UltraGlobalAbilitySystem::MaxGrantsPerFrame : PendingGrants.Num();
+	const int32 NumToProcess = FMath::Min(Budget, PendingGrants.Num());
+
+	// Copy the slice out first, applying a grant can cause other grants to be queued or removed
+	TArray<FGlobalPendingGrant> GrantsThisFrame(PendingGrants.GetData(), NumToProcess);
+	PendingGrants.RemoveAt(0, NumToProcess, /*bAllowShrinking=*/ false);
+
+	for (const FGlobalPendingGrant& Grant : GrantsThisFrame)
+	{
+		UUltraAbilitySystemComponent* ASC = Grant.ASC.Get();
+		if (ASC == nullptr)
+		{
+			continue;
+		}
+
+		if (Grant.Ability)
+		{
+			if (FGlobalAppliedAbilityList* Entry = AppliedAbilities.Find(Grant.Ability))
+			{
+				Entry->AddToASC(Grant.Ability, ASC);
+			}
+		}
+		else if (Grant.Effect)
+		{
+			if (FGlobalAppliedEffectList* Entry = AppliedEffects.Find(Grant.Effect))
+			{
+				Entry->AddToASC(Grant.Effect, ASC);
+			}
+		}
+	}
+
+	UE_LOG(LogUltraAbilitySystem, Verbose, TEXT("UUltraGlobalAbilitySystem applied %d global grants (%d still pending)"), GrantsThisFrame.Num(), PendingGrants.Num());
+
+	SchedulePendingGrants();
+}
+
+void UUltraGlobalAbilitySystem::UpdateLateJoinerBundle()
+{
+	if (LateJoinerBundle.bUpToDate)
+	{
+		return;
+	}
+
+	LateJoinerBundle.AbilitySpecs.Reset(AppliedAbilities.Num());
+	for (const auto& Entry : AppliedAbilities)
+	{
+		LateJoinerBundle.AbilitySpecs.Emplace(Entry.Key, FGameplayAbilitySpec(Entry.Key->GetDefaultObject<UGameplayAbility>()));
+	}
+
+	LateJoinerBundle.Effects.Reset(AppliedEffects.Num());
+	for (const auto& Entry : AppliedEffects)
+	{
+		LateJoinerBundle.Effects.Emplace(Entry.Key, Entry.Key->GetDefaultObject<UGameplayEffect>());
+	}
+
+	LateJoinerBundle.bUpToDate = true;
+}
+
+void UUltraGlobalAbilitySystem::ApplyGlobalBundleToASC(UUltraAbilitySystemComponent* ASC)
+{
+	if (AppliedAbilities.IsEmpty() && AppliedEffects.IsEmpty())
+	{
+		return;
+	}
+
+	UpdateLateJoinerBundle();
+
+	{
+		// New specs are added to the ability list in one batch when the lock is released
+		FScopedAbilityListLock ActiveScopeLock(*ASC);
+
+		for (const auto& AbilitySpec : LateJoinerBundle.AbilitySpecs)
+		{
+			AppliedAbilities.FindChecked(AbilitySpec.Key).AddSpecToASC(AbilitySpec.Value, ASC);
+		}
+	}
+
+	{
+		// Likewise, new effects are moved into the active effect list in one batch when the lock is released
+		FScopedActiveGameplayEffectLock ActiveEffectScopeLock(ASC->ActiveGameplayEffects);
+
+		for (const auto& Effect : LateJoinerBundle.Effects)
+		{
+			AppliedEffects.FindChecked(Effect.Key).AddToASC(Effect.Value, ASC);
+		}
+	}
+}
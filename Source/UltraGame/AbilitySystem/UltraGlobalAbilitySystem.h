@@ -4,6 +4,7 @@
 
 #include "ActiveGameplayEffectHandle.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "GameplayAbilitySpec.h"
 #include "GameplayAbilitySpecHandle.h"
 #include "Templates/SubclassOf.h"
 
@@ -26,6 +27,7 @@ struct FGlobalAppliedAbilityList
 	TMap<TObjectPtr<UUltraAbilitySystemComponent>, FGameplayAbilitySpecHandle> Handles;
 
 	void AddToASC(TSubclassOf<UGameplayAbility> Ability, UUltraAbilitySystemComponent* ASC);
+	void AddSpecToASC(const FGameplayAbilitySpec& AbilitySpec, UUltraAbilitySystemComponent* ASC);
 	void RemoveFromASC(UUltraAbilitySystemComponent* ASC);
 	void RemoveFromAll();
 };
@@ -39,10 +41,27 @@ struct FGlobalAppliedEffectList
 	TMap<TObjectPtr<UUltraAbilitySystemComponent>, FActiveGameplayEffectHandle> Handles;
 
 	void AddToASC(TSubclassOf<UGameplayEffect> Effect, UUltraAbilitySystemComponent* ASC);
+	void AddToASC(const UGameplayEffect* GameplayEffectCDO, UUltraAbilitySystemComponent* ASC);
 	void RemoveFromASC(UUltraAbilitySystemComponent* ASC);
 	void RemoveFromAll();
 };
 
+// A global ability or effect that still has to be applied to a registered ASC
+USTRUCT()
+struct FGlobalPendingGrant
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UUltraAbilitySystemComponent> ASC;
+
+	UPROPERTY()
+	TSubclassOf<UGameplayAbility> Ability;
+
+	UPROPERTY()
+	TSubclassOf<UGameplayEffect> Effect;
+};
+
 UCLASS()
 class UUltraGlobalAbilitySystem : public UWorldSubsystem
 {
@@ -69,6 +88,21 @@ public:
 	/** Removes an ASC from the global system, along with any active global effects/abilities. */
 	void UnregisterASC(UUltraAbilitySystemComponent* ASC);
 
+private:
+	// Queues the ability or effect for every registered ASC; the grants are applied over several frames
+	void QueueGrantForAll(TSubclassOf<UGameplayAbility> Ability, TSubclassOf<UGameplayEffect> Effect);
+
+	// Applies up to the per-frame budget of pending grants, rescheduling itself if more remain
+	void ProcessPendingGrants();
+
+	// Applies every active global ability and effect to the ASC in one pass, using the late joiner bundle
+	void ApplyGlobalBundleToASC(UUltraAbilitySystemComponent* ASC);
+
+	// Rebuilds the late joiner bundle if the global abilities or effects changed since it was last built
+	void UpdateLateJoinerBundle();
+
+	void SchedulePendingGrants();
+
 private:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayAbility>, FGlobalAppliedAbilityList> AppliedAbilities;
@@ -78,4 +112,22 @@ private:
 
 	UPROPERTY()
 	TArray<TObjectPtr<UUltraAbilitySystemComponent>> RegisteredASCs;
+
+	// Grants that have been requested but not yet applied, in the order they will be applied
+	UPROPERTY()
+	TArray<FGlobalPendingGrant> PendingGrants;
+
+	bool bPendingGrantsScheduled = false;
+
+	// Everything a late joiner is granted, resolved once whenever the set of global abilities and effects changes
+	// rather than for every ASC that registers. The classes are kept alive by AppliedAbilities and AppliedEffects.
+	struct FLateJoinerBundle
+	{
+		// One spec per global ability, copied with a fresh handle for each ASC
+		TArray<TPair<TSubclassOf<UGameplayAbility>, FGameplayAbilitySpec>> AbilitySpecs;
+		TArray<TPair<TSubclassOf<UGameplayEffect>, const UGameplayEffect*>> Effects;
+		bool bUpToDate = false;
+	};
+
+	FLateJoinerBundle LateJoinerBundle;
 };
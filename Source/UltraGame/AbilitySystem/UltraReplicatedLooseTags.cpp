@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UltraReplicatedLooseTags.h"
+
+#include "AbilitySystemComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraReplicatedLooseTags)
+
+//////////////////////////////////////////////////////////////////////
+// FUltraReplicatedLooseTag
+
+FString FUltraReplicatedLooseTag::GetDebugString() const
+{
+	return FString::Printf(TEXT("%sx%d"), *Tag.ToString(), Count);
+}
+
+//////////////////////////////////////////////////////////////////////
+// FUltraReplicatedLooseTagContainer
+
+void FUltraReplicatedLooseTagContainer::AddTag(FGameplayTag Tag, int32 Count)
+{
+	if (!Tag.IsValid() || (Count <= 0))
+	{
+		return;
+	}
+
+	if (const int32* ExistingIndex = TagToIndex.Find(Tag))
+	{
+		SetCountAtIndex(*ExistingIndex, Tags[*ExistingIndex].Count + Count);
+		return;
+	}
+
+	const int32 NewIndex = Tags.Emplace(Tag, Count);
+	TagToIndex.Add(Tag, NewIndex);
+	MarkItemDirty(Tags[NewIndex]);
+
+	if (Owner)
+	{
+		Owner->AddLooseGameplayTag(Tag, Count);
+	}
+}
+
+void FUltraReplicatedLooseTagContainer::RemoveTag(FGameplayTag Tag, int32 Count)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	if (const int32* ExistingIndex = TagToIndex.Find(Tag))
+	{
+		SetCountAtIndex(*ExistingIndex, Tags[*ExistingIndex].Count - Count);
+	}
+}
+
+void FUltraReplicatedLooseTagContainer::RemoveAllOfTag(FGameplayTag Tag)
+{
+	if (const int32* ExistingIndex = TagToIndex.Find(Tag))
+	{
+		SetCountAtIndex(*ExistingIndex, 0);
+	}
+}
+
+int32 FUltraReplicatedLooseTagContainer::GetTagCount(FGameplayTag Tag) const
+{
+	const int32* ExistingIndex = TagToIndex.Find(Tag);
+	return ExistingIndex ? Tags[*ExistingIndex].Count : 0;
+}
+
+void FUltraReplicatedLooseTagContainer::SetCountAtIndex(int32 Index, int32 NewCount)
+{
+	FUltraReplicatedLooseTag& Entry = Tags[Index];
+	const FGameplayTag Tag = Entry.Tag;
+	const int32 OldCount = Entry.Count;
+	NewCount = FMath::Max(NewCount, 0);
+
+	if (NewCount == OldCount)
+	{
+		return;
+	}
+
+	if (NewCount > 0)
+	{
+		Entry.Count = NewCount;
+		MarkItemDirty(Entry);
+	}
+	else
+	{
+		// Swap the last entry into the hole so removal doesn't shift the array, then fix up its index
+		TagToIndex.Remove(Tag);
+		Tags.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/ false);
+		if (Tags.IsValidIndex(Index))
+		{
+			TagToIndex[Tags[Index].Tag] = Index;
+		}
+		MarkArrayDirty();
+	}
+
+	if (Owner)
+	{
+		if (NewCount > OldCount)
+		{
+			Owner->AddLooseGameplayTag(Tag, NewCount - OldCount);
+		}
+		else
+		{
+			Owner->RemoveLooseGameplayTag(Tag, OldCount - NewCount);
+		}
+	}
+}
+
+void FUltraReplicatedLooseTagContainer::ApplyReplicatedCount(FUltraReplicatedLooseTag& Entry, int32 NewCount)
+{
+	const int32 Delta = NewCount - Entry.AppliedCount;
+	Entry.AppliedCount = NewCount;
+
+	if ((Owner == nullptr) || (Delta == 0))
+	{
+		return;
+	}
+
+	if (Delta > 0)
+	{
+		Owner->AddLooseGameplayTag(Entry.Tag, Delta);
+	}
+	else
+	{
+		Owner->RemoveLooseGameplayTag(Entry.Tag, -Delta);
+	}
+}
+
+void FUltraReplicatedLooseTagContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	for (int32 Index : RemovedIndices)
+	{
+		ApplyReplicatedCount(Tags[Index], 0);
+	}
+}
+
+void FUltraReplicatedLooseTagContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	for (int32 Index : AddedIndices)
+	{
+		FUltraReplicatedLooseTag& Entry = Tags[Index];
+		ApplyReplicatedCount(Entry, Entry.Count);
+	}
+}
+
+void FUltraReplicatedLooseTagContainer::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	for (int32 Index : ChangedIndices)
+	{
+		FUltraReplicatedLooseTag& Entry = Tags[Index];
+		ApplyReplicatedCount(Entry, Entry.Count);
+	}
+}
@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Net/Serialization/FastArraySerializer.h"
+
+#include "UltraReplicatedLooseTags.generated.h"
+
+class UAbilitySystemComponent;
+struct FNetDeltaSerializeInfo;
+struct FUltraReplicatedLooseTagContainer;
+
+/**
+ * One replicated loose tag (tag + count)
+ */
+USTRUCT()
+struct FUltraReplicatedLooseTag : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	FUltraReplicatedLooseTag()
+	{}
+
+	FUltraReplicatedLooseTag(FGameplayTag InTag, int32 InCount)
+		: Tag(InTag)
+		, Count(InCount)
+	{
+	}
+
+	FString GetDebugString() const;
+
+private:
+	friend FUltraReplicatedLooseTagContainer;
+
+	UPROPERTY()
+	FGameplayTag Tag;
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	// Count that has been applied to the owner's tag map on this machine (clients only)
+	UPROPERTY(NotReplicated)
+	int32 AppliedCount = 0;
+};
+
+/**
+ * Replicated tag counts that are pushed into the owning ability system component as loose tags.
+ *
+ * This replaces applying a gameplay effect per dynamic tag: changing a count is a map lookup plus one dirty item,
+ * and clients only receive the items that changed. The counts go through AddLooseGameplayTag / RemoveLooseGameplayTag
+ * on both server and clients, so owned tag queries and tag change events behave exactly like effect-granted tags.
+ */
+USTRUCT()
+struct FUltraReplicatedLooseTagContainer : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	FUltraReplicatedLooseTagContainer()
+	{
+	}
+
+public:
+	void SetOwner(UAbilitySystemComponent* InOwner) { Owner = InOwner; }
+
+	// Adds Count to the tag (server only, does nothing if Count is below 1)
+	void AddTag(FGameplayTag Tag, int32 Count = 1);
+
+	// Removes Count from the tag, removing the entry when it reaches zero (server only, does nothing if Count is below 1)
+	void RemoveTag(FGameplayTag Tag, int32 Count = 1);
+
+	// Removes every count of the tag (server only)
+	void RemoveAllOfTag(FGameplayTag Tag);
+
+	// Returns the replicated count of the tag (server only, or 0 if the tag is not present)
+	int32 GetTagCount(FGameplayTag Tag) const;
+
+	int32 Num() const { return Tags.Num(); }
+
+	//~FFastArraySerializer contract
+	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	//~End of FFastArraySerializer contract
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FUltraReplicatedLooseTag, FUltraReplicatedLooseTagContainer>(Tags, DeltaParms, *this);
+	}
+
+private:
+	void SetCountAtIndex(int32 Index, int32 NewCount);
+	void ApplyReplicatedCount(FUltraReplicatedLooseTag& Entry, int32 NewCount);
+
+private:
+	// Replicated list of tag counts
+	UPROPERTY()
+	TArray<FUltraReplicatedLooseTag> Tags;
+
+	// Server side index of each tag in Tags, kept in sync when entries are swapped out
+	TMap<FGameplayTag, int32> TagToIndex;
+
+	UAbilitySystemComponent* Owner = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FUltraReplicatedLooseTagContainer> : public TStructOpsTypeTraitsBase2<FUltraReplicatedLooseTagContainer>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -3,7 +3,6 @@
 #include "UltraAnimInstance.h"
 #include "AbilitySystemGlobals.h"
 #include "Character/UltraCharacter.h"
-#include "Character/UltraCharacterMovementComponent.h"
 
 #if WITH_EDITOR
 #include "Misc/DataValidation.h"
@@ -46,20 +45,21 @@ void UUltraAnimInstance::NativeInitializeAnimation()
 			InitializeWithAbilitySystem(ASC);
 		}
 	}
+
+	const AUltraCharacter* Character = Cast<AUltraCharacter>(GetOwningActor());
+	MovementComponent = Character ? Cast<UUltraCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr;
 }
 
-void UUltraAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+void UUltraAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
 {
-	Super::NativeUpdateAnimation(DeltaSeconds);
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
-	const AUltraCharacter* Character = Cast<AUltraCharacter>(GetOwningActor());
-	if (!Character)
+	// The movement component publishes its snapshot before the mesh ticks, so this only reads plain data.
+	// Tag driven properties are pushed by GameplayTagPropertyMap from tag change events and need no work here.
+	if (MovementComponent)
 	{
-		return;
+		MovementSnapshot = MovementComponent->GetMovementSnapshot();
+		GroundDistance = MovementSnapshot.GroundDistance;
 	}
-
-	UUltraCharacterMovementComponent* CharMoveComp = CastChecked<UUltraCharacterMovementComponent>(Character->GetCharacterMovement());
-	const FUltraCharacterGroundInfo& GroundInfo = CharMoveComp->GetGroundInfo();
-	GroundDistance = GroundInfo.GroundDistance;
 }
 
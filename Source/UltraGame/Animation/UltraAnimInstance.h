@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Animation/AnimInstance.h"
+#include "Character/UltraCharacterMovementComponent.h"
 #include "GameplayEffectTypes.h"
 #include "UltraAnimInstance.generated.h"
 
@@ -32,7 +33,7 @@ protected:
 #endif // WITH_EDITOR
 
 	virtual void NativeInitializeAnimation() override;
-	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 protected:
 
@@ -43,4 +44,14 @@ protected:
 
 	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
 	float GroundDistance = -1.0f;
+
+	// Movement state copied from the owning character's movement component each update
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	FUltraCharacterMovementSnapshot MovementSnapshot;
+
+private:
+
+	// Cached on the game thread during initialization so the worker thread update never has to cast the owner
+	UPROPERTY(Transient)
+	TObjectPtr<const UUltraCharacterMovementComponent> MovementComponent;
 };
@@ -98,6 +98,12 @@ void UUltraCameraComponent::UpdateCameraModes()
 	}
 }
 
+void UUltraCameraComponent::PrewarmCameraModes(TConstArrayView<TSubclassOf<UUltraCameraMode>> CameraModeClasses)
+{
+	check(CameraModeStack);
+	CameraModeStack->PrewarmCameraModes(CameraModeClasses);
+}
+
 void UUltraCameraComponent::DrawDebug(UCanvas* Canvas) const
 {
 	check(Canvas);
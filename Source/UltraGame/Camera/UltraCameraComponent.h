@@ -43,6 +43,9 @@ public:
 	// Delegate used to query for the best camera mode.
 	FUltraCameraModeDelegate DetermineCameraModeDelegate;
 
+	// Creates the camera mode instances up front so pushing them later doesn't allocate.
+	void PrewarmCameraModes(TConstArrayView<TSubclassOf<UUltraCameraMode>> CameraModeClasses);
+
 	// Add an offset to the field of view.  The offset is only for one frame, it gets cleared once it is applied.
 	void AddFieldOfViewOffset(float FovOffset) { FieldOfViewOffset += FovOffset; }
 
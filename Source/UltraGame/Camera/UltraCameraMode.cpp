@@ -10,6 +10,10 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraCameraMode)
 
+DECLARE_CYCLE_STAT(TEXT("Evaluate Camera Mode Stack"), STAT_UltraCamera_EvaluateStack, STATGROUP_UltraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Modes On Stack"), STAT_UltraCamera_ModesOnStack, STATGROUP_UltraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Modes Created"), STAT_UltraCamera_ModesCreated, STATGROUP_UltraCamera);
+
 
 //////////////////////////////////////////////////////////////////////////
 // FUltraCameraModeView
@@ -238,8 +242,9 @@ void UUltraCameraModeStack::ActivateStack()
 		bIsActive = true;
 
 		// Notify camera modes that they are being activated.
-		for (UUltraCameraMode* CameraMode : CameraModeStack)
+		for (int32 StackIndex = 0; StackIndex < StackDepth; ++StackIndex)
 		{
+			UUltraCameraMode* CameraMode = GetStackEntry(StackIndex);
 			check(CameraMode);
 			CameraMode->OnActivation();
 		}
@@ -253,8 +258,9 @@ void UUltraCameraModeStack::DeactivateStack()
 		bIsActive = false;
 
 		// Notify camera modes that they are being deactivated.
-		for (UUltraCameraMode* CameraMode : CameraModeStack)
+		for (int32 StackIndex = 0; StackIndex < StackDepth; ++StackIndex)
 		{
+			UUltraCameraMode* CameraMode = GetStackEntry(StackIndex);
 			check(CameraMode);
 			CameraMode->OnDeactivation();
 		}
@@ -271,9 +277,7 @@ void UUltraCameraModeStack::PushCameraMode(TSubclassOf<UUltraCameraMode> CameraM
 	UUltraCameraMode* CameraMode = GetCameraModeInstance(CameraModeClass);
 	check(CameraMode);
 
-	int32 StackSize = CameraModeStack.Num();
-
-	if ((StackSize > 0) && (CameraModeStack[0] == CameraMode))
+	if ((StackDepth > 0) && (GetStackEntry(0) == CameraMode))
 	{
 		// Already top of stack.
 		return;
@@ -284,9 +288,10 @@ void UUltraCameraModeStack::PushCameraMode(TSubclassOf<UUltraCameraMode> CameraM
 	int32 ExistingStackIndex = INDEX_NONE;
 	float ExistingStackContribution = 1.0f;
 
-	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	for (int32 StackIndex = 0; StackIndex < StackDepth; ++StackIndex)
 	{
-		if (CameraModeStack[StackIndex] == CameraMode)
+		UUltraCameraMode* StackMode = GetStackEntry(StackIndex);
+		if (StackMode == CameraMode)
 		{
 			ExistingStackIndex = StackIndex;
 			ExistingStackContribution *= CameraMode->GetBlendWeight();
@@ -294,31 +299,48 @@ void UUltraCameraModeStack::PushCameraMode(TSubclassOf<UUltraCameraMode> CameraM
 		}
 		else
 		{
-			ExistingStackContribution *= (1.0f - CameraModeStack[StackIndex]->GetBlendWeight());
+			ExistingStackContribution *= (1.0f - StackMode->GetBlendWeight());
 		}
 	}
 
 	if (ExistingStackIndex != INDEX_NONE)
 	{
-		CameraModeStack.RemoveAt(ExistingStackIndex);
-		StackSize--;
+		// Close the gap by moving the entries above it down one, then drop the old top slot.
+		for (int32 StackIndex = ExistingStackIndex; StackIndex > 0; --StackIndex)
+		{
+			CameraModeStack[GetRingIndex(StackIndex)] = CameraModeStack[GetRingIndex(StackIndex - 1)];
+		}
+		CameraModeStack[StackTop] = nullptr;
+		StackTop = GetRingIndex(1);
+		--StackDepth;
 	}
 	else
 	{
 		ExistingStackContribution = 0.0f;
 	}
 
+	if (StackDepth == MaxStackDepth)
+	{
+		// Out of room, the bottom mode has the least influence on the result.
+		const int32 BottomRingIndex = GetRingIndex(StackDepth - 1);
+		CameraModeStack[BottomRingIndex]->OnDeactivation();
+		CameraModeStack[BottomRingIndex] = nullptr;
+		--StackDepth;
+	}
+
 	// Decide what initial weight to start with.
-	const bool bShouldBlend = ((CameraMode->GetBlendTime() > 0.0f) && (StackSize > 0));
+	const bool bShouldBlend = ((CameraMode->GetBlendTime() > 0.0f) && (StackDepth > 0));
 	const float BlendWeight = (bShouldBlend ? ExistingStackContribution : 1.0f);
 
 	CameraMode->SetBlendWeight(BlendWeight);
 
 	// Add new entry to top of stack.
-	CameraModeStack.Insert(CameraMode, 0);
+	StackTop = GetRingIndex(MaxStackDepth - 1);
+	CameraModeStack[StackTop] = CameraMode;
+	++StackDepth;
 
 	// Make sure stack bottom is always weighted 100%.
-	CameraModeStack.Last()->SetBlendWeight(1.0f);
+	GetStackEntry(StackDepth - 1)->SetBlendWeight(1.0f);
 
 	// Let the camera mode know if it's being added to the stack.
 	if (ExistingStackIndex == INDEX_NONE)
@@ -327,6 +349,17 @@ void UUltraCameraModeStack::PushCameraMode(TSubclassOf<UUltraCameraMode> CameraM
 	}
 }
 
+void UUltraCameraModeStack::PrewarmCameraModes(TConstArrayView<TSubclassOf<UUltraCameraMode>> CameraModeClasses)
+{
+	for (const TSubclassOf<UUltraCameraMode>& CameraModeClass : CameraModeClasses)
+	{
+		if (CameraModeClass)
+		{
+			GetCameraModeInstance(CameraModeClass);
+		}
+	}
+}
+
 bool UUltraCameraModeStack::EvaluateStack(float DeltaTime, FUltraCameraModeView& OutCameraModeView)
 {
 	if (!bIsActive)
@@ -334,6 +367,9 @@ bool UUltraCameraModeStack::EvaluateStack(float DeltaTime, FUltraCameraModeView&
 		return false;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_UltraCamera_EvaluateStack);
+	INC_DWORD_STAT_BY(STAT_UltraCamera_ModesOnStack, StackDepth);
+
 	UpdateStack(DeltaTime);
 	BlendStack(OutCameraModeView);
 
@@ -345,37 +381,33 @@ UUltraCameraMode* UUltraCameraModeStack::GetCameraModeInstance(TSubclassOf<UUltr
 	check(CameraModeClass);
 
 	// First see if we already created one.
-	for (UUltraCameraMode* CameraMode : CameraModeInstances)
+	if (UUltraCameraMode* const* ExistingCameraMode = CameraModeInstances.Find(CameraModeClass))
 	{
-		if ((CameraMode != nullptr) && (CameraMode->GetClass() == CameraModeClass))
-		{
-			return CameraMode;
-		}
+		return *ExistingCameraMode;
 	}
 
 	// Not found, so we need to create it.
 	UUltraCameraMode* NewCameraMode = NewObject<UUltraCameraMode>(GetOuter(), CameraModeClass, NAME_None, RF_NoFlags);
 	check(NewCameraMode);
+	INC_DWORD_STAT(STAT_UltraCamera_ModesCreated);
 
-	CameraModeInstances.Add(NewCameraMode);
+	CameraModeInstances.Add(CameraModeClass, NewCameraMode);
 
 	return NewCameraMode;
 }
 
 void UUltraCameraModeStack::UpdateStack(float DeltaTime)
 {
-	const int32 StackSize = CameraModeStack.Num();
-	if (StackSize <= 0)
+	if (StackDepth <= 0)
 	{
 		return;
 	}
 
-	int32 RemoveCount = 0;
 	int32 RemoveIndex = INDEX_NONE;
 
-	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	for (int32 StackIndex = 0; StackIndex < StackDepth; ++StackIndex)
 	{
-		UUltraCameraMode* CameraMode = CameraModeStack[StackIndex];
+		UUltraCameraMode* CameraMode = GetStackEntry(StackIndex);
 		check(CameraMode);
 
 		CameraMode->UpdateCameraMode(DeltaTime);
@@ -384,43 +416,43 @@ void UUltraCameraModeStack::UpdateStack(float DeltaTime)
 		{
 			// Everything below this mode is now irrelevant and can be removed.
 			RemoveIndex = (StackIndex + 1);
-			RemoveCount = (StackSize - RemoveIndex);
 			break;
 		}
 	}
 
-	if (RemoveCount > 0)
+	if ((RemoveIndex != INDEX_NONE) && (RemoveIndex < StackDepth))
 	{
 		// Let the camera modes know they being removed from the stack.
-		for (int32 StackIndex = RemoveIndex; StackIndex < StackSize; ++StackIndex)
+		for (int32 StackIndex = RemoveIndex; StackIndex < StackDepth; ++StackIndex)
 		{
-			UUltraCameraMode* CameraMode = CameraModeStack[StackIndex];
-			check(CameraMode);
+			const int32 RingIndex = GetRingIndex(StackIndex);
+			check(CameraModeStack[RingIndex]);
 
-			CameraMode->OnDeactivation();
+			CameraModeStack[RingIndex]->OnDeactivation();
+			CameraModeStack[RingIndex] = nullptr;
 		}
 
-		CameraModeStack.RemoveAt(RemoveIndex, RemoveCount);
+		// They are all at the bottom, so this is just a shorter stack
+		StackDepth = RemoveIndex;
 	}
 }
 
 void UUltraCameraModeStack::BlendStack(FUltraCameraModeView& OutCameraModeView) const
 {
-	const int32 StackSize = CameraModeStack.Num();
-	if (StackSize <= 0)
+	if (StackDepth <= 0)
 	{
 		return;
 	}
 
 	// Start at the bottom and blend up the stack
-	const UUltraCameraMode* CameraMode = CameraModeStack[StackSize - 1];
+	const UUltraCameraMode* CameraMode = GetStackEntry(StackDepth - 1);
 	check(CameraMode);
 
 	OutCameraModeView = CameraMode->GetCameraModeView();
 
-	for (int32 StackIndex = (StackSize - 2); StackIndex >= 0; --StackIndex)
+	for (int32 StackIndex = (StackDepth - 2); StackIndex >= 0; --StackIndex)
 	{
-		CameraMode = CameraModeStack[StackIndex];
+		CameraMode = GetStackEntry(StackIndex);
 		check(CameraMode);
 
 		OutCameraModeView.Blend(CameraMode->GetCameraModeView(), CameraMode->GetBlendWeight());
@@ -436,8 +468,9 @@ void UUltraCameraModeStack::DrawDebug(UCanvas* Canvas) const
 	DisplayDebugManager.SetDrawColor(FColor::Green);
 	DisplayDebugManager.DrawString(FString(TEXT("   --- Camera Modes (Begin) ---")));
 
-	for (const UUltraCameraMode* CameraMode : CameraModeStack)
+	for (int32 StackIndex = 0; StackIndex < StackDepth; ++StackIndex)
 	{
+		const UUltraCameraMode* CameraMode = GetStackEntry(StackIndex);
 		check(CameraMode);
 		CameraMode->DrawDebug(Canvas);
 	}
@@ -448,7 +481,7 @@ void UUltraCameraModeStack::DrawDebug(UCanvas* Canvas) const
 
 void UUltraCameraModeStack::GetBlendInfo(float& OutWeightOfTopLayer, FGameplayTag& OutTagOfTopLayer) const
 {
-	if (CameraModeStack.Num() == 0)
+	if (StackDepth == 0)
 	{
 		OutWeightOfTopLayer = 1.0f;
 		OutTagOfTopLayer = FGameplayTag();
@@ -456,10 +489,9 @@ void UUltraCameraModeStack::GetBlendInfo(float& OutWeightOfTopLayer, FGameplayTa
 	}
 	else
 	{
-		UUltraCameraMode* TopEntry = CameraModeStack.Last();
+		UUltraCameraMode* TopEntry = GetStackEntry(StackDepth - 1);
 		check(TopEntry);
 		OutWeightOfTopLayer = TopEntry->GetBlendWeight();
 		OutTagOfTopLayer = TopEntry->GetCameraTypeTag();
 	}
 }
-
@@ -11,6 +11,8 @@ class AActor;
 class UCanvas;
 class UUltraCameraComponent;
 
+DECLARE_STATS_GROUP(TEXT("UltraCamera"), STATGROUP_UltraCamera, STATCAT_Advanced);
+
 /**
  * EUltraCameraModeBlendFunction
  *
@@ -156,6 +158,7 @@ protected:
  * UUltraCameraModeStack
  *
  *	Stack used for blending camera modes.
+ *	Entries live in a fixed-size ring so pushing and dropping finished modes never moves or allocates memory.
  */
 UCLASS()
 class UUltraCameraModeStack : public UObject
@@ -173,6 +176,9 @@ public:
 
 	void PushCameraMode(TSubclassOf<UUltraCameraMode> CameraModeClass);
 
+	// Creates instances of these camera modes ahead of time so the first push doesn't have to.
+	void PrewarmCameraModes(TConstArrayView<TSubclassOf<UUltraCameraMode>> CameraModeClasses);
+
 	bool EvaluateStack(float DeltaTime, FUltraCameraModeView& OutCameraModeView);
 
 	void DrawDebug(UCanvas* Canvas) const;
@@ -187,13 +193,24 @@ protected:
 	void UpdateStack(float DeltaTime);
 	void BlendStack(FUltraCameraModeView& OutCameraModeView) const;
 
+	// Index 0 is the top of the stack.
+	int32 GetRingIndex(int32 StackIndex) const { return (StackTop + StackIndex) % MaxStackDepth; }
+	UUltraCameraMode* GetStackEntry(int32 StackIndex) const { return CameraModeStack[GetRingIndex(StackIndex)]; }
+
 protected:
 
+	// Modes blending below this many others are dropped, which is only reached if modes are pushed faster than they blend in.
+	static constexpr int32 MaxStackDepth = 8;
+
 	bool bIsActive;
 
 	UPROPERTY()
-	TArray<TObjectPtr<UUltraCameraMode>> CameraModeInstances;
+	TMap<TSubclassOf<UUltraCameraMode>, TObjectPtr<UUltraCameraMode>> CameraModeInstances;
 
 	UPROPERTY()
-	TArray<TObjectPtr<UUltraCameraMode>> CameraModeStack;
+	TObjectPtr<UUltraCameraMode> CameraModeStack[MaxStackDepth];
+
+	// Ring index of the top of the stack and number of entries in it.
+	int32 StackTop = 0;
+	int32 StackDepth = 0;
 };
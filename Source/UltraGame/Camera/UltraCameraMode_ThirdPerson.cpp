@@ -11,12 +11,40 @@
 #include "GameFramework/Controller.h"
 #include "GameFramework/Character.h"
 #include "Math/RotationMatrix.h"
+#include "Performance/UltraPerformanceSettings.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraCameraMode_ThirdPerson)
 
+DECLARE_CYCLE_STAT(TEXT("Prevent Penetration"), STAT_UltraCamera_PreventPenetration, STATGROUP_UltraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Penetration Updates"), STAT_UltraCamera_PenetrationUpdates, STATGROUP_UltraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feeler Sweeps (Sync)"), STAT_UltraCamera_SyncFeelerSweeps, STATGROUP_UltraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feeler Sweeps (Async)"), STAT_UltraCamera_AsyncFeelerSweeps, STATGROUP_UltraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feeler Updates Skipped"), STAT_UltraCamera_SkippedFeelerUpdates, STATGROUP_UltraCamera);
+
 namespace UltraCameraMode_ThirdPerson_Statics
 {
 	static const FName NAME_IgnoreCameraCollision = TEXT("IgnoreCameraCollision");
+
+	static bool bAsyncPenetrationFeelers = true;
+	static FAutoConsoleVariableRef CVarAsyncPenetrationFeelers(
+		TEXT("Ultra.Camera.AsyncPenetrationFeelers"),
+		bAsyncPenetrationFeelers,
+		TEXT("If true, the predictive penetration feelers are swept asynchronously and their results used on the next update. The main ray is always swept immediately."),
+		ECVF_Default);
+
+	static float PenetrationMoveThreshold = 0.5f;
+	static FAutoConsoleVariableRef CVarPenetrationMoveThreshold(
+		TEXT("Ultra.Camera.PenetrationMoveThreshold"),
+		PenetrationMoveThreshold,
+		TEXT("Feelers are not traced while nothing blocks the camera and neither the safe location nor the desired camera location moved more than this (cm) since the last trace."),
+		ECVF_Default);
+
+	static int32 PenetrationMaxSkippedUpdates = 10;
+	static FAutoConsoleVariableRef CVarPenetrationMaxSkippedUpdates(
+		TEXT("Ultra.Camera.PenetrationMaxSkippedUpdates"),
+		PenetrationMaxSkippedUpdates,
+		TEXT("Feelers are traced at least this often while the camera is stationary, to catch things moving into the way."),
+		ECVF_Default);
 }
 
 UUltraCameraMode_ThirdPerson::UUltraCameraMode_ThirdPerson()
@@ -172,6 +200,11 @@ void UUltraCameraMode_ThirdPerson::UpdatePreventPenetration(float DeltaTime)
 
 void UUltraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly)
 {
+	using namespace UltraCameraMode_ThirdPerson_Statics;
+
+	SCOPE_CYCLE_COUNTER(STAT_UltraCamera_PreventPenetration);
+	INC_DWORD_STAT(STAT_UltraCamera_PenetrationUpdates);
+
 #if ENABLE_DRAW_DEBUG
 	DebugActorsHitDuringCameraPenetration.Reset();
 #endif
@@ -186,8 +219,21 @@ void UUltraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const&
 	BaseRayMatrix.GetScaledAxes(BaseRayLocalFwd, BaseRayLocalRight, BaseRayLocalUp);
 
 	float DistBlockedPctThisFrame = 1.f;
+	bool bAnyFeelerBlocked = false;
+
+	int32 NumRaysToShoot = bSingleRayOnly ? FMath::Min(1, PenetrationAvoidanceFeelers.Num()) : PenetrationAvoidanceFeelers.Num();
+	const int32 MaxPlatformFeelers = UUltraPlatformSpecificRenderingSettings::Get()->MaxCameraPenetrationFeelers;
+	if (MaxPlatformFeelers > 0)
+	{
+		NumRaysToShoot = FMath::Min(NumRaysToShoot, MaxPlatformFeelers);
+	}
+
+	// Nothing was in the way last time and nothing has moved, so the traces would come back the same
+	const float MoveThresholdSq = FMath::Square(PenetrationMoveThreshold);
+	const bool bSkipTracing = !bResetInterpolation && !bAnyFeelerBlockedLastUpdate && (NumUpdatesWithoutTracing < PenetrationMaxSkippedUpdates)
+		&& (FVector::DistSquared(SafeLoc, LastTracedSafeLoc) < MoveThresholdSq)
+		&& (FVector::DistSquared(CameraLoc, LastTracedCameraLoc) < MoveThresholdSq);
 
-	int32 const NumRaysToShoot = bSingleRayOnly ? FMath::Min(1, PenetrationAvoidanceFeelers.Num()) : PenetrationAvoidanceFeelers.Num();
 	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPen), false, nullptr/*PlayerCamera*/);
 
 	SphereParams.AddIgnoredActor(&ViewTarget);
@@ -201,103 +247,139 @@ void UUltraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const&
 	FCollisionShape SphereShape = FCollisionShape::MakeSphere(0.f);
 	UWorld* World = GetWorld();
 
-	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
+	auto ProcessFeelerResult = [&](int32 RayIdx, FUltraPenetrationAvoidanceFeeler& Feeler, bool bHit, const FHitResult& Hit, const FVector& RayStart, const FVector& RayTarget)
 	{
-		FUltraPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
-		if (Feeler.FramesUntilNextTrace <= 0)
+#if ENABLE_DRAW_DEBUG
+		if (World->TimeSince(LastDrawDebugTime) < 1.f)
 		{
-			// calc ray target
-			FVector RayTarget;
-			{
-				FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
-				RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
-				RayTarget = SafeLoc + RotatedRay;
-			}
+			DrawDebugSphere(World, RayStart, Feeler.Extent, 8, FColor::Red);
+			DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, Feeler.Extent, 8, FColor::Red);
+			DrawDebugLine(World, RayStart, bHit ? Hit.Location : RayTarget, FColor::Red);
+		}
+#endif // ENABLE_DRAW_DEBUG
 
-			// cast for world and pawn hits separately.  this is so we can safely ignore the 
-			// camera's target pawn
-			SphereShape.Sphere.Radius = Feeler.Extent;
-			ECollisionChannel TraceChannel = ECC_Camera;		//(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
+		const AActor* HitActor = Hit.GetActor();
 
-			// do multi-line check to make sure the hits we throw out aren't
-			// masking real hits behind (these are important rays).
+		if (bHit && HitActor)
+		{
+			bool bIgnoreHit = false;
 
-			// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
-			FHitResult Hit;
-			const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
-#if ENABLE_DRAW_DEBUG
-			if (World->TimeSince(LastDrawDebugTime) < 1.f)
+			if (HitActor->ActorHasTag(NAME_IgnoreCameraCollision))
 			{
-				DrawDebugSphere(World, SafeLoc, SphereShape.Sphere.Radius, 8, FColor::Red);
-				DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, SphereShape.Sphere.Radius, 8, FColor::Red);
-				DrawDebugLine(World, SafeLoc, bHit ? Hit.Location : RayTarget, FColor::Red);
+				bIgnoreHit = true;
+				SphereParams.AddIgnoredActor(HitActor);
 			}
-#endif // ENABLE_DRAW_DEBUG
 
-			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
-
-			const AActor* HitActor = Hit.GetActor();
-
-			if (bHit && HitActor)
+			// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+			if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
 			{
-				bool bIgnoreHit = false;
-
-				if (HitActor->ActorHasTag(UltraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+				const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+				const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+				const FVector HitOffset = Hit.Location - ViewTargetLocation;
+				const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+				const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+				if (DotHitDirection > 0.0f)
 				{
 					bIgnoreHit = true;
+					// Ignore this CameraBlockingVolume on the remaining sweeps.
 					SphereParams.AddIgnoredActor(HitActor);
 				}
-
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
+				else
 				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
-					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
-					}
-					else
-					{
 #if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
 #endif
-					}
 				}
-				
-				if (!bIgnoreHit)
-				{
-					float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
-					float NewBlockPct = Hit.Time;
-					NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
+			}
+
+			if (!bIgnoreHit)
+			{
+				float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
+				float NewBlockPct = Hit.Time;
+				NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
 
-					// Recompute blocked pct taking into account pushout distance.
-					NewBlockPct = ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).Size();
-					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+				// Recompute blocked pct taking into account pushout distance.
+				NewBlockPct = ((Hit.Location - RayStart).Size() - CollisionPushOutDistance) / (RayTarget - RayStart).Size();
+				DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+				bAnyFeelerBlocked = true;
 
-					// This feeler got a hit, so do another trace next frame
-					Feeler.FramesUntilNextTrace = 0;
+				// This feeler got a hit, so do another trace next frame
+				Feeler.FramesUntilNextTrace = 0;
 
 #if ENABLE_DRAW_DEBUG
-					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+				DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
 #endif
-				}
 			}
+		}
 
-			if (RayIdx == 0)
+		if (RayIdx == 0)
+		{
+			// don't interpolate toward this one, snap to it
+			// assumes ray 0 is the center/main ray 
+			HardBlockedPct = DistBlockedPctThisFrame;
+		}
+		else
+		{
+			SoftBlockedPct = DistBlockedPctThisFrame;
+		}
+	};
+
+	PendingFeelerTraces.SetNum(PenetrationAvoidanceFeelers.Num());
+
+	for (int32 RayIdx = 0; RayIdx < PenetrationAvoidanceFeelers.Num(); ++RayIdx)
+	{
+		FUltraPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+		FTraceHandle& PendingTrace = PendingFeelerTraces[RayIdx];
+
+		// Pick up the async sweep issued on the previous update. Its ray is a frame old, but only the blocked percentage is used.
+		if (PendingTrace.IsValid())
+		{
+			FTraceDatum TraceDatum;
+			if ((RayIdx < NumRaysToShoot) && World->QueryTraceData(PendingTrace, TraceDatum))
 			{
-				// don't interpolate toward this one, snap to it
-				// assumes ray 0 is the center/main ray 
-				HardBlockedPct = DistBlockedPctThisFrame;
+				const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+				ProcessFeelerResult(RayIdx, Feeler, BlockingHit != nullptr, BlockingHit ? *BlockingHit : FHitResult(), TraceDatum.Start, TraceDatum.End);
+			}
+			PendingTrace = FTraceHandle();
+		}
+
+		if ((RayIdx >= NumRaysToShoot) || bSkipTracing)
+		{
+			continue;
+		}
+
+		if (Feeler.FramesUntilNextTrace <= 0)
+		{
+			// calc ray target
+			FVector RayTarget;
+			{
+				FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
+				RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
+				RayTarget = SafeLoc + RotatedRay;
+			}
+
+			// cast for world and pawn hits separately.  this is so we can safely ignore the 
+			// camera's target pawn
+			SphereShape.Sphere.Radius = Feeler.Extent;
+			ECollisionChannel TraceChannel = ECC_Camera;		//(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
+
+			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+
+			if ((RayIdx == 0) || !bAsyncPenetrationFeelers)
+			{
+				// The main ray snaps the camera in, so it can't afford a frame of latency
+
+				// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
+				FHitResult Hit;
+				const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				INC_DWORD_STAT(STAT_UltraCamera_SyncFeelerSweeps);
+
+				ProcessFeelerResult(RayIdx, Feeler, bHit, Hit, SafeLoc, RayTarget);
 			}
 			else
 			{
-				SoftBlockedPct = DistBlockedPctThisFrame;
+				PendingTrace = World->AsyncSweepByChannel(EAsyncTraceType::Single, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				INC_DWORD_STAT(STAT_UltraCamera_AsyncFeelerSweeps);
 			}
 		}
 		else
@@ -306,6 +388,19 @@ void UUltraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const&
 		}
 	}
 
+	if (bSkipTracing)
+	{
+		++NumUpdatesWithoutTracing;
+		INC_DWORD_STAT(STAT_UltraCamera_SkippedFeelerUpdates);
+	}
+	else
+	{
+		LastTracedSafeLoc = SafeLoc;
+		LastTracedCameraLoc = CameraLoc;
+		NumUpdatesWithoutTracing = 0;
+	}
+	bAnyFeelerBlockedLastUpdate = bAnyFeelerBlocked;
+
 	if (bResetInterpolation)
 	{
 		DistBlockedPct = DistBlockedPctThisFrame;
@@ -6,6 +6,7 @@
 #include "Curves/CurveFloat.h"
 #include "UltraPenetrationAvoidanceFeeler.h"
 #include "DrawDebugHelpers.h"
+#include "WorldCollision.h"
 #include "UltraCameraMode_ThirdPerson.generated.h"
 
 class UCurveVector;
@@ -101,6 +102,16 @@ public:
 	mutable float LastDrawDebugTime = -MAX_FLT;
 #endif
 
+private:
+	// Async sweeps issued last update for each feeler, read back on the next one
+	TArray<FTraceHandle> PendingFeelerTraces;
+
+	// Where the safe location and desired camera were the last time feelers were traced
+	FVector LastTracedSafeLoc = FVector(UE_BIG_NUMBER);
+	FVector LastTracedCameraLoc = FVector(UE_BIG_NUMBER);
+	int32 NumUpdatesWithoutTracing = 0;
+	bool bAnyFeelerBlockedLastUpdate = true;
+
 protected:
 	
 	void SetTargetCrouchOffset(FVector NewTargetOffset);
@@ -6,6 +6,7 @@
 #include "Camera/UltraCameraComponent.h"
 #include "Character/UltraDespawnComponent.h"
 #include "Character/UltraPawnExtensionComponent.h"
+#include "Character/UltraPawnPoolSubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "UltraCharacterMovementComponent.h"
@@ -15,6 +16,7 @@
 #include "Player/UltraPlayerController.h"
 #include "Player/UltraPlayerState.h"
 #include "System/UltraSignificanceManager.h"
+#include "Teams/UltraTeamSubsystem.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraCharacter)
@@ -69,6 +71,7 @@ AUltraCharacter::AUltraCharacter(const FObjectInitializer& ObjectInitializer)
 	DespawnComponent = CreateDefaultSubobject<UUltraDespawnComponent>(TEXT("DespawnComponent"));
 	DespawnComponent->OnDespawnStarted.AddDynamic(this, &ThisClass::OnDespawnStarted);
 	DespawnComponent->OnDespawnFinished.AddDynamic(this, &ThisClass::OnDespawnFinished);
+	DespawnComponent->OnDespawnReset.AddDynamic(this, &ThisClass::OnDespawnReset);
 
 	CameraComponent = CreateDefaultSubobject<UUltraCameraComponent>(TEXT("CameraComponent"));
 	CameraComponent->SetRelativeLocation(FVector(-300.0f, 0.0f, 75.0f));
@@ -254,6 +257,11 @@ void AUltraCharacter::OnRep_PlayerState()
 	Super::OnRep_PlayerState();
 
 	PawnExtComponent->HandlePlayerStateReplicated();
+
+	if (UUltraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<UUltraTeamSubsystem>(GetWorld()))
+	{
+		TeamSubsystem->InvalidateTeamMembershipCache();
+	}
 }
 
 void AUltraCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -359,9 +367,115 @@ void AUltraCharacter::DestroyDueToDespawn()
 {
 	K2_OnDespawnFinished();
 
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		if (UUltraPawnPoolSubsystem* PawnPool = UWorld::GetSubsystem<UUltraPawnPoolSubsystem>(GetWorld()))
+		{
+			if (PawnPool->TryRecyclePawn(this))
+			{
+				return;
+			}
+		}
+	}
+	else
+	{
+		// Clients can't tell whether the server pooled or destroyed the character, it doesn't need to tick either way.
+		// OnDespawnReset turns ticking back on if it is reused.
+		SetTickEnabledForPool(false);
+	}
+
 	UninitAndDestroy();
 }
 
+void AUltraCharacter::UninitForRecycle()
+{
+	check(GetLocalRole() == ROLE_Authority);
+
+	DetachFromControllerPendingDestroy();
+
+	if (UUltraAbilitySystemComponent* UltraASC = GetUltraAbilitySystemComponent())
+	{
+		if (UltraASC->GetAvatarActor() == this)
+		{
+			PawnExtComponent->UninitializeAbilitySystem();
+		}
+	}
+
+	SetActorHiddenInGame(true);
+	SetTickEnabledForPool(false);
+
+	// Send the despawned state and hidden flag, then stop replicating until the pawn is reused
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AUltraCharacter::ResetForReuse(const FTransform& SpawnTransform)
+{
+	check(GetLocalRole() == ROLE_Authority);
+
+	SetNetDormancy(DORM_Awake);
+
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	DespawnComponent->ResetDespawn();
+}
+
+void AUltraCharacter::OnDespawnReset(AActor*)
+{
+	UCapsuleComponent* CapsuleComp = GetCapsuleComponent();
+	check(CapsuleComp);
+	CapsuleComp->SetCollisionProfileName(NAME_UltraCharacterCollisionProfile_Capsule);
+
+	if (bIsCrouched)
+	{
+		UnCrouch(true);
+	}
+
+	UUltraCharacterMovementComponent* UltraMoveComp = CastChecked<UUltraCharacterMovementComponent>(GetCharacterMovement());
+	UltraMoveComp->StopMovementImmediately();
+	UltraMoveComp->SetDefaultMovementMode();
+
+	ResetMeshForReuse();
+
+	SetActorHiddenInGame(false);
+	SetTickEnabledForPool(true);
+
+	PawnExtComponent->ResetInitState();
+
+	K2_OnDespawnReset();
+}
+
+void AUltraCharacter::SetTickEnabledForPool(bool bEnabled)
+{
+	// Going back to the start-with-tick settings leaves the character ticking exactly like a freshly spawned one
+	SetActorTickEnabled(bEnabled && PrimaryActorTick.bStartWithTickEnabled);
+
+	UCharacterMovementComponent* MoveComp = GetCharacterMovement();
+	MoveComp->SetComponentTickEnabled(bEnabled && MoveComp->PrimaryComponentTick.bStartWithTickEnabled);
+
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	MeshComp->SetComponentTickEnabled(bEnabled && MeshComp->PrimaryComponentTick.bStartWithTickEnabled);
+}
+
+void AUltraCharacter::ResetMeshForReuse()
+{
+	// Undo what a death ragdoll does to the mesh, using the class defaults as the fresh spawn state
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	const USkeletalMeshComponent* DefaultMeshComp = GetClass()->GetDefaultObject<AUltraCharacter>()->GetMesh();
+	check(MeshComp && DefaultMeshComp);
+
+	MeshComp->SetSimulatePhysics(false);
+	MeshComp->SetAllBodiesPhysicsBlendWeight(0.0f);
+	MeshComp->SetCollisionProfileName(DefaultMeshComp->GetCollisionProfileName());
+	MeshComp->SetCollisionEnabled(DefaultMeshComp->GetCollisionEnabled());
+
+	if (MeshComp->GetAttachParent() != GetCapsuleComponent())
+	{
+		MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	}
+	MeshComp->SetRelativeTransform(FTransform(GetBaseRotationOffset(), GetBaseTranslationOffset(), DefaultMeshComp->GetRelativeScale3D()), false, nullptr, ETeleportType::ResetPhysics);
+}
+
 
 void AUltraCharacter::UninitAndDestroy()
 {
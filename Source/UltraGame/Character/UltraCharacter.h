@@ -146,6 +146,12 @@ public:
 
 	virtual bool UpdateSharedReplication();
 
+	// Used by UUltraPawnPoolSubsystem in place of destroying a despawned character (authority only)
+	void UninitForRecycle();
+
+	// Used by UUltraPawnPoolSubsystem to bring a recycled character back at SpawnTransform (authority only)
+	void ResetForReuse(const FTransform& SpawnTransform);
+
 protected:
 
 	virtual void OnAbilitySystemInitialized();
@@ -169,14 +175,28 @@ protected:
 	UFUNCTION()
 	virtual void OnDespawnFinished(AActor* OwningActor);
 
+	// Called when a recycled character has had its despawn state reset (restores movement, collision, mesh physics, ticking, visibility and initialization)
+	UFUNCTION()
+	virtual void OnDespawnReset(AActor* OwningActor);
+
 	void DisableMovementAndCollision();
 	void DestroyDueToDespawn();
 	void UninitAndDestroy();
 
+	// Stops the actor, movement and mesh from ticking while the character is pooled, or restores their default tick state
+	void SetTickEnabledForPool(bool bEnabled);
+
+	// Restores the physics, collision and attachment of the mesh after a death ragdoll so a recycled character matches a fresh one
+	void ResetMeshForReuse();
+
 	// Called when the despawn sequence for the character has completed
 	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="OnDespawnFinished"))
 	void K2_OnDespawnFinished();
 
+	// Called when a recycled character is reset to be used by a new controller
+	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="OnDespawnReset"))
+	void K2_OnDespawnReset();
+
 	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode) override;
 	void SetMovementModeTag(EMovementMode MovementMode, uint8 CustomMovementMode, bool bTagEnabled);
 
@@ -179,6 +179,9 @@ void UUltraCharacterComponent::HandleChangeInitState(UGameFrameworkComponentMana
 			if (UUltraCameraComponent* CameraComponent = UUltraCameraComponent::FindCameraComponent(Pawn))
 			{
 				CameraComponent->DetermineCameraModeDelegate.BindUObject(this, &ThisClass::DetermineCameraMode);
+
+				CameraComponent->PrewarmCameraModes(MakeArrayView(&PawnData->DefaultCameraMode, 1));
+				CameraComponent->PrewarmCameraModes(PawnData->AdditionalCameraModes);
 			}
 		}
 	}
@@ -193,6 +196,11 @@ void UUltraCharacterComponent::OnActorInitStateChanged(const FActorInitStateChan
 			// If the extension component says all all other components are initialized, try to progress to next state
 			CheckDefaultInitialization();
 		}
+		else if (Params.FeatureState == UltraGameplayTags::InitState_Spawned)
+		{
+			// The pawn was recycled, input gets bound again for the next controller
+			bReadyToBindInputs = false;
+		}
 	}
 }
 
@@ -6,6 +6,7 @@
 #include "AbilitySystemGlobals.h"
 #include "UltraGameplayTags.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PhysicsVolume.h"
@@ -240,6 +241,48 @@ const FUltraCharacterGroundInfo& UUltraCharacterMovementComponent::GetGroundInfo
 	return CachedGroundInfo;
 }
 
+void UUltraCharacterMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateMovementSnapshot();
+}
+
+void UUltraCharacterMovementComponent::UpdateMovementSnapshot()
+{
+	MovementSnapshot.Velocity = Velocity;
+	MovementSnapshot.Acceleration = GetCurrentAcceleration();
+	MovementSnapshot.MovementMode = MovementMode;
+	MovementSnapshot.CustomMovementMode = CustomMovementMode;
+	MovementSnapshot.bIsMovingOnGround = IsMovingOnGround();
+	MovementSnapshot.bIsFalling = IsFalling();
+
+	// Any ground trace happens here on the game thread rather than from inside the anim update.
+	// Only animation reads the ground distance, so skip the trace where nothing will be animated on screen.
+	MovementSnapshot.GroundDistance = ShouldUpdateSnapshotGroundDistance() ? GetGroundInfo().GroundDistance : -1.0f;
+
+	const FGameplayTag* ModeTag = (MovementMode == MOVE_Custom)
+		? UltraGameplayTags::CustomMovementModeTagMap.Find(CustomMovementMode)
+		: UltraGameplayTags::MovementModeTagMap.Find(MovementMode);
+	MovementSnapshot.MovementModeTag = ModeTag ? *ModeTag : FGameplayTag();
+}
+
+bool UUltraCharacterMovementComponent::ShouldUpdateSnapshotGroundDistance() const
+{
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		return false;
+	}
+
+	if (CharacterOwner && (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy))
+	{
+		const USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh();
+		return Mesh && Mesh->WasRecentlyRendered();
+	}
+
+	return true;
+}
+
 void UUltraCharacterMovementComponent::SetReplicatedAcceleration(const FVector& InAcceleration)
 {
 	bHasReplicatedAcceleration = true;
@@ -46,6 +46,44 @@ struct FUltraCharacterGroundInfo
 };
 
 
+/**
+ * FUltraCharacterMovementSnapshot
+ *
+ *	Compact copy of the movement state, published by the movement component at the end of its tick.
+ *	The mesh ticks after the movement component, so animation can read this from worker threads without touching the component.
+ */
+USTRUCT(BlueprintType)
+struct FUltraCharacterMovementSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	FVector Acceleration = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	float GroundDistance = -1.0f;
+
+	// Tag for the current movement mode (e.g., Movement.Mode.Walking or Movement.Mode.Custom.Dash)
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	FGameplayTag MovementModeTag;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	TEnumAsByte<EMovementMode> MovementMode = MOVE_None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	uint8 CustomMovementMode = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	bool bIsMovingOnGround = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	bool bIsFalling = false;
+};
+
+
 /**
  * UUltraCharacterMovementComponent
  *
@@ -70,6 +108,13 @@ public:
 
 	void SetReplicatedAcceleration(const FVector& InAcceleration);
 
+	// Returns the movement state as of the end of this component's last tick. Safe to read from animation worker threads.
+	const FUltraCharacterMovementSnapshot& GetMovementSnapshot() const { return MovementSnapshot; }
+
+	//~UActorComponent interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~End of UActorComponent interface
+
 	//~UMovementComponent interface
 	virtual FRotator GetDeltaRotation(float DeltaTime) const override;
 	virtual float GetMaxSpeed() const override;
@@ -110,6 +155,14 @@ protected:
 	// Cached ground info for the character.  Do not access this directly!  It's only updated when accessed via GetGroundInfo().
 	FUltraCharacterGroundInfo CachedGroundInfo;
 
+	// Published once per tick for animation, see GetMovementSnapshot()
+	FUltraCharacterMovementSnapshot MovementSnapshot;
+
+	void UpdateMovementSnapshot();
+
+	// False on dedicated servers and for simulated proxies that are not being rendered, where nobody reads the ground distance
+	bool ShouldUpdateSnapshotGroundDistance() const;
+
 	UPROPERTY(Transient)
 	bool bHasReplicatedAcceleration = false;
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/UltraCharacterNetSerializers.h"
+
+#include "Character/UltraCharacter.h"
+
+#if UE_WITH_IRIS
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializationContext.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraCharacterNetSerializers)
+
+#if UE_WITH_IRIS
+namespace UE::Net
+{
+
+//////////////////////////////////////////////////////////////////////
+// FUltraReplicatedAccelerationNetSerializer
+
+struct FUltraReplicatedAccelerationNetSerializer
+{
+	static constexpr uint32 Version = 0;
+
+	typedef FUltraReplicatedAcceleration SourceType;
+	typedef uint32 QuantizedType;
+	typedef FUltraReplicatedAccelerationNetSerializerConfig ConfigType;
+
+	static const ConfigType DefaultConfig;
+
+	static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+	{
+		const QuantizedType Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		Context.GetBitStreamWriter()->WriteBits(Value, 24U);
+	}
+
+	static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+	{
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+		Target = Context.GetBitStreamReader()->ReadBits(24U);
+	}
+
+	static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+	{
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+		Target = uint32(Source.AccelXYRadians) | (uint32(Source.AccelXYMagnitude) << 8U) | (uint32(uint8(Source.AccelZ)) << 16U);
+	}
+
+	static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+	{
+		const QuantizedType Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+		Target.AccelXYRadians = uint8(Source & 0xFFU);
+		Target.AccelXYMagnitude = uint8((Source >> 8U) & 0xFFU);
+		Target.AccelZ = int8(uint8((Source >> 16U) & 0xFFU));
+	}
+
+	static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+	{
+		if (Args.bStateIsQuantized)
+		{
+			return *reinterpret_cast<const QuantizedType*>(Args.Source0) == *reinterpret_cast<const QuantizedType*>(Args.Source1);
+		}
+
+		const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+		const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+		return (Value0.AccelXYRadians == Value1.AccelXYRadians) && (Value0.AccelXYMagnitude == Value1.AccelXYMagnitude) && (Value0.AccelZ == Value1.AccelZ);
+	}
+};
+
+UE_NET_IMPLEMENT_SERIALIZER(FUltraReplicatedAccelerationNetSerializer);
+const FUltraReplicatedAccelerationNetSerializer::ConfigType FUltraReplicatedAccelerationNetSerializer::DefaultConfig;
+
+//////////////////////////////////////////////////////////////////////
+// Registration, so properties of this struct type use the serializer above
+
+static const FName PropertyNetSerializerRegistry_NAME_UltraReplicatedAcceleration("UltraReplicatedAcceleration");
+UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_UltraReplicatedAcceleration, FUltraReplicatedAccelerationNetSerializer);
+
+class FUltraCharacterNetSerializerRegistryDelegates final : private FNetSerializerRegistryDelegates
+{
+public:
+	virtual ~FUltraCharacterNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_UltraReplicatedAcceleration);
+	}
+
+private:
+	virtual void OnPreFreezeNetSerializerRegistry() override
+	{
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_UltraReplicatedAcceleration);
+	}
+};
+
+static FUltraCharacterNetSerializerRegistryDelegates UltraCharacterNetSerializerRegistryDelegates;
+
+}
+#endif
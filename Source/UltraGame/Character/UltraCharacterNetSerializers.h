@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Iris/Serialization/NetSerializerConfig.h"
+
+#if UE_WITH_IRIS
+#include "Iris/Serialization/NetSerializer.h"
+#endif
+
+#include "UltraCharacterNetSerializers.generated.h"
+
+// Iris serializer for the replicated acceleration sent by AUltraCharacter.
+// This mirrors the quantization of the legacy NetSerialize path so both replication systems put the same precision on the wire.
+// FSharedRepMovement has none: it is only sent by the replication graph's FastShared path, which has no Iris equivalent.
+
+USTRUCT()
+struct FUltraReplicatedAccelerationNetSerializerConfig : public FNetSerializerConfig
+{
+	GENERATED_BODY()
+};
+
+#if UE_WITH_IRIS
+namespace UE::Net
+{
+	// Packs the three already-quantized bytes of FUltraReplicatedAcceleration into 24 bits
+	UE_NET_DECLARE_SERIALIZER(FUltraReplicatedAccelerationNetSerializer, ULTRAGAME_API);
+}
+#endif
@@ -101,6 +101,13 @@ void UUltraDespawnComponent::OnRep_DespawnState(EUltraDespawnState OldDespawnSta
 	// Revert the despawn state for now since we rely on StartDespawn and FinishDespawn to change it.
 	DespawnState = OldDespawnState;
 
+	if ((NewDespawnState == EUltraDespawnState::NotDespawned) && (OldDespawnState != EUltraDespawnState::NotDespawned))
+	{
+		// The server only goes back to not despawned when the owner is recycled.
+		ResetDespawn();
+		return;
+	}
+
 	if (OldDespawnState > NewDespawnState)
 	{
 		// The server is trying to set us back but we've already predicted past the server state.
@@ -181,4 +188,23 @@ void UUltraDespawnComponent::FinishDespawn()
 	OnDespawnFinished.Broadcast(Owner);
 
 	Owner->ForceNetUpdate();
-}
\ No newline at end of file
+}
+
+void UUltraDespawnComponent::ResetDespawn()
+{
+	if (DespawnState == EUltraDespawnState::NotDespawned)
+	{
+		return;
+	}
+
+	DespawnState = EUltraDespawnState::NotDespawned;
+
+	ClearGameplayTags();
+
+	AActor* Owner = GetOwner();
+	check(Owner);
+
+	OnDespawnReset.Broadcast(Owner);
+
+	Owner->ForceNetUpdate();
+}
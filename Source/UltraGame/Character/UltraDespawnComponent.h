@@ -71,6 +71,9 @@ public:
 	// Ends the despawn sequence for the owner.
 	virtual void FinishDespawn();
 
+	// Returns a despawned owner to the not despawned state so it can be reused (see UUltraPawnPoolSubsystem).
+	virtual void ResetDespawn();
+
 public:
 
 	// Delegate fired when the despawn sequence has started.
@@ -81,6 +84,10 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FUltraDespawn_DespawnEvent OnDespawnFinished;
 
+	// Delegate fired when a despawned owner has been reset for reuse.
+	UPROPERTY(BlueprintAssignable)
+	FUltraDespawn_DespawnEvent OnDespawnReset;
+
 protected:
 
 	virtual void OnUnregister() override;
@@ -49,4 +49,9 @@ public:
 	// Default camera mode used by player controlled pawns.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ultra|Camera")
 	TSubclassOf<UUltraCameraMode> DefaultCameraMode;
+
+	// Camera modes abilities may push on this pawn (aiming, dashing, death cams, ...).
+	// They are created along with the default camera mode so pushing them doesn't allocate.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ultra|Camera")
+	TArray<TSubclassOf<UUltraCameraMode>> AdditionalCameraModes;
 };
@@ -210,6 +210,25 @@ void UUltraPawnExtensionComponent::SetupPlayerInputComponent()
 	CheckDefaultInitialization();
 }
 
+void UUltraPawnExtensionComponent::ResetInitState()
+{
+	APawn* Pawn = GetPawnChecked<APawn>();
+
+	if (UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(Pawn))
+	{
+		for (UActorComponent* Component : Pawn->GetComponents())
+		{
+			IGameFrameworkInitStateInterface* InitStateImplementer = Cast<IGameFrameworkInitStateInterface>(Component);
+			if (InitStateImplementer && Manager->GetInitStateForFeature(Pawn, InitStateImplementer->GetFeatureName()).IsValid())
+			{
+				Manager->ChangeFeatureInitState(Pawn, InitStateImplementer->GetFeatureName(), Component, UltraGameplayTags::InitState_Spawned);
+			}
+		}
+	}
+
+	CheckDefaultInitialization();
+}
+
 void UUltraPawnExtensionComponent::CheckDefaultInitialization()
 {
 	// Before checking our progress, try progressing any other features we might depend on
@@ -71,6 +71,9 @@ public:
 	/** Should be called by the owning pawn when the input component is setup. */
 	void SetupPlayerInputComponent();
 
+	/** Puts every init state feature on the pawn back to spawned so a recycled pawn initializes again for its next controller. */
+	void ResetInitState();
+
 	/** Register with the OnAbilitySystemInitialized delegate and broadcast if our pawn has been registered with the ability system component */
 	void OnAbilitySystemInitialized_RegisterAndCall(FSimpleMulticastDelegate::FDelegate Delegate);
 
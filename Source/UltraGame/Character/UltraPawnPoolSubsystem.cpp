@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UltraPawnPoolSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Character/UltraCharacter.h"
+#include "Character/UltraPawnData.h"
+#include "Character/UltraPawnExtensionComponent.h"
+#include "Cosmetics/UltraControllerComponent_CharacterParts.h"
+#include "GameFramework/Controller.h"
+#include "UltraLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraPawnPoolSubsystem)
+
+void UUltraPawnPoolSubsystem::Deinitialize()
+{
+	PooledPawns.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UUltraPawnPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void UUltraPawnPoolSubsystem::ConfigurePool(bool bInRecyclePawns, int32 InMaxPooledPawnsPerType)
+{
+	bRecyclePawns = bInRecyclePawns;
+	MaxPooledPawnsPerType = FMath::Max(InMaxPooledPawnsPerType, 1);
+
+	if (!bRecyclePawns)
+	{
+		for (const FPooledPawn& Entry : PooledPawns)
+		{
+			if (AUltraCharacter* Character = Entry.Character.Get())
+			{
+				Character->Destroy();
+			}
+		}
+		PooledPawns.Reset();
+	}
+}
+
+void UUltraPawnPoolSubsystem::RemoveStalePawns()
+{
+	PooledPawns.RemoveAllSwap([](const FPooledPawn& Entry) { return !IsValid(Entry.Character.Get()); });
+}
+
+bool UUltraPawnPoolSubsystem::IsPawnPooled(const APawn* Pawn) const
+{
+	return (Pawn != nullptr) && PooledPawns.ContainsByPredicate([Pawn](const FPooledPawn& Entry) { return Entry.Character.Get() == Pawn; });
+}
+
+bool UUltraPawnPoolSubsystem::TryRecyclePawn(AUltraCharacter* Character)
+{
+	if (!bRecyclePawns || !IsValid(Character) || !Character->HasAuthority())
+	{
+		return false;
+	}
+
+	const UUltraPawnExtensionComponent* PawnExtComp = UUltraPawnExtensionComponent::FindPawnExtensionComponent(Character);
+	const UUltraPawnData* PawnData = PawnExtComp ? PawnExtComp->GetPawnData<UUltraPawnData>() : nullptr;
+	if (PawnData == nullptr)
+	{
+		return false;
+	}
+
+	// A character that owns its ability system would carry effects and attributes into its next life, so it isn't recycled
+	if (Character->FindComponentByClass<UAbilitySystemComponent>() != nullptr)
+	{
+		return false;
+	}
+
+	RemoveStalePawns();
+
+	const UClass* PawnClass = Character->GetClass();
+	int32 NumOfType = 0;
+	for (const FPooledPawn& Entry : PooledPawns)
+	{
+		if ((Entry.PawnClass == PawnClass) && (Entry.PawnData == PawnData))
+		{
+			++NumOfType;
+		}
+	}
+
+	if (NumOfType >= MaxPooledPawnsPerType)
+	{
+		return false;
+	}
+
+	// Added before uninitializing so listeners of the unpossess can tell the pawn is being recycled
+	FPooledPawn& NewEntry = PooledPawns.AddDefaulted_GetRef();
+	NewEntry.Character = Character;
+	NewEntry.LastController = Character->GetController();
+	NewEntry.PawnClass = PawnClass;
+	NewEntry.PawnData = PawnData;
+
+	Character->UninitForRecycle();
+
+	UE_LOG(LogUltra, Verbose, TEXT("Recycled pawn [%s] into the pawn pool (%d pooled)."), *GetNameSafe(Character), PooledPawns.Num());
+
+	return true;
+}
+
+AUltraCharacter* UUltraPawnPoolSubsystem::AcquirePawn(UClass* PawnClass, const UUltraPawnData* PawnData, AController* NewController, const FTransform& SpawnTransform)
+{
+	if (!bRecyclePawns || (PawnClass == nullptr) || (PawnData == nullptr))
+	{
+		return nullptr;
+	}
+
+	RemoveStalePawns();
+
+	// Prefer the pawn this controller had last since its cosmetic parts are still attached
+	int32 BestIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < PooledPawns.Num(); ++Index)
+	{
+		const FPooledPawn& Entry = PooledPawns[Index];
+		if ((Entry.PawnClass == PawnClass) && (Entry.PawnData == PawnData))
+		{
+			if (Entry.LastController == NewController)
+			{
+				BestIndex = Index;
+				break;
+			}
+
+			if (BestIndex == INDEX_NONE)
+			{
+				BestIndex = Index;
+			}
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FPooledPawn Entry = PooledPawns[BestIndex];
+	PooledPawns.RemoveAtSwap(BestIndex);
+
+	AUltraCharacter* Character = Entry.Character.Get();
+
+	if (AController* LastController = Entry.LastController.Get())
+	{
+		if (LastController != NewController)
+		{
+			if (UUltraControllerComponent_CharacterParts* LastControllerParts = LastController->FindComponentByClass<UUltraControllerComponent_CharacterParts>())
+			{
+				LastControllerParts->ReleasePartsKeptOnPawn(Character);
+			}
+		}
+	}
+
+	Character->ResetForReuse(SpawnTransform);
+
+	UE_LOG(LogUltra, Verbose, TEXT("Reusing pawn [%s] from the pawn pool for [%s] (%d pooled)."), *GetNameSafe(Character), *GetNameSafe(NewController), PooledPawns.Num());
+
+	return Character;
+}
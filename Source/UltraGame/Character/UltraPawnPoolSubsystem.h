@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "UltraPawnPoolSubsystem.generated.h"
+
+class AController;
+class APawn;
+class AUltraCharacter;
+class UClass;
+class UObject;
+class UUltraPawnData;
+
+/**
+ * UUltraPawnPoolSubsystem
+ *
+ *	Keeps despawned characters around so the next respawn can reuse one instead of spawning a new actor.
+ *	Recycling is opt-in per experience (UUltraExperienceDefinition::bRecycleDespawnedPawns) and only happens on the authority.
+ *
+ *	A pooled character is uninitialized from its ability system, unpossessed, hidden, stops ticking and is put to sleep with net dormancy.
+ *	When it is reused it is woken up, moved to the spawn transform and its despawn state, movement, collision, mesh physics, ticking and
+ *	init state chain are reset so the new controller goes through the same initialization as for a fresh spawn.
+ *	Cosmetic character parts are left on the pawn and only respawned if it is handed to a different controller.
+ */
+UCLASS()
+class ULTRAGAME_API UUltraPawnPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Enables or disables recycling, usually from the loaded experience. Disabling it destroys every pooled pawn.
+	void ConfigurePool(bool bInRecyclePawns, int32 InMaxPooledPawnsPerType);
+
+	bool IsRecyclingEnabled() const { return bRecyclePawns; }
+
+	// Takes a character that finished despawning into the pool, returns false if it should be destroyed as usual
+	bool TryRecyclePawn(AUltraCharacter* Character);
+
+	// Returns a pooled character of the class and pawn data that has been reset at SpawnTransform, or nullptr if there is none
+	AUltraCharacter* AcquirePawn(UClass* PawnClass, const UUltraPawnData* PawnData, AController* NewController, const FTransform& SpawnTransform);
+
+	// Returns true if the pawn is currently sitting in the pool (or on its way in)
+	bool IsPawnPooled(const APawn* Pawn) const;
+
+	int32 GetNumPooledPawns() const { return PooledPawns.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPooledPawn
+	{
+		TWeakObjectPtr<AUltraCharacter> Character;
+		TWeakObjectPtr<AController> LastController;
+		const UClass* PawnClass = nullptr;
+		const UUltraPawnData* PawnData = nullptr;
+	};
+
+	void RemoveStalePawns();
+
+private:
+	TArray<FPooledPawn> PooledPawns;
+
+	bool bRecyclePawns = false;
+	int32 MaxPooledPawnsPerType = 8;
+};
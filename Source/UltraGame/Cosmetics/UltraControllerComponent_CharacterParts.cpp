@@ -1,8 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Cosmetics/UltraControllerComponent_CharacterParts.h"
+#include "Character/UltraPawnPoolSubsystem.h"
 #include "Cosmetics/UltraCharacterPartTypes.h"
 #include "Cosmetics/UltraPawnComponent_CharacterParts.h"
+#include "Engine/World.h"
 #include "GameFramework/CheatManagerDefines.h"
 #include "UltraCosmeticDeveloperSettings.h"
 #include "GameFramework/Pawn.h"
@@ -49,6 +51,10 @@ UUltraPawnComponent_CharacterParts* UUltraControllerComponent_CharacterParts::Ge
 	{
 		return ControlledPawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>();
 	}
+	else if (APawn* KeptPawn = PartsKeptOnPawn.Get())
+	{
+		return KeptPawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>();
+	}
 	return nullptr;
 }
 
@@ -105,9 +111,16 @@ void UUltraControllerComponent_CharacterParts::RemoveAllCharacterParts()
 
 void UUltraControllerComponent_CharacterParts::OnPossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
 {
-	// Remove from the old pawn
-	if (UUltraPawnComponent_CharacterParts* OldCustomizer = OldPawn ? OldPawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>() : nullptr)
+	const UUltraPawnPoolSubsystem* PawnPool = UWorld::GetSubsystem<UUltraPawnPoolSubsystem>(GetWorld());
+
+	if ((OldPawn != nullptr) && (PawnPool != nullptr) && PawnPool->IsPawnPooled(OldPawn))
 	{
+		// Leave the parts on a pawn going into the pool, if we get it back they don't need to be spawned again
+		PartsKeptOnPawn = OldPawn;
+	}
+	else if (UUltraPawnComponent_CharacterParts* OldCustomizer = OldPawn ? OldPawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>() : nullptr)
+	{
+		// Remove from the old pawn
 		for (FUltraControllerCharacterPartEntry& Entry : CharacterParts)
 		{
 			OldCustomizer->RemoveCharacterPart(Entry.Handle);
@@ -115,14 +128,27 @@ void UUltraControllerComponent_CharacterParts::OnPossessedPawnChanged(APawn* Old
 		}
 	}
 
+	if (NewPawn == nullptr)
+	{
+		return;
+	}
+
+	if (NewPawn == PartsKeptOnPawn.Get())
+	{
+		// Our recycled pawn came back, only parts added while it was pooled are missing
+		PartsKeptOnPawn.Reset();
+	}
+	else
+	{
+		ReleasePartsKeptOnPawn(PartsKeptOnPawn.Get());
+	}
+
 	// Apply to the new pawn
-	if (UUltraPawnComponent_CharacterParts* NewCustomizer = NewPawn ? NewPawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>() : nullptr)
+	if (UUltraPawnComponent_CharacterParts* NewCustomizer = NewPawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>())
 	{
 		for (FUltraControllerCharacterPartEntry& Entry : CharacterParts)
 		{
-			ensure(!Entry.Handle.IsValid());
-
-			if (Entry.Source != ECharacterPartSource::NaturalSuppressedViaCheat)
+			if (!Entry.Handle.IsValid() && (Entry.Source != ECharacterPartSource::NaturalSuppressedViaCheat))
 			{
 				Entry.Handle = NewCustomizer->AddCharacterPart(Entry.Part);
 			}
@@ -130,6 +156,25 @@ void UUltraControllerComponent_CharacterParts::OnPossessedPawnChanged(APawn* Old
 	}
 }
 
+void UUltraControllerComponent_CharacterParts::ReleasePartsKeptOnPawn(APawn* Pawn)
+{
+	if ((Pawn == nullptr) || (Pawn != PartsKeptOnPawn.Get()))
+	{
+		return;
+	}
+
+	if (UUltraPawnComponent_CharacterParts* KeptCustomizer = Pawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>())
+	{
+		for (FUltraControllerCharacterPartEntry& Entry : CharacterParts)
+		{
+			KeptCustomizer->RemoveCharacterPart(Entry.Handle);
+			Entry.Handle.Reset();
+		}
+	}
+
+	PartsKeptOnPawn.Reset();
+}
+
 void UUltraControllerComponent_CharacterParts::ApplyDeveloperSettings()
 {
 #if UE_WITH_CHEAT_MANAGER
@@ -77,10 +77,16 @@ public:
 	// Applies relevant developer settings if in PIE
 	void ApplyDeveloperSettings();
 
+	// Removes the parts that were left on a recycled pawn, called when the pawn pool hands that pawn to another controller
+	void ReleasePartsKeptOnPawn(APawn* Pawn);
+
 protected:
 	UPROPERTY(EditAnywhere, Category=Cosmetics)
 	TArray<FUltraControllerCharacterPartEntry> CharacterParts;
 
+	// Pawn that went into the pawn pool with our parts still attached, so they can be kept if we get it back
+	TWeakObjectPtr<APawn> PartsKeptOnPawn;
+
 private:
 	UUltraPawnComponent_CharacterParts* GetPawnCustomizer() const;
 
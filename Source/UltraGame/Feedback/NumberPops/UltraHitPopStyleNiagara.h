@@ -22,7 +22,22 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category="HitPop")
 	FName NiagaraArrayName;
 
+	//Niagara int parameters that receive the slot of the oldest live hit, the number of live hits and the total number of hits written to the array,
+	//which is used as a ring buffer and read modulo its length
+	UPROPERTY(EditDefaultsOnly, Category="HitPop")
+	FName RingHeadParameterName = TEXT("User.HitRingHead");
+
+	UPROPERTY(EditDefaultsOnly, Category="HitPop")
+	FName RingCountParameterName = TEXT("User.HitRingCount");
+
+	UPROPERTY(EditDefaultsOnly, Category="HitPop")
+	FName RingWriteCountParameterName = TEXT("User.HitRingWriteCount");
+
 	//Niagara System used to display the hits
 	UPROPERTY(EditDefaultsOnly, Category="HitPop")
 	TObjectPtr<UNiagaraSystem> TextNiagara;
+
+	//How long a hit stays in the Niagara array, should match the lifetime of the particles spawned for it
+	UPROPERTY(EditDefaultsOnly, Category="HitPop", meta=(ForceUnits=s, ClampMin=0.0))
+	float HitLifetime = 1.5f;
 };
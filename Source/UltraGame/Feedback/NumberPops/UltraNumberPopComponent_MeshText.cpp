@@ -2,33 +2,36 @@
 
 #include "UltraNumberPopComponent_MeshText.h"
 
-#include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Engine/CollisionProfile.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Feedback/NumberPops/UltraNumberPopComponent.h"
+#include "GameFramework/PlayerController.h"
 #include "UltraHitPopStyle.h"
-#include "Materials/MaterialInstanceDynamic.h"
-#include "TimerManager.h"
-#include "UObject/Package.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraNumberPopComponent_MeshText)
 
 class UStaticMesh;
 
+namespace UltraNumberPop
+{
+	// Instances are hidden by collapsing them rather than removing them, so indices stay stable and nothing is reallocated
+	static const FTransform HiddenInstanceTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+
+	// Upper limit for MaxDigitSlots, the digits of a pop are laid out in a fixed size buffer
+	static constexpr int32 MaxDigitSlots = 32;
+}
+
 UUltraNumberPopComponent_MeshText::UUltraNumberPopComponent_MeshText(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	ComponentLifespan = 1.f;
+	// Only ticks while there are pops to lay out or release
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
 
-	SignDigitParameterName = FName(TEXT("+Or-"));
-	ColorParameterName = FName(TEXT("Color"));
-	AnimationLifespanParameterName = FName(TEXT("Animation Lifespan"));
-	IsCriticalHitParameterName = FName(TEXT("isCriticalHit?"));
-	MoveToCameraParameterName = FName(TEXT("MoveToCamera"));
-	PositionParameterNames = { TEXT("0a"), TEXT("1a"), TEXT("2a"), TEXT("3a"), TEXT("4a"),  TEXT("5a"),  TEXT("6a"),  TEXT("7a"),  TEXT("8a") };
-	ScaleRotationAngleParameterNames = { TEXT("0b"), TEXT("1b"), TEXT("2b"), TEXT("3b"), TEXT("4b"),  TEXT("5b"),  TEXT("6b"),  TEXT("7b"),  TEXT("8b") };
-	DurationParameterNames = { TEXT("0c"), TEXT("1c"), TEXT("2c"), TEXT("3c"), TEXT("4c"),  TEXT("5c"),  TEXT("6c"),  TEXT("7c"),  TEXT("8c") };
+	ComponentLifespan = 1.f;
 
 	SpacingPercentageForOnes = 0.8f;
 
@@ -40,175 +43,199 @@ UUltraNumberPopComponent_MeshText::UUltraNumberPopComponent_MeshText(const FObje
 	FontYSize = 21.0f;
 
 	NumberOfNumberRotations = 1.f;
+
+	MaxDigitSlots = 9;
+	InstanceBudgetPerMesh = 64;
 }
 
-void UUltraNumberPopComponent_MeshText::AddNumberPop(const FUltraNumberPopRequest& NewRequest)
+void UUltraNumberPopComponent_MeshText::BeginPlay()
 {
-	// Drop requests for remote players on the floor
-	// (this prevents multiple pops from showing up for the host of a listen server)
+	Super::BeginPlay();
+
+	// Prewarm a batch for every mesh a style can pick so the first pops don't create components
 	if (APlayerController* PC = GetController<APlayerController>())
 	{
-		if (!PC->IsLocalController())
+		if (PC->IsLocalController())
 		{
-			return;
+			for (UUltraHitPopStyle* Style : Styles)
+			{
+				if ((Style != nullptr) && Style->bOverrideMesh && (Style->TextMesh != nullptr))
+				{
+					FindOrCreateBatch(Style->TextMesh);
+				}
+			}
 		}
 	}
 
-	FTempNumberPopInfo PreparedNumberInfo;
+	CustomDataScratch.SetNumZeroed(UltraNumberPopCustomData::FirstDigit + (GetNumDigitSlots() * UltraNumberPopCustomData::FloatsPerDigit));
+	PendingPops.Reserve(InstanceBudgetPerMesh);
+}
 
-	// Prepare the HitNumberArray with the digits from the hit.
+FNumberPopInstanceBatch& UUltraNumberPopComponent_MeshText::FindOrCreateBatch(UStaticMesh* Mesh)
+{
+	FNumberPopInstanceBatch& Batch = InstanceBatches.FindOrAdd(Mesh);
+	if (Batch.Component != nullptr)
 	{
-		int32 LocalHit = NewRequest.NumberToDisplay;
-		PreparedNumberInfo.HitNumberArray.Empty();
+		return Batch;
+	}
 
-		if (LocalHit == 0)
-		{
-			// We want to just show a zero
-			PreparedNumberInfo.HitNumberArray.Insert(0, 0);
-		}
-		else
-		{
-			// Parse the base10 number into an array
-			while (LocalHit > 0)
-			{
-				PreparedNumberInfo.HitNumberArray.Insert(LocalHit % 10, 0);
-				LocalHit /= 10;
-			}
-		}
+	UInstancedStaticMeshComponent* BatchComponent = NewObject<UInstancedStaticMeshComponent>(GetOwner());
+	BatchComponent->SetupAttachment(nullptr);
+	BatchComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	BatchComponent->SetCastShadow(false);
+	BatchComponent->SetStaticMesh(Mesh);
+
+	// Used to allow post-processes to opt out of affecting the number pop digits
+	BatchComponent->SetRenderCustomDepth(true);
+	BatchComponent->SetCustomDepthStencilValue(123);
+
+	// The digits travel a great distance from their original bounds due to
+	// world position offset (WPO) animation in the material, so expand bounds
+	BatchComponent->SetBoundsScale(2000.0f);
+
+	// Color, digits, etc... are passed per instance instead of through MIDs, so every pop shares one draw
+	BatchComponent->NumCustomDataFloats = UltraNumberPopCustomData::FirstDigit + (GetNumDigitSlots() * UltraNumberPopCustomData::FloatsPerDigit);
 
-		// Insert a zero to reserve space for + or -. Used by the blueprint
-		PreparedNumberInfo.HitNumberArray.Insert(0, 0);
+	BatchComponent->RegisterComponent();
+
+	const int32 Budget = FMath::Max(InstanceBudgetPerMesh, 1);
+	TArray<FTransform> HiddenTransforms;
+	HiddenTransforms.Init(UltraNumberPop::HiddenInstanceTransform, Budget);
+	BatchComponent->AddInstances(HiddenTransforms, /*bShouldReturnIndices=*/ false, /*bWorldSpace=*/ true);
+
+	// Hand out low indices first
+	Batch.FreeInstances.Reserve(Budget);
+	for (int32 InstanceIndex = Budget - 1; InstanceIndex >= 0; --InstanceIndex)
+	{
+		Batch.FreeInstances.Add(InstanceIndex);
 	}
+	Batch.LiveInstances.Reserve(Budget);
+	Batch.Component = BatchComponent;
+
+	return Batch;
+}
 
-	// Grab a component from the pool for this number or create one
+void UUltraNumberPopComponent_MeshText::AddNumberPop(const FUltraNumberPopRequest& NewRequest)
+{
+	// Drop requests for remote players on the floor
+	// (this prevents multiple pops from showing up for the host of a listen server)
+	if (APlayerController* PC = GetController<APlayerController>())
 	{
-		UStaticMesh* MeshToUse = DetermineStaticMesh(NewRequest);
-		if (MeshToUse == nullptr)
+		if (!PC->IsLocalController())
 		{
 			return;
 		}
+	}
 
-		FPooledNumberPopComponentList& ComponentPool = PooledComponentMap.FindOrAdd(MeshToUse);
+	UStaticMesh* MeshToUse = DetermineStaticMesh(NewRequest);
+	if (MeshToUse == nullptr)
+	{
+		return;
+	}
 
-		UStaticMeshComponent* ComponentToUse = nullptr;
-		if (ComponentPool.Components.Num() > 0)
-		{
-			ComponentToUse = ComponentPool.Components.Pop();
-		}
-		else
-		{
-			ComponentToUse = NewObject<UStaticMeshComponent>(GetOwner());
-			ComponentToUse->SetupAttachment(nullptr);
-			ComponentToUse->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
-			ComponentToUse->SetStaticMesh(MeshToUse);
+	// Layout happens once per frame for every pop that arrived, see TickComponent
+	FPendingNumberPop& Pop = PendingPops.AddDefaulted_GetRef();
+	Pop.Mesh = MeshToUse;
+	Pop.WorldLocation = NewRequest.WorldLocation;
+	Pop.Color = DetermineColor(NewRequest);
+	Pop.NumberToDisplay = NewRequest.NumberToDisplay;
+	Pop.bIsCriticalHit = NewRequest.bIsCriticalHit;
 
-			// Used to allow post-processes to opt out of affecting the number pop digits
-			ComponentToUse->SetRenderCustomDepth(true);
-			ComponentToUse->SetCustomDepthStencilValue(123);
+	SetComponentTickEnabled(true);
+}
 
-			// The digits travel a great distance from their original bounds due to
-			// world position offset (WPO) animation in the material, so expand bounds
-			ComponentToUse->SetBoundsScale(2000.0f);
+void UUltraNumberPopComponent_MeshText::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-			// We'll be overriding values like the desired color and digits to use, so we need MIDs
-			for (int32 MatIdx = 0; MatIdx < ComponentToUse->GetNumMaterials(); ++MatIdx)
-			{
-				ComponentToUse->CreateDynamicMaterialInstance(MatIdx);
-			}
-		}
+	UWorld* LocalWorld = GetWorld();
+	check(LocalWorld);
 
-		// Register
-		check(ComponentToUse);
-		ComponentToUse->RegisterComponent();
+	const float CurrentTime = LocalWorld->GetTimeSeconds();
+	const float RealGameTime = LocalWorld->GetRealTimeSeconds();
 
-		// Add to the "live" list
-		UWorld* LocalWorld = GetWorld();
-		check(LocalWorld);
-		LiveComponents.Emplace(ComponentToUse, &ComponentPool, LocalWorld->GetTimeSeconds() + ComponentLifespan);
+	for (TPair<TObjectPtr<UStaticMesh>, FNumberPopInstanceBatch>& BatchPair : InstanceBatches)
+	{
+		ReleaseExpiredInstances(BatchPair.Value, CurrentTime);
+	}
 
-		// Assign struct pointers
-		PreparedNumberInfo.StaticMeshComponent = ComponentToUse;
-		for (int32 MatIdx = 0; MatIdx < ComponentToUse->GetNumMaterials(); ++MatIdx)
+	if (PendingPops.Num() > 0)
+	{
+		FTransform CameraTransform;
+		if (APlayerController* PC = GetController<APlayerController>())
 		{
-			UMaterialInstanceDynamic* NewMID = Cast<UMaterialInstanceDynamic>(ComponentToUse->GetMaterial(MatIdx));
-			PreparedNumberInfo.MeshMIDs.Add(NewMID);
+			if (APlayerCameraManager* PlayerCameraManager = PC->PlayerCameraManager)
+			{
+				CameraTransform = FTransform(PlayerCameraManager->GetCameraRotation(), PlayerCameraManager->GetCameraLocation());
+			}
 		}
 
-		// Start the timer if it wasn't already running
-		if (!LocalWorld->GetTimerManager().IsTimerActive(ReleaseTimerHandle))
+		for (const FPendingNumberPop& Pop : PendingPops)
 		{
-			LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseNextComponents, ComponentLifespan);
+			FNumberPopInstanceBatch& Batch = FindOrCreateBatch(Pop.Mesh);
+
+			int32 InstanceIndex = INDEX_NONE;
+			if (Batch.FreeInstances.Num() > 0)
+			{
+				InstanceIndex = Batch.FreeInstances.Pop(/*bAllowShrinking=*/ false);
+			}
+			else
+			{
+				// Over budget, recycle the oldest live pop
+				InstanceIndex = Batch.LiveInstances[0].InstanceIndex;
+				Batch.LiveInstances.RemoveAt(0, 1, /*bAllowShrinking=*/ false);
+			}
+
+			Batch.LiveInstances.Emplace(InstanceIndex, CurrentTime + ComponentLifespan);
+			LayoutNumberPop(Pop, Batch, InstanceIndex, CameraTransform, RealGameTime);
 		}
+		PendingPops.Reset();
 	}
 
-	// Determine the position
-	FTransform CameraTransform;
-	FVector NumberLocation(NewRequest.WorldLocation);
-	if (APlayerController* PC = GetController<APlayerController>())
+	bool bAnyLive = false;
+	for (TPair<TObjectPtr<UStaticMesh>, FNumberPopInstanceBatch>& BatchPair : InstanceBatches)
 	{
-		if (APlayerCameraManager* PlayerCameraManager = PC->PlayerCameraManager)
+		FNumberPopInstanceBatch& Batch = BatchPair.Value;
+		if (Batch.bRenderStateDirty && (Batch.Component != nullptr))
 		{
-			CameraTransform = FTransform(PlayerCameraManager->GetCameraRotation(), PlayerCameraManager->GetCameraLocation());
-
-			FVector LocationOffset(ForceInitToZero);
-
-			const float RandomMagnitude = 5.0f; //@TODO: Make this style driven
-			LocationOffset += FMath::RandPointInBox(FBox(FVector(-RandomMagnitude), FVector(RandomMagnitude)));
-
-			NumberLocation += LocationOffset;
+			// One render state update per mesh per frame, regardless of how many pops changed
+			Batch.Component->MarkRenderStateDirty();
+			Batch.bRenderStateDirty = false;
 		}
+		bAnyLive |= (Batch.LiveInstances.Num() > 0);
 	}
-	PreparedNumberInfo.StaticMeshComponent->SetWorldTransform(FTransform(CameraTransform.GetRotation(), NumberLocation));
 
-	// Now apply the material parameters to make the digits, etc...
-	SetMaterialParameters(NewRequest, PreparedNumberInfo, CameraTransform, NumberLocation);
+	if (!bAnyLive)
+	{
+		SetComponentTickEnabled(false);
+	}
 }
 
-void UUltraNumberPopComponent_MeshText::ReleaseNextComponents()
+void UUltraNumberPopComponent_MeshText::ReleaseExpiredInstances(FNumberPopInstanceBatch& Batch, float CurrentTime)
 {
-	UWorld* LocalWorld = GetWorld();
-	check(LocalWorld);
-
-	const float CurrentTime = LocalWorld->GetTimeSeconds();
-
 	int32 NumReleased = 0;
-	for (const FLiveNumberPopEntry& LiveComp : LiveComponents)
+	for (const FLiveNumberPopInstance& LiveInstance : Batch.LiveInstances)
 	{
-		if (CurrentTime >= LiveComp.ReleaseTime)
+		if (CurrentTime >= LiveInstance.ReleaseTime)
 		{
 			NumReleased++;
-			if (ensure(LiveComp.Component))
+			if (ensure(Batch.Component))
 			{
-				LiveComp.Component->UnregisterComponent();
-
-				if (ensure(LiveComp.Pool))
-				{
-					// Return this component to the pool
-					LiveComp.Pool->Components.Push(LiveComp.Component);
-				}
-				else
-				{
-					// No pool. Just remove it.
-					LiveComp.Component->SetFlags(RF_Transient);
-					LiveComp.Component->Rename(nullptr, GetTransientPackage(), RF_NoFlags);
-				}
+				Batch.Component->UpdateInstanceTransform(LiveInstance.InstanceIndex, UltraNumberPop::HiddenInstanceTransform, /*bWorldSpace=*/ true, /*bMarkRenderStateDirty=*/ false, /*bTeleport=*/ true);
 			}
+			Batch.FreeInstances.Add(LiveInstance.InstanceIndex);
 		}
 		else
 		{
-			// These are in chronological order so none of the other elements will be deleted
+			// These are in chronological order so none of the other elements will be released
 			break;
 		}
 	}
 
-	// Actually remove it from the live components array
-	LiveComponents.RemoveAt(0, NumReleased);
-
-	// If we still have live components animating, set the timer to remove the next one
-	if (LiveComponents.Num() > 0)
+	if (NumReleased > 0)
 	{
-		const float TimeUntilNextRelease = LiveComponents[0].ReleaseTime - CurrentTime;
-		LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseNextComponents, TimeUntilNextRelease);
+		Batch.LiveInstances.RemoveAt(0, NumReleased, /*bAllowShrinking=*/ false);
+		Batch.bRenderStateDirty = true;
 	}
 }
 
@@ -244,93 +271,91 @@ UStaticMesh* UUltraNumberPopComponent_MeshText::DetermineStaticMesh(const FUltra
 	return nullptr;
 }
 
-void UUltraNumberPopComponent_MeshText::SetMaterialParameters(const FUltraNumberPopRequest& Request, FTempNumberPopInfo& NewHitNumberInfo, const FTransform& CameraTransform, const FVector& NumberLocation)
+void UUltraNumberPopComponent_MeshText::LayoutNumberPop(const FPendingNumberPop& Pop, FNumberPopInstanceBatch& Batch, int32 InstanceIndex, const FTransform& CameraTransform, float RealGameTime)
 {
-	UWorld* World = GetWorld();
-	if (World && GEngine)
-	{
-		const float RealGameTime = World->GetRealTimeSeconds();
-
-		// Whether we should show a sign as the first digit, and if so which one
-		// (if bIsSignNegative is true, we show minus, false is plus)
-		const bool bShouldShowSign = false;
-		const bool bIsSignNegative = true;
-
-		for (UMaterialInstanceDynamic* MeshMID : NewHitNumberInfo.MeshMIDs)
-		{
-			MeshMID->SetScalarParameterValue(SignDigitParameterName, bIsSignNegative ? 0.5f : 0.0f);
-			MeshMID->SetVectorParameterValue(ColorParameterName, DetermineColor(Request));
-
-			// IF the hit number has more digits than we support
-			// THEN force the hit number to the highest number we can support
-			const int32 MaxSupportedDigits = FMath::Min(FMath::Min(PositionParameterNames.Num(), ScaleRotationAngleParameterNames.Num()), DurationParameterNames.Num());
-			if (!ensure(NewHitNumberInfo.HitNumberArray.Num() <= MaxSupportedDigits))
-			{
-				NewHitNumberInfo.HitNumberArray.SetNum(MaxSupportedDigits);
-
-				// Set all number digits to 9 so we show the largest number we can
-				// Skip digit 0 because that digit is for the +/- sign
-				for (int32 DigitIndex = 1; DigitIndex < NewHitNumberInfo.HitNumberArray.Num(); ++DigitIndex)
-				{
-					NewHitNumberInfo.HitNumberArray[DigitIndex] = 9;
-				}
-			}
-
-			MeshMID->SetScalarParameterValue(AnimationLifespanParameterName, ComponentLifespan);
-			MeshMID->SetScalarParameterValue(IsCriticalHitParameterName, Request.bIsCriticalHit ? 1.f : 0.f);
-
-			const int32 HitNumberArrayLength = NewHitNumberInfo.HitNumberArray.Num();
-			float OffsetAccumulatedValue = (HitNumberArrayLength * -1.f) + (bShouldShowSign ? 0.f : -1.f);
-
-			const int32 LastIndex = (HitNumberArrayLength >= 4) ? HitNumberArrayLength : 4;
-
-			for (int32 NumberIndex = 0; NumberIndex < LastIndex; ++NumberIndex)
-			{
-				const float NumberYOffset = ((NumberIndex / FMath::Max(1, HitNumberArrayLength - 1)) - 0.5f) * 2.f;
-				const FVector NumberOffset = FVector(0.f, NumberYOffset, 0.f);
-				const FVector CameraSpaceDirection = CameraTransform.TransformVectorNoScale(NumberOffset);
-
-				const float SpacingForNumber = ((NumberIndex < HitNumberArrayLength) && ((NewHitNumberInfo.HitNumberArray[NumberIndex] == 1) || ((NumberIndex > 0) && (NewHitNumberInfo.HitNumberArray[NumberIndex - 1] == 1)))) ? SpacingPercentageForOnes : 1.f;
-				OffsetAccumulatedValue += SpacingForNumber;
-
-				FLinearColor RGBAPositionParameter(CameraSpaceDirection);
-				RGBAPositionParameter.A = OffsetAccumulatedValue;
-
-				const FName PositionParameterName = PositionParameterNames[NumberIndex];
-				MeshMID->SetVectorParameterValue(PositionParameterName, RGBAPositionParameter);
-
-				const float DistanceFromCameraToNumber = (CameraTransform.GetLocation() - NumberLocation).Size();
-				const float DistanceSpriteScale = DistanceFromCameraBeforeDoublingSize == 0.f ? 1.f : FMath::Clamp(DistanceFromCameraToNumber / DistanceFromCameraBeforeDoublingSize, 1.f, 1000000000.f);
-
-				const float ScaleToZeroMultiplier = (NumberIndex < HitNumberArrayLength) && (((NumberIndex == 0) && bShouldShowSign) || (NumberIndex != 0)) ? 1.f : 0.f;
+	using namespace UltraNumberPopCustomData;
 
-				const float HitSizeMultiplier = Request.bIsCriticalHit ? CriticalHitSizeMultiplier : 1.f;
-				const float FontSizeMultiplier = HitSizeMultiplier * DistanceSpriteScale * ScaleToZeroMultiplier;
+	const int32 NumDigitSlots = GetNumDigitSlots();
 
-				FLinearColor RGBAScaleRotationParameter;
-				RGBAScaleRotationParameter.R = FontXSize * FontSizeMultiplier;
-				RGBAScaleRotationParameter.G = FontYSize * FontSizeMultiplier;
-				RGBAScaleRotationParameter.B = NewHitNumberInfo.HitNumberArray[FMath::Min(HitNumberArrayLength - 1, NumberIndex)];
-				RGBAScaleRotationParameter.A = FMath::Sign(CameraSpaceDirection.X) * NumberOfNumberRotations;
+	// Split the number into digits, most significant first, writing straight into the glyph slots.
+	// Slot 0 is reserved for + or -, and numbers with more digits than we support show as all 9s
+	int32 NumberDigits = 1;
+	for (int32 Remaining = Pop.NumberToDisplay / 10; Remaining > 0; Remaining /= 10)
+	{
+		++NumberDigits;
+	}
 
-				const FName ScaleRotationAngleParameterName = ScaleRotationAngleParameterNames[NumberIndex];
-				MeshMID->SetVectorParameterValue(ScaleRotationAngleParameterName, RGBAScaleRotationParameter);
+	const int32 HitNumberArrayLength = FMath::Min(NumberDigits + 1, NumDigitSlots);
+	const bool bClampedToMax = (NumberDigits + 1) > NumDigitSlots;
 
-				FLinearColor RGBADurationParameter;
-				RGBADurationParameter.R = RealGameTime + ComponentLifespan;
-				RGBADurationParameter.G = FMath::FRand();
+	int32 Digits[UltraNumberPop::MaxDigitSlots];
+	Digits[0] = 0;
+	{
+		int32 LocalHit = FMath::Max(Pop.NumberToDisplay, 0);
+		for (int32 DigitIndex = HitNumberArrayLength - 1; DigitIndex > 0; --DigitIndex)
+		{
+			Digits[DigitIndex] = bClampedToMax ? 9 : (LocalHit % 10);
+			LocalHit /= 10;
+		}
+	}
 
-				const FName DurationParameterName = DurationParameterNames[NumberIndex];
-				MeshMID->SetVectorParameterValue(DurationParameterName, RGBADurationParameter);
-			}
+	// Determine the position
+	FVector NumberLocation(Pop.WorldLocation);
+	{
+		const float RandomMagnitude = 5.0f; //@TODO: Make this style driven
+		NumberLocation += FMath::RandPointInBox(FBox(FVector(-RandomMagnitude), FVector(RandomMagnitude)));
+	}
 
-			// Non-gameplay cameras while spectating have more cinematic values of aperture as default.
-			// This makes hit numbers very blurry as they are brought close to the camera, and away from the point of focus.
-			// Disable the shifting of numbers towards the camera here, if in a cinematic spectator camera.
-			//@TODO: Determine whether or not we are spectating
-			const bool bIsSpectating = false;
-			MeshMID->SetScalarParameterValue(MoveToCameraParameterName, bIsSpectating ? 0.0f : 1.0f);
-		}
+	const float DistanceFromCameraToNumber = (CameraTransform.GetLocation() - NumberLocation).Size();
+	const float DistanceSpriteScale = DistanceFromCameraBeforeDoublingSize == 0.f ? 1.f : FMath::Clamp(DistanceFromCameraToNumber / DistanceFromCameraBeforeDoublingSize, 1.f, 1000000000.f);
+	const float HitSizeMultiplier = Pop.bIsCriticalHit ? CriticalHitSizeMultiplier : 1.f;
+	const float FontSizeMultiplier = HitSizeMultiplier * DistanceSpriteScale;
+
+	// Whether we should show a sign as the first digit
+	const bool bShouldShowSign = false;
+
+	// Non-gameplay cameras while spectating have more cinematic values of aperture as default.
+	// This makes hit numbers very blurry as they are brought close to the camera, and away from the point of focus.
+	// Disable the shifting of numbers towards the camera here, if in a cinematic spectator camera.
+	//@TODO: Determine whether or not we are spectating
+	const bool bIsSpectating = false;
+
+	float* CustomData = CustomDataScratch.GetData();
+	CustomData[ColorR] = Pop.Color.R;
+	CustomData[ColorG] = Pop.Color.G;
+	CustomData[ColorB] = Pop.Color.B;
+	CustomData[IsCriticalHit] = Pop.bIsCriticalHit ? 1.f : 0.f;
+	CustomData[ExpireTime] = RealGameTime + ComponentLifespan;
+	CustomData[AnimationLifespan] = ComponentLifespan;
+	CustomData[ScaleX] = FontXSize * FontSizeMultiplier;
+	CustomData[ScaleY] = FontYSize * FontSizeMultiplier;
+	CustomData[NumberOfRotations] = NumberOfNumberRotations;
+	CustomData[MoveToCamera] = bIsSpectating ? 0.0f : 1.0f;
+	CustomData[RandomSeed] = FMath::FRand();
+	CustomData[NumDigits] = bShouldShowSign ? HitNumberArrayLength : (HitNumberArrayLength - 1);
+
+	// Horizontal offset of each glyph in font widths, narrowing the gap around ones
+	float OffsetAccumulatedValue = (HitNumberArrayLength * -1.f) + (bShouldShowSign ? 0.f : -1.f);
+	for (int32 DigitSlot = 0; DigitSlot < NumDigitSlots; ++DigitSlot)
+	{
+		const bool bIsUsedSlot = DigitSlot < HitNumberArrayLength;
+		const float SpacingForNumber = (bIsUsedSlot && ((Digits[DigitSlot] == 1) || ((DigitSlot > 0) && (Digits[DigitSlot - 1] == 1)))) ? SpacingPercentageForOnes : 1.f;
+		OffsetAccumulatedValue += SpacingForNumber;
+
+		// Unused slots get a negative glyph so the material can collapse them
+		const bool bIsVisibleSlot = bIsUsedSlot && ((DigitSlot != 0) || bShouldShowSign);
+		CustomData[FirstDigit + (DigitSlot * FloatsPerDigit) + 0] = bIsVisibleSlot ? Digits[DigitSlot] : -1.f;
+		CustomData[FirstDigit + (DigitSlot * FloatsPerDigit) + 1] = OffsetAccumulatedValue;
 	}
+
+	// Face the camera, the material uses the instance orientation to spread the digits out
+	const FTransform InstanceTransform(CameraTransform.GetRotation(), NumberLocation);
+	Batch.Component->UpdateInstanceTransform(InstanceIndex, InstanceTransform, /*bWorldSpace=*/ true, /*bMarkRenderStateDirty=*/ false, /*bTeleport=*/ true);
+	Batch.Component->SetCustomData(InstanceIndex, MakeArrayView(CustomDataScratch), /*bMarkRenderStateDirty=*/ false);
+	Batch.bRenderStateDirty = true;
 }
 
+int32 UUltraNumberPopComponent_MeshText::GetNumDigitSlots() const
+{
+	return FMath::Clamp(MaxDigitSlots, 2, UltraNumberPop::MaxDigitSlots);
+}
@@ -7,55 +7,84 @@
 #include "UltraNumberPopComponent_MeshText.generated.h"
 
 class UUltraHitPopStyle;
-class UMaterialInstanceDynamic;
+class UInstancedStaticMeshComponent;
 class UObject;
 class UStaticMesh;
-class UStaticMeshComponent;
 
-USTRUCT()
-struct FPooledNumberPopComponentList
+/**
+ * Layout of the per-instance custom data written for each number pop.
+ * The style text mesh materials must read these with PerInstanceCustomData nodes, followed by a (Glyph, Offset) pair per digit slot
+ * (slot 0 is reserved for the +/- sign).
+ */
+namespace UltraNumberPopCustomData
 {
-	GENERATED_BODY()
-
-	UPROPERTY(transient)
-	TArray<TObjectPtr<UStaticMeshComponent>> Components;
-};
+	enum Type : int32
+	{
+		ColorR,
+		ColorG,
+		ColorB,
+		IsCriticalHit,
+		ExpireTime,
+		AnimationLifespan,
+		ScaleX,
+		ScaleY,
+		NumberOfRotations,
+		MoveToCamera,
+		RandomSeed,
+		NumDigits,
+
+		FirstDigit,
+		FloatsPerDigit = 2
+	};
+}
 
 USTRUCT()
-struct FLiveNumberPopEntry
+struct FLiveNumberPopInstance
 {
 	GENERATED_BODY()
 
-	/** The component that is currently live */
-	UPROPERTY(transient)
-	TObjectPtr<UStaticMeshComponent> Component = nullptr;
-
-	/** The pool this component will go into when released */
-	FPooledNumberPopComponentList* Pool = nullptr;
+	/** The instance in the batch's component that is showing this pop */
+	int32 InstanceIndex = INDEX_NONE;
 
-	/** The world time that this component will be released to the pool */
+	/** The world time that this instance will be hidden and returned to the free list */
 	float ReleaseTime = 0.0f;
 
-	FLiveNumberPopEntry()
+	FLiveNumberPopInstance()
 	{}
 
-	FLiveNumberPopEntry(UStaticMeshComponent* InComponent, FPooledNumberPopComponentList* InPool, float InReleaseTime)
-		: Component(InComponent), Pool(InPool), ReleaseTime(InReleaseTime)
+	FLiveNumberPopInstance(int32 InInstanceIndex, float InReleaseTime)
+		: InstanceIndex(InInstanceIndex), ReleaseTime(InReleaseTime)
 	{}
 };
 
-/** Struct that holds the info for a new hit number */
-struct FTempNumberPopInfo
+/** All number pops using the same text mesh, drawn by a single instanced component */
+USTRUCT()
+struct FNumberPopInstanceBatch
 {
-	UStaticMeshComponent* StaticMeshComponent = nullptr;
+	GENERATED_BODY()
 
-	TArray<UMaterialInstanceDynamic*> MeshMIDs;
+	UPROPERTY(transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Component = nullptr;
 
-	TArray<int32> HitNumberArray;
-};
+	/** Instances that are currently hidden and can be claimed by a new pop */
+	TArray<int32> FreeInstances;
 
+	/** Instances that are showing a pop, in chronological order */
+	TArray<FLiveNumberPopInstance> LiveInstances;
 
+	/** True when instance data changed this frame and the render state needs to be refreshed */
+	bool bRenderStateDirty = false;
+};
 
+/** A pop requested this frame, laid out into its batch on the next tick */
+struct FPendingNumberPop
+{
+	UStaticMesh* Mesh = nullptr;
+	FVector WorldLocation = FVector::ZeroVector;
+	FLinearColor Color = FLinearColor::White;
+	int32 NumberToDisplay = 0;
+	bool bIsCriticalHit = false;
+};
 
 UCLASS(Blueprintable)
 class UUltraNumberPopComponent_MeshText : public UUltraNumberPopComponent
@@ -70,15 +99,26 @@ public:
 	virtual void AddNumberPop(const FUltraNumberPopRequest& NewRequest) override;
 	//~End of UUltraNumberPopComponent interface
 
+	//~UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~End of UActorComponent interface
+
 protected:
-	void SetMaterialParameters(const FUltraNumberPopRequest& Request, FTempNumberPopInfo& NewHitNumberInfo, const FTransform& CameraTransform, const FVector& NumberLocation);
+	/** Writes the pop's transform and custom data into the given instance */
+	void LayoutNumberPop(const FPendingNumberPop& Pop, FNumberPopInstanceBatch& Batch, int32 InstanceIndex, const FTransform& CameraTransform, float RealGameTime);
 
 	FLinearColor DetermineColor(const FUltraNumberPopRequest& Request) const;
 	UStaticMesh* DetermineStaticMesh(const FUltraNumberPopRequest& Request) const;
 
+	/** Returns the batch for the mesh, creating and prewarming its instanced component if needed */
+	FNumberPopInstanceBatch& FindOrCreateBatch(UStaticMesh* Mesh);
 
-	/** Releases components back to the pool that have exceeded their lifespan */
-	void ReleaseNextComponents();
+	/** Hides instances that have exceeded their lifespan and returns them to the free list */
+	void ReleaseExpiredInstances(FNumberPopInstanceBatch& Batch, float CurrentTime);
+
+	/** MaxDigitSlots limited to what the layout supports */
+	int32 GetNumDigitSlots() const;
 
 	/** Style patterns to attempt to apply to the incoming number pops */
 	UPROPERTY(EditDefaultsOnly, Category="Number Pop|Style")
@@ -89,7 +129,7 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
 	float DistanceFromCameraBeforeDoublingSize;
-	
+
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
 	float CriticalHitSizeMultiplier;
 
@@ -105,36 +145,20 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
 	float NumberOfNumberRotations;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	FName SignDigitParameterName;
-
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	FName ColorParameterName;
+	/** Number of digit slots (including the sign slot) written to the per-instance custom data, larger numbers are clamped to all 9s */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings", meta=(ClampMin=2, ClampMax=32))
+	int32 MaxDigitSlots;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	FName AnimationLifespanParameterName;
-
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	FName IsCriticalHitParameterName;
-
-	/** Hit numbers by default are given a depth close to the camera in the material to make sure they are never occluded. This can be toggled off here, should only be 0/1. */
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	FName MoveToCameraParameterName;
-
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	TArray<FName> PositionParameterNames;
-
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	TArray<FName> ScaleRotationAngleParameterNames;
-
-	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Material Bindings")
-	TArray<FName> DurationParameterNames;
+	/** Number of instances allocated up front for each style mesh, the oldest live pop is recycled once these are exhausted */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style", meta=(ClampMin=1))
+	int32 InstanceBudgetPerMesh;
 
 	UPROPERTY(Transient)
-	TMap<TObjectPtr<UStaticMesh>, FPooledNumberPopComponentList> PooledComponentMap;
+	TMap<TObjectPtr<UStaticMesh>, FNumberPopInstanceBatch> InstanceBatches;
 
-	UPROPERTY(transient)
-	TArray<FLiveNumberPopEntry> LiveComponents;
+	/** Pops requested since the last tick */
+	TArray<FPendingNumberPop> PendingPops;
 
-	FTimerHandle ReleaseTimerHandle;
+	/** Reused buffer for building one instance's custom data */
+	TArray<float> CustomDataScratch;
 };
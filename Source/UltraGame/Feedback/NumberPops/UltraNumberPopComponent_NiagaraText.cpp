@@ -2,7 +2,13 @@
 
 #include "UltraNumberPopComponent_NiagaraText.h"
 
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "Feedback/NumberPops/UltraNumberPopComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "UltraHitPopStyleNiagara.h"
 #include "UltraLogChannels.h"
 #include "NiagaraComponent.h"
@@ -10,11 +16,41 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraNumberPopComponent_NiagaraText)
 
+namespace UltraNumberPopCVars
+{
+	static bool bLogNumberPops = false;
+	static FAutoConsoleVariableRef CVarLogNumberPops(
+		TEXT("Ultra.NumberPops.Log"),
+		bLogNumberPops,
+		TEXT("Should each Niagara number pop be logged?"),
+		ECVF_Default);
+}
+
 UUltraNumberPopComponent_NiagaraText::UUltraNumberPopComponent_NiagaraText(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Only ticks while there are hits to upload or expire
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
 
+void UUltraNumberPopComponent_NiagaraText::CreateNiagaraComponentIfNeeded()
+{
+	//Add a NiagaraComponent if we don't already have one
+	if (!NiagaraComp)
+	{
+		NiagaraComp = NewObject<UNiagaraComponent>(GetOwner());
+		if (Style != nullptr)
+		{
+			NiagaraComp->SetAsset(Style->TextNiagara);
+			NiagaraComp->bAutoActivate = false;
 
+		}
+		NiagaraComp->SetupAttachment(nullptr);
+		check(NiagaraComp);
+		NiagaraComp->RegisterComponent();
+	}
 }
 
 void UUltraNumberPopComponent_NiagaraText::AddNumberPop(const FUltraNumberPopRequest& NewRequest)
@@ -27,30 +63,162 @@ void UUltraNumberPopComponent_NiagaraText::AddNumberPop(const FUltraNumberPopReq
 		LocalHit *= -1;
 	}
 
-	//Add a NiagaraComponent if we don't already have one
-	if (!NiagaraComp)
+	CreateNiagaraComponentIfNeeded();
+
+	UE_CLOG(UltraNumberPopCVars::bLogNumberPops, LogUltra, Log, TEXT("HitHit location : %s"), *(NewRequest.WorldLocation.ToString()));
+
+	const int32 Capacity = FMath::Max(MaxLiveNumberPops, 1);
+	if (LiveHits.Num() != Capacity)
 	{
-		NiagaraComp = NewObject<UNiagaraComponent>(GetOwner());
-		if (Style != nullptr)
+		LiveHits.SetNumZeroed(Capacity);
+		LiveHitSpawnTimes.SetNumZeroed(Capacity);
+		LiveHitsHead = 0;
+		NumLiveHits = 0;
+	}
+
+	int32 Slot;
+	if (NumLiveHits < Capacity)
+	{
+		Slot = (LiveHitsHead + NumLiveHits) % Capacity;
+		++NumLiveHits;
+	}
+	else
+	{
+		// Full, overwrite the oldest hit
+		Slot = LiveHitsHead;
+		LiveHitsHead = (LiveHitsHead + 1) % Capacity;
+	}
+
+	//Hit information is packed inside a FVector4 where XYZ = Position, W = Hit
+	LiveHits[Slot] = FVector4(NewRequest.WorldLocation.X, NewRequest.WorldLocation.Y, NewRequest.WorldLocation.Z, LocalHit);
+	LiveHitSpawnTimes[Slot] = GetWorld()->GetTimeSeconds();
+	++NumHitsWritten;
+
+	bNeedsArrayUpload = true;
+	bNeedsRingUpload = true;
+	SetComponentTickEnabled(true);
+}
+
+void UUltraNumberPopComponent_NiagaraText::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushNumberPops();
+}
+
+void UUltraNumberPopComponent_NiagaraText::FlushNumberPops()
+{
+	// Hits are written in time order, so the expired ones are at the head of the ring
+	const int32 Capacity = LiveHits.Num();
+	const double ExpireBefore = GetExpireBeforeTime(GetWorld()->GetTimeSeconds());
+	while ((NumLiveHits > 0) && (LiveHitSpawnTimes[LiveHitsHead] < ExpireBefore))
+	{
+		LiveHitsHead = (LiveHitsHead + 1) % Capacity;
+		--NumLiveHits;
+		bNeedsRingUpload = true;
+	}
+
+	if ((NiagaraComp != nullptr) && (Style != nullptr))
+	{
+		if (bNeedsArrayUpload)
 		{
-			NiagaraComp->SetAsset(Style->TextNiagara);
-			NiagaraComp->bAutoActivate = false;
-			
+			NiagaraComp->Activate(false);
+			NiagaraComp->SetWorldLocation(FVector(LiveHits[(LiveHitsHead + NumLiveHits + Capacity - 1) % Capacity]));
+
+			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName, LiveHits);
 		}
-		NiagaraComp->SetupAttachment(nullptr);
-		check(NiagaraComp);
-		NiagaraComp->RegisterComponent();
-	}
 
+		if (bNeedsRingUpload)
+		{
+			NiagaraComp->SetVariableInt(Style->RingHeadParameterName, LiveHitsHead);
+			NiagaraComp->SetVariableInt(Style->RingCountParameterName, NumLiveHits);
+			NiagaraComp->SetVariableInt(Style->RingWriteCountParameterName, NumHitsWritten);
+		}
+	}
+	bNeedsArrayUpload = false;
+	bNeedsRingUpload = false;
 
-	NiagaraComp->Activate(false);
-	NiagaraComp->SetWorldLocation(NewRequest.WorldLocation);
+	if (NumLiveHits == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
 
-	UE_LOG(LogUltra, Log, TEXT("HitHit location : %s"), *(NewRequest.WorldLocation.ToString()));
-	//Add Hit information to the current Niagara list - Hit information is packed inside a FVector4 where XYZ = Position, W = Hit
-	TArray<FVector4> HitList = UNiagaraDataInterfaceArrayFunctionLibrary::GetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName);
-	HitList.Add(FVector4(NewRequest.WorldLocation.X, NewRequest.WorldLocation.Y, NewRequest.WorldLocation.Z, LocalHit));
-	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName, HitList);
-	
+double UUltraNumberPopComponent_NiagaraText::GetExpireBeforeTime(double CurrentTime) const
+{
+	return CurrentTime - ((Style != nullptr) ? Style->HitLifetime : 0.0f);
 }
 
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs GUltraNumberPopStressTestCmd(
+	TEXT("Ultra.NumberPops.StressTest"),
+	TEXT("Fires number pops through the local player's Niagara number pop component and reports the CPU cost per pop. Usage: Ultra.NumberPops.StressTest [PopsPerSecond=5000] [Seconds=5]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World)
+{
+	const int32 PopsPerSecond = (Params.Num() > 0) ? FMath::Max(FCString::Atoi(*Params[0]), 1) : 5000;
+	const double DurationSeconds = (Params.Num() > 1) ? FMath::Max(FCString::Atod(*Params[1]), 0.1) : 5.0;
+
+	APlayerController* PC = World ? GEngine->GetFirstLocalPlayerController(World) : nullptr;
+	UUltraNumberPopComponent_NiagaraText* PopComponent = PC ? PC->FindComponentByClass<UUltraNumberPopComponent_NiagaraText>() : nullptr;
+	if (PopComponent == nullptr)
+	{
+		UE_LOG(LogUltra, Error, TEXT("Ultra.NumberPops.StressTest: the local player controller has no Niagara number pop component"));
+		return;
+	}
+
+	struct FStressState
+	{
+		TWeakObjectPtr<UUltraNumberPopComponent_NiagaraText> Component;
+		double StartTime = 0.0;
+		double PopBudget = 0.0;
+		double CpuSeconds = 0.0;
+		int64 NumPops = 0;
+		int32 PeakLive = 0;
+	};
+
+	TSharedRef<FStressState> StressState = MakeShared<FStressState>();
+	StressState->Component = PopComponent;
+	StressState->StartTime = FPlatformTime::Seconds();
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([StressState, PopsPerSecond, DurationSeconds](float DeltaTime)
+	{
+		UUltraNumberPopComponent_NiagaraText* Component = StressState->Component.Get();
+		const bool bFinished = (Component == nullptr) || ((FPlatformTime::Seconds() - StressState->StartTime) >= DurationSeconds);
+		if (bFinished)
+		{
+			const double MicrosecondsPerPop = (StressState->NumPops > 0) ? (StressState->CpuSeconds * 1000000.0 / StressState->NumPops) : 0.0;
+			UE_LOG(LogUltra, Display, TEXT("Ultra.NumberPops.StressTest: %lld pops, %.3f ms total CPU, %.3f us per pop (including flushes), peak %d live"),
+				StressState->NumPops, StressState->CpuSeconds * 1000.0, MicrosecondsPerPop, StressState->PeakLive);
+			return false;
+		}
+
+		StressState->PopBudget += PopsPerSecond * DeltaTime;
+		const int32 PopsThisFrame = FMath::FloorToInt(StressState->PopBudget);
+		StressState->PopBudget -= PopsThisFrame;
+
+		const APawn* Pawn = Component->GetPawn<APawn>();
+		const FVector Origin = Pawn ? Pawn->GetActorLocation() : FVector::ZeroVector;
+
+		const double FrameStart = FPlatformTime::Seconds();
+		for (int32 PopIndex = 0; PopIndex < PopsThisFrame; ++PopIndex)
+		{
+			FUltraNumberPopRequest Request;
+			Request.WorldLocation = Origin + FMath::VRand() * FMath::FRandRange(100.0, 1000.0);
+			Request.NumberToDisplay = FMath::RandRange(1, 200);
+			Request.bIsCriticalHit = FMath::RandBool();
+			Component->AddNumberPop(Request);
+		}
+		Component->FlushNumberPops();
+		StressState->CpuSeconds += FPlatformTime::Seconds() - FrameStart;
+
+		StressState->NumPops += PopsThisFrame;
+		StressState->PeakLive = FMath::Max(StressState->PeakLive, Component->GetNumLiveNumberPops());
+		return true;
+	}));
+}));
+
+#endif
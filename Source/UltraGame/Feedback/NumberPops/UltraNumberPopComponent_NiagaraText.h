@@ -23,8 +23,18 @@ public:
 	virtual void AddNumberPop(const FUltraNumberPopRequest& NewRequest) override;
 	//~End of UUltraNumberPopComponent interface
 
+	//~UActorComponent interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~End of UActorComponent interface
+
+	/** Expires old hits and uploads the ring of hits to Niagara if it changed, normally done once per frame from the tick */
+	void FlushNumberPops();
+
+	/** Number of live hits currently held in the ring */
+	int32 GetNumLiveNumberPops() const { return NumLiveHits; }
+
 protected:
-	
+
 	TArray<int32> HitNumberArray;
 
 	/** Style patterns to attempt to apply to the incoming number pops */
@@ -34,4 +44,35 @@ protected:
 	//Niagara Component used to display the hit
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
 	TObjectPtr<UNiagaraComponent> NiagaraComp;
+
+	/** Capacity of the hit ring, the oldest hit is overwritten when a new one arrives while full */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style", meta=(ClampMin=1))
+	int32 MaxLiveNumberPops = 128;
+
+private:
+	void CreateNiagaraComponentIfNeeded();
+
+	double GetExpireBeforeTime(double CurrentTime) const;
+
+	// Fixed-capacity ring of hits, XYZ = Position, W = Hit. Uploaded whole to the Niagara array, which reads it modulo its length
+	// starting at LiveHitsHead, so adding or expiring a hit never moves the others.
+	TArray<FVector4> LiveHits;
+
+	// Spawn time of each slot in LiveHits
+	TArray<double> LiveHitSpawnTimes;
+
+	// Slot of the oldest live hit
+	int32 LiveHitsHead = 0;
+
+	// Number of live hits starting at LiveHitsHead
+	int32 NumLiveHits = 0;
+
+	// Number of hits ever written to the ring, lets the Niagara system find the slots written since it last read them
+	int32 NumHitsWritten = 0;
+
+	// True when a slot of LiveHits changed since the last upload
+	bool bNeedsArrayUpload = false;
+
+	// True when the head or count changed since the last upload
+	bool bNeedsRingUpload = false;
 };
@@ -4,14 +4,35 @@
 #include "Engine/GameInstance.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "AbilitySystem/UltraAbilitySystemComponent.h"
+#include "AbilitySystem/Attributes/UltraAttributeInitCache.h"
 #include "Engine/World.h"
 #include "Player/UltraPlayerState.h" //@TODO: For the fname
 #include "GameFeatures/GameFeatureAction_WorldActionBase.h"
+#include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddAbilities)
 
 #define LOCTEXT_NAMESPACE "GameFeatures"
 
+namespace UltraAddAbilities
+{
+	static bool bBatchGrants = true;
+	static FAutoConsoleVariableRef CVarBatchGrants(
+		TEXT("Ultra.GameFeatures.AddAbilities.Batched"),
+		bBatchGrants,
+		TEXT("If true, abilities granted by game features are loaded asynchronously on activation and granted in a time sliced pass. If false, each actor loads and grants synchronously as it becomes ready."),
+		ECVF_Default);
+
+	static float GrantBudgetMs = 1.0f;
+	static FAutoConsoleVariableRef CVarGrantBudgetMs(
+		TEXT("Ultra.GameFeatures.AddAbilities.BudgetMs"),
+		GrantBudgetMs,
+		TEXT("Milliseconds per frame spent granting abilities to waiting actors (at least one actor is granted per frame, <= 0 grants everything at once)."),
+		ECVF_Default);
+};
+
 //////////////////////////////////////////////////////////////////////
 // UGameFeatureAction_AddAbilities
 
@@ -24,6 +45,12 @@ void UGameFeatureAction_AddAbilities::OnGameFeatureActivating(FGameFeatureActiva
 	{
 		Reset(ActiveData);
 	}
+
+	if (UltraAddAbilities::bBatchGrants)
+	{
+		LoadReferencedAssets(Context, ActiveData);
+	}
+
 	Super::OnGameFeatureActivating(Context);
 }
 
@@ -128,6 +155,27 @@ void UGameFeatureAction_AddAbilities::AddToWorld(const FWorldContext& WorldConte
 
 void UGameFeatureAction_AddAbilities::Reset(FPerContextData& ActiveData)
 {
+	ActiveData.PendingActors.Empty();
+	if (ActiveData.PendingActorsTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ActiveData.PendingActorsTickerHandle);
+		ActiveData.PendingActorsTickerHandle.Reset();
+	}
+
+	if (ActiveData.AssetLoadHandle.IsValid())
+	{
+		if (ActiveData.AssetLoadHandle->HasLoadCompleted())
+		{
+			ActiveData.AssetLoadHandle->ReleaseHandle();
+		}
+		else
+		{
+			ActiveData.AssetLoadHandle->CancelHandle();
+		}
+		ActiveData.AssetLoadHandle.Reset();
+	}
+	ActiveData.bAssetsLoaded = false;
+
 	while (!ActiveData.ActiveExtensions.IsEmpty())
 	{
 		auto ExtensionIt = ActiveData.ActiveExtensions.CreateIterator();
@@ -137,6 +185,126 @@ void UGameFeatureAction_AddAbilities::Reset(FPerContextData& ActiveData)
 	ActiveData.ComponentRequests.Empty();
 }
 
+void UGameFeatureAction_AddAbilities::LoadReferencedAssets(const FGameFeatureStateChangeContext& ChangeContext, FPerContextData& ActiveData)
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		for (const FUltraAbilityGrant& Ability : Entry.GrantedAbilities)
+		{
+			if (!Ability.AbilityType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Ability.AbilityType.ToSoftObjectPath());
+			}
+		}
+
+		for (const FUltraAttributeSetGrant& Attributes : Entry.GrantedAttributes)
+		{
+			if (!Attributes.AttributeSetType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.AttributeSetType.ToSoftObjectPath());
+			}
+			if (!Attributes.InitializationData.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.InitializationData.ToSoftObjectPath());
+			}
+		}
+
+		for (const TSoftObjectPtr<const UUltraAbilitySet>& SetPtr : Entry.GrantedAbilitySets)
+		{
+			if (!SetPtr.IsNull())
+			{
+				AssetsToLoad.AddUnique(SetPtr.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (AssetsToLoad.IsEmpty())
+	{
+		ActiveData.bAssetsLoaded = true;
+		return;
+	}
+
+	ActiveData.bAssetsLoaded = false;
+	ActiveData.AssetLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetsToLoad),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnReferencedAssetsLoaded, ChangeContext), FStreamableManager::AsyncLoadHighPriority);
+
+	if (!ActiveData.AssetLoadHandle.IsValid())
+	{
+		UE_LOG(LogGameFeatures, Warning, TEXT("%s: failed to start loading the granted abilities, actors will load them synchronously."), *GetPathName());
+		ActiveData.bAssetsLoaded = true;
+	}
+}
+
+void UGameFeatureAction_AddAbilities::OnReferencedAssetsLoaded(FGameFeatureStateChangeContext ChangeContext)
+{
+	if (FPerContextData* ActiveData = ContextData.Find(ChangeContext))
+	{
+		// Bake the init tables now rather than on the first actor that needs them
+		for (const FGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+		{
+			for (const FUltraAttributeSetGrant& Attributes : Entry.GrantedAttributes)
+			{
+				TSubclassOf<UAttributeSet> SetType = Attributes.AttributeSetType.Get();
+				const UDataTable* InitData = Attributes.InitializationData.Get();
+				if (SetType && InitData)
+				{
+					FUltraAttributeInitCache::Get().FindOrBake(SetType, InitData);
+				}
+			}
+		}
+
+		ActiveData->bAssetsLoaded = true;
+		SchedulePendingActors(ChangeContext, *ActiveData);
+	}
+}
+
+void UGameFeatureAction_AddAbilities::SchedulePendingActors(const FGameFeatureStateChangeContext& ChangeContext, FPerContextData& ActiveData)
+{
+	if (ActiveData.bAssetsLoaded && !ActiveData.PendingActors.IsEmpty() && !ActiveData.PendingActorsTickerHandle.IsValid())
+	{
+		ActiveData.PendingActorsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::ProcessPendingActors, ChangeContext));
+	}
+}
+
+bool UGameFeatureAction_AddAbilities::ProcessPendingActors(float DeltaTime, FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		return false;
+	}
+
+	const double BudgetSeconds = UltraAddAbilities::GrantBudgetMs / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Pop one at a time, granting can send extension events that add to or remove from the pending list
+	while (!ActiveData->PendingActors.IsEmpty())
+	{
+		const FPendingActorGrant Pending = ActiveData->PendingActors[0];
+		ActiveData->PendingActors.RemoveAt(0, 1, /*bAllowShrinking=*/ false);
+
+		AActor* Actor = Pending.Actor.Get();
+		if ((Actor != nullptr) && AbilitiesList.IsValidIndex(Pending.EntryIndex))
+		{
+			AddActorAbilities(Actor, AbilitiesList[Pending.EntryIndex], *ActiveData);
+		}
+
+		if ((BudgetSeconds > 0.0) && ((FPlatformTime::Seconds() - StartTime) >= BudgetSeconds))
+		{
+			break;
+		}
+	}
+
+	if (ActiveData->PendingActors.IsEmpty())
+	{
+		ActiveData->PendingActorsTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
 void UGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext)
 {
 	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
@@ -145,11 +313,24 @@ void UGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, FName
 		const FGameFeatureAbilitiesEntry& Entry = AbilitiesList[EntryIndex];
 		if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) || (EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 		{
+			ActiveData->PendingActors.RemoveAll([Actor](const FPendingActorGrant& Pending) { return Pending.Actor == Actor; });
 			RemoveActorAbilities(Actor, *ActiveData);
 		}
 		else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == AUltraPlayerState::NAME_UltraAbilityReady))
 		{
-			AddActorAbilities(Actor, Entry, *ActiveData);
+			if (UltraAddAbilities::bBatchGrants && ActiveData->AssetLoadHandle.IsValid())
+			{
+				// Granted from ProcessPendingActors once the assets are in, so a feature activating mid-match doesn't load and grant everything in one frame
+				if (Actor->HasAuthority() && !ActiveData->ActiveExtensions.Contains(Actor))
+				{
+					ActiveData->PendingActors.Add({ Actor, EntryIndex });
+					SchedulePendingActors(ChangeContext, *ActiveData);
+				}
+			}
+			else
+			{
+				AddActorAbilities(Actor, Entry, *ActiveData);
+			}
 		}
 	}
 }
@@ -179,6 +360,7 @@ void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGa
 		{
 			if (!Ability.AbilityType.IsNull())
 			{
+				// Only a lookup when LoadReferencedAssets already brought the class in
 				FGameplayAbilitySpec NewAbilitySpec(Ability.AbilityType.LoadSynchronous());
 				FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->GiveAbility(NewAbilitySpec);
 
@@ -199,7 +381,7 @@ void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGa
 						UDataTable* InitData = Attributes.InitializationData.LoadSynchronous();
 						if (InitData)
 						{
-							NewSet->InitFromMetaDataTable(InitData);
+							FUltraAttributeInitCache::Get().InitAttributeSet(NewSet, InitData);
 						}
 					}
 
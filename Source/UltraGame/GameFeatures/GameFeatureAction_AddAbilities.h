@@ -5,6 +5,7 @@
 #include "GameFeatureAction_WorldActionBase.h"
 #include "Abilities/GameplayAbility.h"
 #include "AbilitySystem/UltraAbilitySet.h"
+#include "Containers/Ticker.h"
 
 #include "GameFeatureAction_AddAbilities.generated.h"
 
@@ -13,6 +14,7 @@ class UInputAction;
 class UAttributeSet;
 class UDataTable;
 struct FComponentRequestHandle;
+struct FStreamableHandle;
 class UUltraAbilitySet;
 
 USTRUCT(BlueprintType)
@@ -70,6 +72,9 @@ struct FGameFeatureAbilitiesEntry
 
 /**
  * GameFeatureAction responsible for granting abilities (and attributes) to actors of a specified type.
+ *
+ * Every referenced ability, attribute set, init table and ability set is loaded asynchronously once when the feature activates.
+ * Actors that become ready are queued and granted in a time sliced pass (see Ultra.GameFeatures.AddAbilities.BudgetMs) once that load completes.
  */
 UCLASS(MinimalAPI, meta = (DisplayName = "Add Abilities"))
 class UGameFeatureAction_AddAbilities final : public UGameFeatureAction_WorldActionBase
@@ -100,10 +105,24 @@ private:
 		TArray<FUltraAbilitySet_GrantedHandles> AbilitySetHandles;
 	};
 
+	struct FPendingActorGrant
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 EntryIndex = INDEX_NONE;
+	};
+
 	struct FPerContextData
 	{
 		TMap<AActor*, FActorExtensions> ActiveExtensions;
 		TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
+
+		// Keeps everything referenced by AbilitiesList loaded while the feature is active
+		TSharedPtr<FStreamableHandle> AssetLoadHandle;
+		bool bAssetsLoaded = false;
+
+		// Actors waiting for the asset load or for their turn in the time sliced grant pass
+		TArray<FPendingActorGrant> PendingActors;
+		FTSTicker::FDelegateHandle PendingActorsTickerHandle;
 	};
 	
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;	
@@ -113,6 +132,10 @@ private:
 	//~ End UGameFeatureAction_WorldActionBase interface
 
 	void Reset(FPerContextData& ActiveData);
+	void LoadReferencedAssets(const FGameFeatureStateChangeContext& ChangeContext, FPerContextData& ActiveData);
+	void OnReferencedAssetsLoaded(FGameFeatureStateChangeContext ChangeContext);
+	void SchedulePendingActors(const FGameFeatureStateChangeContext& ChangeContext, FPerContextData& ActiveData);
+	bool ProcessPendingActors(float DeltaTime, FGameFeatureStateChangeContext ChangeContext);
 	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext);
 	void AddActorAbilities(AActor* Actor, const FGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData);
 	void RemoveActorAbilities(AActor* Actor, FPerContextData& ActiveData);
@@ -46,6 +46,9 @@ public:
 	void Cheat_AddBot() { SpawnOneBot(); }
 	void Cheat_RemoveBot() { RemoveOneBot(); }
 
+	int32 GetNumSpawnedBots() const { return SpawnedBotList.Num(); }
+	const TArray<TObjectPtr<AAIController>>& GetSpawnedBots() const { return SpawnedBotList; }
+
 protected:
 	virtual void ServerCreateBots();
 
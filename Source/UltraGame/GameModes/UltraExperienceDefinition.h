@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
 #include "UltraExperienceDefinition.generated.h"
 
 class UGameFeatureAction;
@@ -42,6 +43,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
 	TObjectPtr<const UUltraPawnData> DefaultPawnData;
 
+	// If set, despawned characters are reset and kept in a pool to be reused by the next respawn instead of being destroyed
+	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
+	bool bRecycleDespawnedPawns = false;
+
+	// Maximum number of despawned characters kept per pawn class and pawn data when recycling is enabled
+	UPROPERTY(EditDefaultsOnly, Category=Gameplay, meta=(EditCondition="bRecycleDespawnedPawns", ClampMin=1))
+	int32 MaxPooledPawnsPerType = 8;
+
 	// List of actions to perform as this experience is loaded/activated/deactivated/unloaded
 	UPROPERTY(EditDefaultsOnly, Instanced, Category="Actions")
 	TArray<TObjectPtr<UGameFeatureAction>> Actions;
@@ -49,4 +58,9 @@ public:
 	// List of additional action sets to compose into this experience
 	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
 	TArray<TObjectPtr<UUltraExperienceActionSet>> ActionSets;
+
+	// Gameplay cues executed while playing this experience, preloaded as part of the experience load.
+	// Recorded by UUltraGameplayCueManager (see Ultra.GameplayCues.SaveManifest and Ultra.GameplayCues.ApplyManifestToExperience).
+	UPROPERTY(EditDefaultsOnly, Category=GameplayCues)
+	FGameplayTagContainer GameplayCueManifest;
 };
@@ -6,6 +6,7 @@
 #include "UltraExperienceDefinition.h"
 #include "UltraExperienceActionSet.h"
 #include "UltraExperienceManager.h"
+#include "AbilitySystem/UltraGameplayCueManager.h"
 #include "GameFeaturesSubsystem.h"
 #include "System/UltraAssetManager.h"
 #include "GameFeatureAction.h"
@@ -163,6 +164,17 @@ void UUltraExperienceManagerComponent::StartExperienceLoad()
 		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
 	}
 
+	// Load the gameplay cues this experience is known to execute with it instead of when they are first needed
+	if (bLoadClient)
+	{
+		if (UUltraGameplayCueManager* CueManager = UUltraGameplayCueManager::Get())
+		{
+			TArray<FSoftObjectPath> ManifestCuePaths;
+			CueManager->GetManifestCuePaths(CurrentExperience, /*out*/ ManifestCuePaths);
+			RawAssetList.Append(ManifestCuePaths);
+		}
+	}
+
 	TSharedPtr<FStreamableHandle> BundleLoadHandle = nullptr;
 	if (BundleAssetList.Num() > 0)
 	{
@@ -220,6 +232,14 @@ void UUltraExperienceManagerComponent::OnExperienceLoadComplete()
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
 
+	if (GIsEditor || (GetOwner()->GetNetMode() != NM_DedicatedServer))
+	{
+		if (UUltraGameplayCueManager* CueManager = UUltraGameplayCueManager::Get())
+		{
+			CueManager->OnExperienceLoaded(CurrentExperience);
+		}
+	}
+
 	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
 	GameFeaturePluginURLs.Reset();
 
@@ -391,6 +411,14 @@ void UUltraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPla
 		}
 	}
 
+	if (CurrentExperience != nullptr)
+	{
+		if (UUltraGameplayCueManager* CueManager = UUltraGameplayCueManager::Get())
+		{
+			CueManager->OnExperienceUnloaded(CurrentExperience);
+		}
+	}
+
 	//@TODO: Ensure proper handling of a partially-loaded state too
 	if (LoadState == EUltraExperienceLoadState::Loaded)
 	{
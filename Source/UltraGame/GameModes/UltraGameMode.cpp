@@ -16,6 +16,7 @@
 #include "UI/UltraHUD.h"
 #include "Character/UltraPawnExtensionComponent.h"
 #include "Character/UltraPawnData.h"
+#include "Character/UltraPawnPoolSubsystem.h"
 #include "GameModes/UltraWorldSettings.h"
 #include "GameModes/UltraExperienceDefinition.h"
 #include "GameModes/UltraExperienceManagerComponent.h"
@@ -207,34 +208,25 @@ void AUltraGameMode::HostDedicatedServerMatch(ECommonSessionOnlineMode OnlineMod
 		}
 	}
 
-	// Search for the matching experience, it's fine to force load them because we're in dedicated server startup
-	UUltraAssetManager& AssetManager = UUltraAssetManager::Get();
-	TSharedPtr<FStreamableHandle> Handle = AssetManager.LoadPrimaryAssetsWithType(UserExperienceType);
-	if (ensure(Handle.IsValid()))
-	{
-		Handle->WaitUntilComplete();
-	}
+	// Search for the matching experience in the user-facing info cooked into the asset registry, so no definitions are loaded just to pick one
+	const double StartTime = FPlatformTime::Seconds();
 
-	TArray<UObject*> UserExperiences;
-	AssetManager.GetPrimaryAssetObjectList(UserExperienceType, UserExperiences);
-	UUltraUserFacingExperienceDefinition* FoundExperience = nullptr;
-	UUltraUserFacingExperienceDefinition* DefaultExperience = nullptr;
+	TArray<FUltraUserFacingExperienceInfo> UserExperiences;
+	UUltraUserFacingExperienceDefinition::GetAllExperienceInfos(UserExperiences);
+	const FUltraUserFacingExperienceInfo* FoundExperience = nullptr;
+	const FUltraUserFacingExperienceInfo* DefaultExperience = nullptr;
 
-	for (UObject* Object : UserExperiences)
+	for (const FUltraUserFacingExperienceInfo& UserExperience : UserExperiences)
 	{
-		UUltraUserFacingExperienceDefinition* UserExperience = Cast<UUltraUserFacingExperienceDefinition>(Object);
-		if (ensure(UserExperience))
+		if (UserExperience.UserFacingExperienceID == UserExperienceId)
 		{
-			if (UserExperience->GetPrimaryAssetId() == UserExperienceId)
-			{
-				FoundExperience = UserExperience;
-				break;
-			}
-			
-			if (UserExperience->bIsDefaultExperience && DefaultExperience == nullptr)
-			{
-				DefaultExperience = UserExperience;
-			}
+			FoundExperience = &UserExperience;
+			break;
+		}
+
+		if (UserExperience.bIsDefaultExperience && DefaultExperience == nullptr)
+		{
+			DefaultExperience = &UserExperience;
 		}
 	}
 
@@ -242,6 +234,9 @@ void AUltraGameMode::HostDedicatedServerMatch(ECommonSessionOnlineMode OnlineMod
 	{
 		FoundExperience = DefaultExperience;
 	}
+
+	UE_LOG(LogUltraExperience, Log, TEXT("Dedicated server picked user facing experience %s out of %d in %.2fms"),
+		FoundExperience ? *FoundExperience->UserFacingExperienceID.ToString() : TEXT("(none)"), UserExperiences.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	
 	UGameInstance* GameInstance = GetGameInstance();
 	if (ensure(FoundExperience && GameInstance))
@@ -306,6 +301,11 @@ void AUltraGameMode::OnMatchAssignmentGiven(FPrimaryAssetId ExperienceId, const
 
 void AUltraGameMode::OnExperienceLoaded(const UUltraExperienceDefinition* CurrentExperience)
 {
+	if (UUltraPawnPoolSubsystem* PawnPool = UWorld::GetSubsystem<UUltraPawnPoolSubsystem>(GetWorld()))
+	{
+		PawnPool->ConfigurePool(CurrentExperience->bRecycleDespawnedPawns, CurrentExperience->MaxPooledPawnsPerType);
+	}
+
 	// Spawn any players that are already attached
 	//@TODO: Here we're handling only *player* controllers, but in GetDefaultPawnClassForController_Implementation we skipped all controllers
 	// GetDefaultPawnClassForController_Implementation might only be getting called for players anyways
@@ -353,6 +353,15 @@ APawn* AUltraGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* N
 
 	if (UClass* PawnClass = GetDefaultPawnClassForController(NewPlayer))
 	{
+		// Reuse a despawned pawn of the same type if the experience recycles them
+		if (UUltraPawnPoolSubsystem* PawnPool = UWorld::GetSubsystem<UUltraPawnPoolSubsystem>(GetWorld()))
+		{
+			if (APawn* RecycledPawn = PawnPool->AcquirePawn(PawnClass, GetPawnDataForController(NewPlayer), NewPlayer, SpawnTransform))
+			{
+				return RecycledPawn;
+			}
+		}
+
 		if (APawn* SpawnedPawn = GetWorld()->SpawnActor<APawn>(PawnClass, SpawnTransform, SpawnInfo))
 		{
 			if (UUltraPawnExtensionComponent* PawnExtComp = UUltraPawnExtensionComponent::FindPawnExtensionComponent(SpawnedPawn))
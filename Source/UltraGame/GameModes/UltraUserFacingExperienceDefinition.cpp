@@ -2,24 +2,187 @@
 
 #include "UltraUserFacingExperienceDefinition.h"
 
+#include "AssetRegistry/AssetData.h"
 #include "CommonSessionSubsystem.h"
 #include "CommonUISettings.h"
 #include "Containers/UnrealString.h"
+#include "Dom/JsonObject.h"
 #include "ICommonUIModule.h"
 #include "NativeGameplayTags.h"
+#include "Serialization/JsonSerializer.h"
+#include "System/UltraAssetManager.h"
 #include "UObject/NameTypes.h"
+#include "UltraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraUserFacingExperienceDefinition)
 
 namespace Ultra::Experience
 {
 	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Platform_Trait_ReplaySupport, "Platform.Trait.ReplaySupport");
+
+	// Asset registry tags holding FUltraUserFacingExperienceInfo, cooked into the asset registry with the definitions
+	static const FName NAME_InfoMapID(TEXT("UserFacingMapID"));
+	static const FName NAME_InfoExperienceID(TEXT("UserFacingExperienceID"));
+	static const FName NAME_InfoExtraArgs(TEXT("UserFacingExtraArgs"));
+	static const FName NAME_InfoMaxPlayerCount(TEXT("UserFacingMaxPlayerCount"));
+	static const FName NAME_InfoIsDefault(TEXT("UserFacingIsDefault"));
+	static const FName NAME_InfoRecordReplay(TEXT("UserFacingRecordReplay"));
+
+	// Extra args are stored as a JSON object, so keys and values can hold any character including the URL separators ? and =
+	static FString ExtraArgsToString(const TMap<FString, FString>& ExtraArgs)
+	{
+		TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		for (const auto& KVP : ExtraArgs)
+		{
+			JsonObject->SetStringField(KVP.Key, KVP.Value);
+		}
+
+		FString Result;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Result);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return Result;
+	}
+
+	static void ExtraArgsFromString(const FString& String, TMap<FString, FString>& OutExtraArgs)
+	{
+		if (String.IsEmpty())
+		{
+			return;
+		}
+
+		if (String.StartsWith(TEXT("?")))
+		{
+			// Written before the args were stored as JSON, as ?Key=Value?Key=Value. Correct unless a key or value contains ? or =.
+			TArray<FString> Options;
+			String.ParseIntoArray(Options, TEXT("?"));
+			for (const FString& Option : Options)
+			{
+				FString Key;
+				FString Value;
+				if (!Option.Split(TEXT("="), &Key, &Value))
+				{
+					Key = Option;
+				}
+				OutExtraArgs.Add(Key, Value);
+			}
+			return;
+		}
+
+		TSharedPtr<FJsonObject> JsonObject;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(String), JsonObject) || !JsonObject.IsValid())
+		{
+			UE_LOG(LogUltraExperience, Warning, TEXT("Could not parse the experience extra args '%s' from the asset registry"), *String);
+			return;
+		}
+
+		for (const auto& KVP : JsonObject->Values)
+		{
+			FString Value;
+			if (KVP.Value.IsValid() && KVP.Value->TryGetString(Value))
+			{
+				OutExtraArgs.Add(KVP.Key, Value);
+			}
+		}
+	}
 };
 
 UCommonSession_HostSessionRequest* UUltraUserFacingExperienceDefinition::CreateHostingRequest() const
+{
+	return GetExperienceInfo().CreateHostingRequest();
+}
+
+FUltraUserFacingExperienceInfo UUltraUserFacingExperienceDefinition::GetExperienceInfo() const
+{
+	FUltraUserFacingExperienceInfo Info;
+	Info.UserFacingExperienceID = GetPrimaryAssetId();
+	Info.MapID = MapID;
+	Info.ExperienceID = ExperienceID;
+	Info.ExtraArgs = ExtraArgs;
+	Info.MaxPlayerCount = MaxPlayerCount;
+	Info.bIsDefaultExperience = bIsDefaultExperience;
+	Info.bRecordReplay = bRecordReplay;
+	return Info;
+}
+
+void UUltraUserFacingExperienceDefinition::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+	using namespace Ultra::Experience;
+	OutTags.Add(FAssetRegistryTag(NAME_InfoMapID, MapID.ToString(), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(NAME_InfoExperienceID, ExperienceID.ToString(), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(NAME_InfoExtraArgs, ExtraArgsToString(ExtraArgs), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(NAME_InfoMaxPlayerCount, LexToString(MaxPlayerCount), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(NAME_InfoIsDefault, LexToString(bIsDefaultExperience), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(NAME_InfoRecordReplay, LexToString(bRecordReplay), FAssetRegistryTag::TT_Hidden));
+}
+
+bool UUltraUserFacingExperienceDefinition::ReadExperienceInfo(const FAssetData& AssetData, FUltraUserFacingExperienceInfo& OutInfo)
+{
+	using namespace Ultra::Experience;
+
+	FString ExperienceIDString;
+	if (!AssetData.GetTagValue(NAME_InfoExperienceID, ExperienceIDString))
+	{
+		return false;
+	}
+
+	FString MapIDString;
+	FString ExtraArgsString;
+	FString MaxPlayerCountString;
+	FString IsDefaultString;
+	FString RecordReplayString;
+	AssetData.GetTagValue(NAME_InfoMapID, MapIDString);
+	AssetData.GetTagValue(NAME_InfoExtraArgs, ExtraArgsString);
+	AssetData.GetTagValue(NAME_InfoMaxPlayerCount, MaxPlayerCountString);
+	AssetData.GetTagValue(NAME_InfoIsDefault, IsDefaultString);
+	AssetData.GetTagValue(NAME_InfoRecordReplay, RecordReplayString);
+
+	OutInfo.ExperienceID = FPrimaryAssetId(ExperienceIDString);
+	OutInfo.MapID = FPrimaryAssetId(MapIDString);
+	ExtraArgsFromString(ExtraArgsString, OutInfo.ExtraArgs);
+	LexFromString(OutInfo.MaxPlayerCount, *MaxPlayerCountString);
+	LexFromString(OutInfo.bIsDefaultExperience, *IsDefaultString);
+	LexFromString(OutInfo.bRecordReplay, *RecordReplayString);
+	return true;
+}
+
+void UUltraUserFacingExperienceDefinition::GetAllExperienceInfos(TArray<FUltraUserFacingExperienceInfo>& OutInfos)
+{
+	UUltraAssetManager& AssetManager = UUltraAssetManager::Get();
+
+	TArray<FPrimaryAssetId> UserExperienceIds;
+	AssetManager.GetPrimaryAssetIdList(FPrimaryAssetType(StaticClass()->GetFName()), UserExperienceIds);
+
+	for (const FPrimaryAssetId& UserExperienceId : UserExperienceIds)
+	{
+		FAssetData AssetData;
+		if (!AssetManager.GetPrimaryAssetData(UserExperienceId, /*out*/ AssetData))
+		{
+			continue;
+		}
+
+		FUltraUserFacingExperienceInfo Info;
+		if (ReadExperienceInfo(AssetData, Info))
+		{
+			Info.UserFacingExperienceID = UserExperienceId;
+			OutInfos.Add(MoveTemp(Info));
+		}
+		else
+		{
+			UE_LOG(LogUltraExperience, Warning, TEXT("User facing experience %s has no experience info in the asset registry, loading it instead (resave it to fix this)"), *UserExperienceId.ToString());
+			if (const UUltraUserFacingExperienceDefinition* UserExperience = Cast<UUltraUserFacingExperienceDefinition>(AssetData.GetAsset()))
+			{
+				OutInfos.Add(UserExperience->GetExperienceInfo());
+			}
+		}
+	}
+}
+
+UCommonSession_HostSessionRequest* FUltraUserFacingExperienceInfo::CreateHostingRequest() const
 {
 	const FString ExperienceName = ExperienceID.PrimaryAssetName.ToString();
-	const FString UserFacingExperienceName = GetPrimaryAssetId().PrimaryAssetName.ToString();
+	const FString UserFacingExperienceName = UserFacingExperienceID.PrimaryAssetName.ToString();
 	UCommonSession_HostSessionRequest* Result = NewObject<UCommonSession_HostSessionRequest>();
 	Result->OnlineMode = ECommonSessionOnlineMode::Online;
 	Result->bUseLobbies = true;
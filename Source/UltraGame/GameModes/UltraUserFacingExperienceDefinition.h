@@ -11,8 +11,24 @@ class UCommonSession_HostSessionRequest;
 class UObject;
 class UTexture2D;
 class UUserWidget;
+struct FAssetData;
 struct FFrame;
 
+/** The settings of a user-facing experience needed to host a session with it, available without loading the definition */
+struct FUltraUserFacingExperienceInfo
+{
+	FPrimaryAssetId UserFacingExperienceID;
+	FPrimaryAssetId MapID;
+	FPrimaryAssetId ExperienceID;
+	TMap<FString, FString> ExtraArgs;
+	int32 MaxPlayerCount = 16;
+	bool bIsDefaultExperience = false;
+	bool bRecordReplay = false;
+
+	/** Create a request object that is used to actually start a session with these settings */
+	UCommonSession_HostSessionRequest* CreateHostingRequest() const;
+};
+
 /** Description of settings used to display experiences in the UI and start a new session */
 UCLASS(BlueprintType)
 class UUltraUserFacingExperienceDefinition : public UPrimaryDataAsset
@@ -72,4 +88,19 @@ public:
 	/** Create a request object that is used to actually start a session with these settings */
 	UFUNCTION(BlueprintCallable, BlueprintPure=false)
 	UCommonSession_HostSessionRequest* CreateHostingRequest() const;
+
+	FUltraUserFacingExperienceInfo GetExperienceInfo() const;
+
+	/**
+	 * Gathers the info of every user-facing experience from the tags this class writes to the asset registry, so picking
+	 * one does not need to load any definitions. Definitions saved before those tags existed are loaded instead (with a warning).
+	 */
+	static void GetAllExperienceInfos(TArray<FUltraUserFacingExperienceInfo>& OutInfos);
+
+	//~UObject interface
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+	//~End of UObject interface
+
+private:
+	static bool ReadExperienceInfo(const FAssetData& AssetData, FUltraUserFacingExperienceInfo& OutInfo);
 };
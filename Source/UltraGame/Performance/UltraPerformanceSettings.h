@@ -105,6 +105,11 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category=VideoSettings)
 	EUltraFramePacingMode FramePacingMode = EUltraFramePacingMode::DesktopStyle;
 
+	// Caps how many of the third person camera's penetration feelers are traced, in the order they are listed
+	// (the first one is the main ray). Zero or less traces all of them.
+	UPROPERTY(EditAnywhere, Config, Category=Camera, meta=(ClampMin=0))
+	int32 MaxCameraPenetrationFeelers = 0;
+
 	// Potential frame rates to display for mobile
 	// Note: This is further limited by Ultra.DeviceProfile.Mobile.MaxFrameRate from the
 	// platform-specific device profile and what the platform frame pacer reports as supported
@@ -140,4 +145,25 @@ public:
 	// The list of performance stats that can be enabled in Options by the user
 	UPROPERTY(EditAnywhere, Config, Category=Stats)
 	TArray<FUltraPerformanceStatGroup> UserFacingPerformanceStats;
+
+	// Map flown by the scene benchmark (Ultra.Benchmark.RunScene / -UltraSceneBenchmark)
+	// Actors tagged with UltraBenchmarkCamera are visited in name order to form the camera path
+	UPROPERTY(EditAnywhere, Config, Category=SceneBenchmark, meta=(AllowedClasses="/Script/Engine.World"))
+	FSoftObjectPath SceneBenchmarkMap;
+
+	// How long the camera takes to fly the path for each tested quality level
+	UPROPERTY(EditAnywhere, Config, Category=SceneBenchmark, meta=(ForceUnits=s, ClampMin=1.0))
+	float SceneBenchmarkPathSeconds = 12.0f;
+
+	// Time at the start of each pass that is not measured, to let streaming and shader caches settle
+	UPROPERTY(EditAnywhere, Config, Category=SceneBenchmark, meta=(ForceUnits=s, ClampMin=0.0))
+	float SceneBenchmarkWarmupSeconds = 2.0f;
+
+	// Frame rate the benchmark tunes for when the user has no frame rate limit set
+	UPROPERTY(EditAnywhere, Config, Category=SceneBenchmark, meta=(ForceUnits=Hz, ClampMin=15.0))
+	float SceneBenchmarkDefaultTargetFrameRate = 60.0f;
+
+	// Frame time percentile that has to fit in the target frame budget for a quality level to pass
+	UPROPERTY(EditAnywhere, Config, Category=SceneBenchmark, meta=(ClampMin=0.5, ClampMax=1.0))
+	float SceneBenchmarkFrameTimePercentile = 0.95f;
 };
\ No newline at end of file
@@ -62,6 +62,8 @@ void FUltraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 			}
 		}
 	}
+
+	MySubsystem->OnFrameProcessed.Broadcast(FrameData);
 }
 
 void FUltraPerformanceStatCache::StopCharting()
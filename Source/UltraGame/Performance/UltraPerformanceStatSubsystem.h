@@ -16,6 +16,10 @@ struct FFrame;
 
 //////////////////////////////////////////////////////////////////////
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FUltraPerformanceFrameProcessedDelegate, const IPerformanceDataConsumer::FFrameData& /*FrameData*/);
+
+//////////////////////////////////////////////////////////////////////
+
 // Observer which caches the stats for the previous frame
 struct FUltraPerformanceStatCache : public IPerformanceDataConsumer
 {
@@ -64,6 +68,9 @@ public:
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	// Called with the raw frame data each time the tracker processes a frame
+	FUltraPerformanceFrameProcessedDelegate OnFrameProcessed;
+
 protected:
 	TSharedPtr<FUltraPerformanceStatCache> Tracker;
 };
@@ -0,0 +1,424 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UltraSceneBenchmarkSubsystem.h"
+
+#include "Camera/CameraActor.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Performance/UltraPerformanceSettings.h"
+#include "Performance/UltraPerformanceStatSubsystem.h"
+#include "Settings/UltraSettingsLocal.h"
+#include "UltraLogChannels.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraSceneBenchmarkSubsystem)
+
+namespace UltraSceneBenchmark
+{
+	static const FName NAME_BenchmarkCameraTag(TEXT("UltraBenchmarkCamera"));
+
+	static constexpr int32 MinQualityLevel = 0;
+	static constexpr int32 MaxQualityLevel = 3;
+}
+
+//////////////////////////////////////////////////////////////////////
+// UUltraSceneBenchmarkSubsystem
+
+void UUltraSceneBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
+
+	bAutoStartPending = FParse::Param(FCommandLine::Get(), TEXT("UltraSceneBenchmark"));
+	bExitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("UltraSceneBenchmarkExit"));
+}
+
+void UUltraSceneBenchmarkSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	if (State == EState::Running)
+	{
+		FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+	}
+
+	if (UUltraPerformanceStatSubsystem* StatSubsystem = GetGameInstance()->GetSubsystem<UUltraPerformanceStatSubsystem>())
+	{
+		StatSubsystem->OnFrameProcessed.Remove(FrameProcessedHandle);
+	}
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	State = EState::Idle;
+
+	Super::Deinitialize();
+}
+
+bool UUltraSceneBenchmarkSubsystem::StartSceneBenchmark()
+{
+	if (State != EState::Idle)
+	{
+		UE_LOG(LogUltra, Warning, TEXT("Scene benchmark is already running"));
+		return false;
+	}
+
+	const UUltraPerformanceSettings* PerfSettings = GetDefault<UUltraPerformanceSettings>();
+	const FString MapPackageName = PerfSettings->SceneBenchmarkMap.GetLongPackageName();
+	if (MapPackageName.IsEmpty())
+	{
+		UE_LOG(LogUltra, Error, TEXT("Cannot run the scene benchmark, SceneBenchmarkMap is not set in the Ultra Performance Settings"));
+		return false;
+	}
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (World == nullptr)
+	{
+		return false;
+	}
+
+	bMeasureOnly = !FApp::CanEverRender();
+	CompletedPasses.Reset();
+	CameraPath.Reset();
+	ReturnMapName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+
+	UE_LOG(LogUltra, Log, TEXT("Starting scene benchmark on %s (%s)"), *MapPackageName, bMeasureOnly ? TEXT("measure only, no renderer") : TEXT("tuning scalability"));
+
+	State = EState::LoadingMap;
+	UGameplayStatics::OpenLevel(World, FName(*MapPackageName));
+	return true;
+}
+
+void UUltraSceneBenchmarkSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if ((LoadedWorld == nullptr) || (LoadedWorld->GetGameInstance() != GetGameInstance()))
+	{
+		return;
+	}
+
+	if (bAutoStartPending)
+	{
+		// Wait for the startup map before travelling to the benchmark map
+		bAutoStartPending = false;
+		if (!StartSceneBenchmark() && bExitWhenDone)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		return;
+	}
+
+	if (State != EState::LoadingMap)
+	{
+		return;
+	}
+
+	BuildCameraPath(LoadedWorld);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	ACameraActor* Camera = LoadedWorld->SpawnActor<ACameraActor>(ACameraActor::StaticClass(), EvaluateCameraPath(0.0f), SpawnParams);
+	BenchmarkCamera = Camera;
+
+	if (APlayerController* PC = GEngine->GetFirstLocalPlayerController(LoadedWorld))
+	{
+		PC->SetViewTarget(Camera);
+	}
+
+	// Step the simulation by a fixed amount every frame so each run renders the same sequence of views,
+	// the engine still runs as fast as it can so the measured frame times are real
+	const UUltraPerformanceSettings* PerfSettings = GetDefault<UUltraPerformanceSettings>();
+	bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+	SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / PerfSettings->SceneBenchmarkDefaultTargetFrameRate);
+
+	if (UUltraPerformanceStatSubsystem* StatSubsystem = GetGameInstance()->GetSubsystem<UUltraPerformanceStatSubsystem>())
+	{
+		FrameProcessedHandle = StatSubsystem->OnFrameProcessed.AddUObject(this, &ThisClass::HandleFrameProcessed);
+	}
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::Tick));
+
+	State = EState::Running;
+
+	int32 StartLevel = UUltraSettingsLocal::Get()->GetOverallScalabilityLevel();
+	if (StartLevel < 0)
+	{
+		// Custom settings, start from the middle and let the search go either way
+		StartLevel = 2;
+	}
+	StartPass(StartLevel);
+}
+
+void UUltraSceneBenchmarkSubsystem::BuildCameraPath(UWorld* World)
+{
+	TArray<AActor*> PathActors;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (It->ActorHasTag(UltraSceneBenchmark::NAME_BenchmarkCameraTag))
+		{
+			PathActors.Add(*It);
+		}
+	}
+
+	// Sort by name so the path is stable between runs
+	PathActors.Sort([](const AActor& A, const AActor& B) { return A.GetName() < B.GetName(); });
+
+	for (const AActor* PathActor : PathActors)
+	{
+		CameraPath.Add(PathActor->GetActorTransform());
+	}
+
+	if (CameraPath.Num() == 0)
+	{
+		// No authored path, spin in place at the first player start
+		TActorIterator<APlayerStart> StartIt(World);
+		CameraPath.Add(StartIt ? StartIt->GetActorTransform() : FTransform::Identity);
+		UE_LOG(LogUltra, Warning, TEXT("No actors tagged %s in %s, the scene benchmark will spin in place"), *UltraSceneBenchmark::NAME_BenchmarkCameraTag.ToString(), *World->GetMapName());
+	}
+}
+
+FTransform UUltraSceneBenchmarkSubsystem::EvaluateCameraPath(float Alpha) const
+{
+	if (CameraPath.Num() == 1)
+	{
+		FTransform Result = CameraPath[0];
+		Result.ConcatenateRotation(FRotator(0.0, Alpha * 360.0, 0.0).Quaternion());
+		return Result;
+	}
+
+	const float PathPosition = FMath::Clamp(Alpha, 0.0f, 1.0f) * (CameraPath.Num() - 1);
+	const int32 SegmentIndex = FMath::Min(FMath::FloorToInt(PathPosition), CameraPath.Num() - 2);
+	const float SegmentAlpha = PathPosition - SegmentIndex;
+
+	FTransform Result;
+	Result.Blend(CameraPath[SegmentIndex], CameraPath[SegmentIndex + 1], SegmentAlpha);
+	return Result;
+}
+
+void UUltraSceneBenchmarkSubsystem::StartPass(int32 QualityLevel)
+{
+	CurrentQualityLevel = QualityLevel;
+
+	if (!bMeasureOnly)
+	{
+		UUltraSettingsLocal* LocalSettings = UUltraSettingsLocal::Get();
+		LocalSettings->SetOverallScalabilityLevel(QualityLevel);
+		LocalSettings->ApplyScalabilitySettings();
+	}
+
+	PassElapsedSeconds = 0.0;
+	FrameTimesMs.Reset();
+	GameThreadMsSum = 0.0;
+	RenderThreadMsSum = 0.0;
+	GPUMsSum = 0.0;
+
+	if (ACameraActor* Camera = BenchmarkCamera.Get())
+	{
+		Camera->SetActorTransform(EvaluateCameraPath(0.0f));
+	}
+}
+
+bool UUltraSceneBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	if (State != EState::Running)
+	{
+		return true;
+	}
+
+	const UUltraPerformanceSettings* PerfSettings = GetDefault<UUltraPerformanceSettings>();
+	const double PassDuration = PerfSettings->SceneBenchmarkWarmupSeconds + PerfSettings->SceneBenchmarkPathSeconds;
+
+	PassElapsedSeconds += FApp::GetDeltaTime();
+
+	if (ACameraActor* Camera = BenchmarkCamera.Get())
+	{
+		Camera->SetActorTransform(EvaluateCameraPath(PassElapsedSeconds / PassDuration));
+	}
+
+	if (PassElapsedSeconds >= PassDuration)
+	{
+		FinishPass();
+	}
+
+	return true;
+}
+
+void UUltraSceneBenchmarkSubsystem::HandleFrameProcessed(const IPerformanceDataConsumer::FFrameData& FrameData)
+{
+	if ((State != EState::Running) || (PassElapsedSeconds < GetDefault<UUltraPerformanceSettings>()->SceneBenchmarkWarmupSeconds))
+	{
+		return;
+	}
+
+	const double GameThreadMs = FrameData.GameThreadTimeSeconds * 1000.0;
+	const double RenderThreadMs = FrameData.RenderThreadTimeSeconds * 1000.0;
+	const double GPUMs = FrameData.GPUTimeSeconds * 1000.0;
+
+	// The frame is bound by whichever of the pipelined stages was slowest
+	const double BoundFrameMs = bMeasureOnly ? GameThreadMs : FMath::Max3(GameThreadMs, RenderThreadMs, GPUMs);
+
+	FrameTimesMs.Add(BoundFrameMs);
+	GameThreadMsSum += GameThreadMs;
+	RenderThreadMsSum += RenderThreadMs;
+	GPUMsSum += GPUMs;
+}
+
+void UUltraSceneBenchmarkSubsystem::FinishPass()
+{
+	FUltraSceneBenchmarkPass& Pass = CompletedPasses.AddDefaulted_GetRef();
+	Pass.QualityLevel = CurrentQualityLevel;
+	Pass.NumFrames = FrameTimesMs.Num();
+
+	if (Pass.NumFrames > 0)
+	{
+		FrameTimesMs.Sort();
+		const float Percentile = GetDefault<UUltraPerformanceSettings>()->SceneBenchmarkFrameTimePercentile;
+		const int32 PercentileIndex = FMath::Clamp(FMath::CeilToInt(Percentile * Pass.NumFrames) - 1, 0, Pass.NumFrames - 1);
+
+		Pass.PercentileFrameMs = FrameTimesMs[PercentileIndex];
+		Pass.AverageGameThreadMs = GameThreadMsSum / Pass.NumFrames;
+		Pass.AverageRenderThreadMs = RenderThreadMsSum / Pass.NumFrames;
+		Pass.AverageGPUMs = GPUMsSum / Pass.NumFrames;
+	}
+	Pass.bPassed = (Pass.NumFrames > 0) && (Pass.PercentileFrameMs <= GetTargetFrameMs());
+
+	UE_LOG(LogUltra, Log, TEXT("Scene benchmark pass at quality %d: %d frames, p%d %.2f ms (budget %.2f ms) -> %s"),
+		Pass.QualityLevel, Pass.NumFrames, FMath::RoundToInt(GetDefault<UUltraPerformanceSettings>()->SceneBenchmarkFrameTimePercentile * 100.0f),
+		Pass.PercentileFrameMs, GetTargetFrameMs(), Pass.bPassed ? TEXT("pass") : TEXT("fail"));
+
+	if (bMeasureOnly)
+	{
+		FinishBenchmark();
+		return;
+	}
+
+	// Walk up from a passing level and down from a failing one, stopping as soon as the next level was already measured
+	const int32 NextLevel = Pass.bPassed ? (Pass.QualityLevel + 1) : (Pass.QualityLevel - 1);
+	const bool bNextLevelMeasured = CompletedPasses.ContainsByPredicate([NextLevel](const FUltraSceneBenchmarkPass& Other) { return Other.QualityLevel == NextLevel; });
+
+	if ((NextLevel >= UltraSceneBenchmark::MinQualityLevel) && (NextLevel <= UltraSceneBenchmark::MaxQualityLevel) && !bNextLevelMeasured)
+	{
+		StartPass(NextLevel);
+	}
+	else
+	{
+		FinishBenchmark();
+	}
+}
+
+void UUltraSceneBenchmarkSubsystem::FinishBenchmark()
+{
+	State = EState::Idle;
+
+	FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+
+	if (UUltraPerformanceStatSubsystem* StatSubsystem = GetGameInstance()->GetSubsystem<UUltraPerformanceStatSubsystem>())
+	{
+		StatSubsystem->OnFrameProcessed.Remove(FrameProcessedHandle);
+	}
+	FrameProcessedHandle.Reset();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+
+	if (ACameraActor* Camera = BenchmarkCamera.Get())
+	{
+		Camera->Destroy();
+	}
+	BenchmarkCamera.Reset();
+
+	WriteReport();
+
+	if (!bMeasureOnly)
+	{
+		int32 ChosenLevel = UltraSceneBenchmark::MinQualityLevel;
+		for (const FUltraSceneBenchmarkPass& Pass : CompletedPasses)
+		{
+			if (Pass.bPassed)
+			{
+				ChosenLevel = FMath::Max(ChosenLevel, Pass.QualityLevel);
+			}
+		}
+
+		UE_LOG(LogUltra, Log, TEXT("Scene benchmark picked overall quality %d"), ChosenLevel);
+		UUltraSettingsLocal::Get()->SetSceneBenchmarkResult(ChosenLevel, /*bSaveImmediately=*/ true);
+	}
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+	else if (!ReturnMapName.IsEmpty())
+	{
+		if (UWorld* World = GetGameInstance()->GetWorld())
+		{
+			UE_LOG(LogUltra, Log, TEXT("Scene benchmark finished, returning to %s"), *ReturnMapName);
+			UGameplayStatics::OpenLevel(World, FName(*ReturnMapName));
+		}
+	}
+	ReturnMapName.Reset();
+}
+
+void UUltraSceneBenchmarkSubsystem::WriteReport() const
+{
+	const FString OutputDir = FPaths::ProfilingDir() / TEXT("SceneBenchmark");
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	const FString ReportFilename = OutputDir / FString::Printf(TEXT("SceneBenchmark_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+
+	FString Report = TEXT("QualityLevel,Frames,PercentileFrameMs,BudgetMs,AvgGameThreadMs,AvgRenderThreadMs,AvgGPUMs,Passed,HardwareFingerprint\n");
+	const FString HardwareFingerprint = UUltraSettingsLocal::GetHardwareFingerprint();
+	for (const FUltraSceneBenchmarkPass& Pass : CompletedPasses)
+	{
+		Report += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%s\n"),
+			Pass.QualityLevel, Pass.NumFrames, Pass.PercentileFrameMs, GetTargetFrameMs(),
+			Pass.AverageGameThreadMs, Pass.AverageRenderThreadMs, Pass.AverageGPUMs, Pass.bPassed ? 1 : 0, *HardwareFingerprint);
+	}
+
+	if (FFileHelper::SaveStringToFile(Report, *ReportFilename))
+	{
+		UE_LOG(LogUltra, Log, TEXT("Wrote scene benchmark report to %s"), *IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*ReportFilename));
+	}
+	else
+	{
+		UE_LOG(LogUltra, Error, TEXT("Failed to write scene benchmark report to %s"), *ReportFilename);
+	}
+}
+
+double UUltraSceneBenchmarkSubsystem::GetTargetFrameMs() const
+{
+	// Tune for the frame rate the user will actually run at, falling back to the project default when uncapped
+	float TargetFrameRate = UUltraSettingsLocal::Get()->GetEffectiveFrameRateLimit();
+	if (TargetFrameRate <= 0.0f)
+	{
+		TargetFrameRate = GetDefault<UUltraPerformanceSettings>()->SceneBenchmarkDefaultTargetFrameRate;
+	}
+
+	return 1000.0 / FMath::Max(TargetFrameRate, 1.0f);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs GUltraRunSceneBenchmarkCmd(
+	TEXT("Ultra.Benchmark.RunScene"),
+	TEXT("Flies the scene benchmark map at each overall quality level and picks the highest one that fits the frame budget"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World)
+{
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (UUltraSceneBenchmarkSubsystem* BenchmarkSubsystem = GameInstance ? GameInstance->GetSubsystem<UUltraSceneBenchmarkSubsystem>() : nullptr)
+	{
+		BenchmarkSubsystem->StartSceneBenchmark();
+	}
+}));
@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ChartCreation.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+
+#include "UltraSceneBenchmarkSubsystem.generated.h"
+
+class ACameraActor;
+class FSubsystemCollectionBase;
+class UObject;
+class UWorld;
+struct FFrame;
+
+// Measured result of flying the benchmark path at a single overall quality level
+struct FUltraSceneBenchmarkPass
+{
+	int32 QualityLevel = INDEX_NONE;
+	int32 NumFrames = 0;
+	double PercentileFrameMs = 0.0;
+	double AverageGameThreadMs = 0.0;
+	double AverageRenderThreadMs = 0.0;
+	double AverageGPUMs = 0.0;
+	bool bPassed = false;
+};
+
+/**
+ * UUltraSceneBenchmarkSubsystem
+ *
+ * Flies a camera along a fixed path through the configured benchmark map (see UUltraPerformanceSettings)
+ * with a fixed time step so every run renders the same frames, records per-frame thread and GPU times,
+ * and walks the overall scalability level until it finds the highest one that fits the target frame budget.
+ *
+ * The chosen level is stored in UUltraSettingsLocal along with a hardware fingerprint so the auto benchmark
+ * reuses it until the hardware changes. Every pass is also written to a CSV in the profiling directory.
+ *
+ * Once it finishes the player is sent back to the map they started it from.
+ *
+ * Under -nullrhi the benchmark does a single pass at the current level without tuning, which makes it usable
+ * as a headless game thread regression test. Start it with Ultra.Benchmark.RunScene or -UltraSceneBenchmark,
+ * and add -UltraSceneBenchmarkExit to quit once the report has been written.
+ */
+UCLASS()
+class UUltraSceneBenchmarkSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Loads the benchmark map and starts measuring, returns false if the benchmark could not be started
+	UFUNCTION(BlueprintCallable, Category=Benchmark)
+	bool StartSceneBenchmark();
+
+	UFUNCTION(BlueprintPure, Category=Benchmark)
+	bool IsSceneBenchmarkRunning() const { return State != EState::Idle; }
+
+private:
+	enum class EState : uint8
+	{
+		Idle,
+		LoadingMap,
+		Running
+	};
+
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+	void HandleFrameProcessed(const IPerformanceDataConsumer::FFrameData& FrameData);
+	bool Tick(float DeltaTime);
+
+	void BuildCameraPath(UWorld* World);
+	FTransform EvaluateCameraPath(float Alpha) const;
+
+	void StartPass(int32 QualityLevel);
+	void FinishPass();
+	void FinishBenchmark();
+	void WriteReport() const;
+
+	double GetTargetFrameMs() const;
+
+private:
+	EState State = EState::Idle;
+
+	// True when there is no renderer, in which case only the game thread is measured and no tuning happens
+	bool bMeasureOnly = false;
+
+	// True when started from the command line with -UltraSceneBenchmarkExit
+	bool bExitWhenDone = false;
+
+	// True when started from the command line with -UltraSceneBenchmark and waiting for the first map to finish loading
+	bool bAutoStartPending = false;
+
+	// Map the player was on when the benchmark started, travelled back to once it finishes
+	FString ReturnMapName;
+
+	TArray<FTransform> CameraPath;
+	TWeakObjectPtr<ACameraActor> BenchmarkCamera;
+
+	int32 CurrentQualityLevel = INDEX_NONE;
+	double PassElapsedSeconds = 0.0;
+	TArray<double> FrameTimesMs;
+	double GameThreadMsSum = 0.0;
+	double RenderThreadMsSum = 0.0;
+	double GPUMsSum = 0.0;
+
+	TArray<FUltraSceneBenchmarkPass> CompletedPasses;
+
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+
+	FDelegateHandle PostLoadMapHandle;
+	FDelegateHandle FrameProcessedHandle;
+	FTSTicker::FDelegateHandle TickHandle;
+};
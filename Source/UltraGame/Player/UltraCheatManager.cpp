@@ -240,12 +240,22 @@ void UUltraCheatManager::CancelActivatedAbilities()
 
 void UUltraCheatManager::AddTagToSelf(FString TagName)
 {
+	if (AUltraPlayerController* UltraPC = Cast<AUltraPlayerController>(GetOuterAPlayerController()))
+	{
+		if (UltraPC->GetNetMode() == NM_Client)
+		{
+			// The tag is replicated from the server, so send the cheat there.
+			UltraPC->ServerCheat(FString::Printf(TEXT("AddTagToSelf %s"), *TagName));
+			return;
+		}
+	}
+
 	FGameplayTag Tag = UltraGameplayTags::FindTagByString(TagName, true);
 	if (Tag.IsValid())
 	{
 		if (UUltraAbilitySystemComponent* UltraASC = GetPlayerAbilitySystemComponent())
 		{
-			UltraASC->AddDynamicTagGameplayEffect(Tag);
+			UltraASC->AddReplicatedDynamicTag(Tag);
 		}
 	}
 	else
@@ -256,12 +266,22 @@ void UUltraCheatManager::AddTagToSelf(FString TagName)
 
 void UUltraCheatManager::RemoveTagFromSelf(FString TagName)
 {
+	if (AUltraPlayerController* UltraPC = Cast<AUltraPlayerController>(GetOuterAPlayerController()))
+	{
+		if (UltraPC->GetNetMode() == NM_Client)
+		{
+			// The tag is replicated from the server, so send the cheat there.
+			UltraPC->ServerCheat(FString::Printf(TEXT("RemoveTagFromSelf %s"), *TagName));
+			return;
+		}
+	}
+
 	FGameplayTag Tag = UltraGameplayTags::FindTagByString(TagName, true);
 	if (Tag.IsValid())
 	{
 		if (UUltraAbilitySystemComponent* UltraASC = GetPlayerAbilitySystemComponent())
 		{
-			UltraASC->RemoveDynamicTagGameplayEffect(Tag);
+			UltraASC->RemoveReplicatedDynamicTag(Tag);
 		}
 	}
 	else
@@ -340,11 +360,11 @@ void UUltraCheatManager::God()
 
 			if (bHasTag)
 			{
-				UltraASC->RemoveDynamicTagGameplayEffect(Tag);
+				UltraASC->RemoveReplicatedDynamicTag(Tag);
 			}
 			else
 			{
-				UltraASC->AddDynamicTagGameplayEffect(Tag);
+				UltraASC->AddReplicatedDynamicTag(Tag);
 			}
 		}
 	}
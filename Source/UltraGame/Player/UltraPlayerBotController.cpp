@@ -9,6 +9,7 @@
 #include "GameModes/UltraGameMode.h"
 #include "UltraLogChannels.h"
 #include "Perception/AIPerceptionComponent.h"
+#include "Teams/UltraTeamSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraPlayerBotController)
 
@@ -60,6 +61,12 @@ void AUltraPlayerBotController::BroadcastOnPlayerStateChanged()
 	// Broadcast the team change (if it really has)
 	ConditionalBroadcastTeamChanged(this, OldTeamID, NewTeamID);
 
+	// The player state we resolve to has changed even if the team has not
+	if (UUltraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<UUltraTeamSubsystem>(GetWorld()))
+	{
+		TeamSubsystem->InvalidateTeamMembershipCache();
+	}
+
 	LastSeenPlayerState = PlayerState;
 }
 
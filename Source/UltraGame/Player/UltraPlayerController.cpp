@@ -9,7 +9,7 @@
 #include "Camera/UltraPlayerCameraManager.h"
 #include "UI/UltraHUD.h"
 #include "AbilitySystem/UltraAbilitySystemComponent.h"
-#include "EngineUtils.h"
+#include "Engine/World.h"
 #include "UltraGameplayTags.h"
 #include "GameFramework/Pawn.h"
 #include "AbilitySystemGlobals.h"
@@ -17,9 +17,17 @@
 #include "UltraLocalPlayer.h"
 #include "Settings/UltraSettingsShared.h"
 #include "Development/UltraDeveloperSettings.h"
+#include "Teams/UltraTeamSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraPlayerController)
 
+DECLARE_STATS_GROUP(TEXT("UltraPlayerController"), STATGROUP_UltraPlayerController, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("PlayerTick"), STAT_UltraPlayerController_PlayerTick, STATGROUP_UltraPlayerController);
+DECLARE_CYCLE_STAT(TEXT("Update Hidden Components"), STAT_UltraPlayerController_UpdateHiddenComponents, STATGROUP_UltraPlayerController);
+DECLARE_CYCLE_STAT(TEXT("Gather View Target Hidden Components"), STAT_UltraPlayerController_GatherHiddenComponents, STATGROUP_UltraPlayerController);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Auto Running Controllers"), STAT_UltraPlayerController_NumAutoRunning, STATGROUP_UltraPlayerController);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hidden Component Gathers"), STAT_UltraPlayerController_NumHiddenComponentGathers, STATGROUP_UltraPlayerController);
+
 namespace Ultra
 {
 	namespace Input
@@ -54,6 +62,8 @@ void AUltraPlayerController::BeginPlay()
 
 void AUltraPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	BindAutoRunTag(nullptr);
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -64,11 +74,15 @@ void AUltraPlayerController::ReceivedPlayer()
 
 void AUltraPlayerController::PlayerTick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_UltraPlayerController_PlayerTick);
+
 	Super::PlayerTick(DeltaTime);
 
 	// If we are auto running then add some player input
-	if (GetIsAutoRunning())
+	if (bAutoRunning)
 	{
+		INC_DWORD_STAT(STAT_UltraPlayerController_NumAutoRunning);
+
 		if (APawn* CurrentPawn = GetPawn())
 		{
 			const FRotator MovementRotation(0.0f, GetControlRotation().Yaw, 0.0f);
@@ -133,6 +147,16 @@ void AUltraPlayerController::BroadcastOnPlayerStateChanged()
 	// Broadcast the team change (if it really has)
 	ConditionalBroadcastTeamChanged(this, OldTeamID, NewTeamID);
 
+	// The player state we resolve to has changed even if the team has not
+	if (UUltraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<UUltraTeamSubsystem>(GetWorld()))
+	{
+		TeamSubsystem->InvalidateTeamMembershipCache();
+	}
+
+	// Follow the auto-running tag of the new player state's ability system
+	const AUltraPlayerState* UltraPS = Cast<AUltraPlayerState>(PlayerState);
+	BindAutoRunTag(UltraPS ? UltraPS->GetUltraAbilitySystemComponent() : nullptr);
+
 	LastSeenPlayerState = PlayerState;
 }
 
@@ -203,9 +227,9 @@ void AUltraPlayerController::ServerCheatAll_Implementation(const FString& Msg)
 	if (CheatManager)
 	{
 		UE_LOG(LogUltra, Warning, TEXT("ServerCheatAll: %s"), *Msg);
-		for (TActorIterator<AUltraPlayerController> It(GetWorld()); It; ++It)
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
 		{
-			AUltraPlayerController* UltraPC = (*It);
+			AUltraPlayerController* UltraPC = Cast<AUltraPlayerController>(It->Get());
 			if (UltraPC)
 			{
 				UltraPC->ClientMessage(UltraPC->ConsoleCommand(Msg));
@@ -286,6 +310,34 @@ bool AUltraPlayerController::GetIsAutoRunning() const
 	return bIsAutoRunning;
 }
 
+void AUltraPlayerController::BindAutoRunTag(UUltraAbilitySystemComponent* UltraASC)
+{
+	if (AutoRunTagSource.Get() == UltraASC)
+	{
+		return;
+	}
+
+	if (UUltraAbilitySystemComponent* OldASC = AutoRunTagSource.Get())
+	{
+		OldASC->RegisterGameplayTagEvent(UltraGameplayTags::Status_AutoRunning, EGameplayTagEventType::NewOrRemoved).Remove(AutoRunTagChangedHandle);
+	}
+	AutoRunTagChangedHandle.Reset();
+
+	AutoRunTagSource = UltraASC;
+	bAutoRunning = false;
+
+	if (UltraASC)
+	{
+		AutoRunTagChangedHandle = UltraASC->RegisterGameplayTagEvent(UltraGameplayTags::Status_AutoRunning, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &ThisClass::OnAutoRunTagChanged);
+		bAutoRunning = UltraASC->GetTagCount(UltraGameplayTags::Status_AutoRunning) > 0;
+	}
+}
+
+void AUltraPlayerController::OnAutoRunTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	bAutoRunning = NewCount > 0;
+}
+
 void AUltraPlayerController::OnStartAutoRun()
 {
 	if (UUltraAbilitySystemComponent* UltraASC = GetUltraAbilitySystemComponent())
@@ -324,6 +376,8 @@ void AUltraPlayerController::UpdateForceFeedback(IInputInterface* InputInterface
 
 void AUltraPlayerController::UpdateHiddenComponents(const FVector& ViewLocation, TSet<FPrimitiveComponentId>& OutHiddenComponents)
 {
+	SCOPE_CYCLE_COUNTER(STAT_UltraPlayerController_UpdateHiddenComponents);
+
 	Super::UpdateHiddenComponents(ViewLocation, OutHiddenComponents);
 
 	if (bHideViewTargetPawnNextFrame)
@@ -331,49 +385,74 @@ void AUltraPlayerController::UpdateHiddenComponents(const FVector& ViewLocation,
 		AActor* const ViewTargetPawn = PlayerCameraManager ? Cast<AActor>(PlayerCameraManager->GetViewTarget()) : nullptr;
 		if (ViewTargetPawn)
 		{
-			// internal helper func to hide all the components
-			auto AddToHiddenComponents = [&OutHiddenComponents](const TInlineComponentArray<UPrimitiveComponent*>& InComponents)
+			// Gather again when the view target changes, its components change or a new penetration starts (something may have been attached since),
+			// otherwise reuse what was gathered for the previous frame
+			const bool bViewTargetChanged = (ViewTargetHiddenComponentsSource.Get() != ViewTargetPawn) || (ViewTargetHiddenComponentsSourceNum != ViewTargetPawn->GetComponents().Num());
+			if (bViewTargetChanged || !bHidViewTargetPawnLastFrame)
 			{
-				// add every component and all attached children
-				for (UPrimitiveComponent* Comp : InComponents)
-				{
-					if (Comp->IsRegistered())
-					{
-						OutHiddenComponents.Add(Comp->ComponentId);
-
-						for (USceneComponent* AttachedChild : Comp->GetAttachChildren())
-						{
-							static FName NAME_NoParentAutoHide(TEXT("NoParentAutoHide"));
-							UPrimitiveComponent* AttachChildPC = Cast<UPrimitiveComponent>(AttachedChild);
-							if (AttachChildPC && AttachChildPC->IsRegistered() && !AttachChildPC->ComponentTags.Contains(NAME_NoParentAutoHide))
-							{
-								OutHiddenComponents.Add(AttachChildPC->ComponentId);
-							}
-						}
-					}
-				}
-			};
-
-			//TODO Solve with an interface.  Gather hidden components or something.
-			//TODO Hiding isn't awesome, sometimes you want the effect of a fade out over a proximity, needs to bubble up to designers.
-
-			// hide pawn's components
-			TInlineComponentArray<UPrimitiveComponent*> PawnComponents;
-			ViewTargetPawn->GetComponents(PawnComponents);
-			AddToHiddenComponents(PawnComponents);
-
-			//// hide weapon too
-			//if (ViewTargetPawn->CurrentWeapon)
-			//{
-			//	TInlineComponentArray<UPrimitiveComponent*> WeaponComponents;
-			//	ViewTargetPawn->CurrentWeapon->GetComponents(WeaponComponents);
-			//	AddToHiddenComponents(WeaponComponents);
-			//}
+				GatherViewTargetHiddenComponents(ViewTargetPawn);
+			}
+
+			OutHiddenComponents.Append(ViewTargetHiddenComponents);
 		}
 
 		// we consumed it, reset for next frame
 		bHideViewTargetPawnNextFrame = false;
+		bHidViewTargetPawnLastFrame = true;
 	}
+	else
+	{
+		bHidViewTargetPawnLastFrame = false;
+	}
+}
+
+void AUltraPlayerController::GatherViewTargetHiddenComponents(AActor* ViewTarget)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UltraPlayerController_GatherHiddenComponents);
+	INC_DWORD_STAT(STAT_UltraPlayerController_NumHiddenComponentGathers);
+
+	ViewTargetHiddenComponents.Reset();
+	ViewTargetHiddenComponentsSource = ViewTarget;
+	ViewTargetHiddenComponentsSourceNum = ViewTarget->GetComponents().Num();
+
+	// internal helper func to hide all the components
+	auto AddToHiddenComponents = [this](const TInlineComponentArray<UPrimitiveComponent*>& InComponents)
+	{
+		// add every component and all attached children
+		for (UPrimitiveComponent* Comp : InComponents)
+		{
+			if (Comp->IsRegistered())
+			{
+				ViewTargetHiddenComponents.Add(Comp->ComponentId);
+
+				for (USceneComponent* AttachedChild : Comp->GetAttachChildren())
+				{
+					static FName NAME_NoParentAutoHide(TEXT("NoParentAutoHide"));
+					UPrimitiveComponent* AttachChildPC = Cast<UPrimitiveComponent>(AttachedChild);
+					if (AttachChildPC && AttachChildPC->IsRegistered() && !AttachChildPC->ComponentTags.Contains(NAME_NoParentAutoHide))
+					{
+						ViewTargetHiddenComponents.Add(AttachChildPC->ComponentId);
+					}
+				}
+			}
+		}
+	};
+
+	//TODO Solve with an interface.  Gather hidden components or something.
+	//TODO Hiding isn't awesome, sometimes you want the effect of a fade out over a proximity, needs to bubble up to designers.
+
+	// hide pawn's components
+	TInlineComponentArray<UPrimitiveComponent*> PawnComponents;
+	ViewTarget->GetComponents(PawnComponents);
+	AddToHiddenComponents(PawnComponents);
+
+	//// hide weapon too
+	//if (ViewTargetPawn->CurrentWeapon)
+	//{
+	//	TInlineComponentArray<UPrimitiveComponent*> WeaponComponents;
+	//	ViewTargetPawn->CurrentWeapon->GetComponents(WeaponComponents);
+	//	AddToHiddenComponents(WeaponComponents);
+	//}
 }
 
 void AUltraPlayerController::SetGenericTeamId(const FGenericTeamId& NewTeamID)
@@ -4,17 +4,18 @@
 
 #include "Camera/UltraCameraAssistInterface.h"
 #include "CommonPlayerController.h"
+#include "PrimitiveComponentId.h"
 #include "Teams/UltraTeamAgentInterface.h"
 
 #include "UltraPlayerController.generated.h"
 
+struct FGameplayTag;
 struct FGenericTeamId;
 
 class AUltraHUD;
 class AUltraPlayerState;
 class APawn;
 class APlayerState;
-class FPrimitiveComponentId;
 class IInputInterface;
 class UUltraAbilitySystemComponent;
 class UUltraSettingsShared;
@@ -92,6 +93,10 @@ private:
 	UPROPERTY()
 	FOnUltraTeamIndexChangedDelegate OnTeamChangedDelegate;
 
+	// Ability system we listen to for the auto-running tag, follows the player state
+	TWeakObjectPtr<UUltraAbilitySystemComponent> AutoRunTagSource;
+	FDelegateHandle AutoRunTagChangedHandle;
+
 	UPROPERTY()
 	TObjectPtr<APlayerState> LastSeenPlayerState;
 
@@ -135,7 +140,21 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="OnEndAutoRun"))
 	void K2_OnEndAutoRun();
 
+	void BindAutoRunTag(UUltraAbilitySystemComponent* UltraASC);
+	void OnAutoRunTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	void GatherViewTargetHiddenComponents(AActor* ViewTarget);
+
 	bool bHideViewTargetPawnNextFrame = false;
+
+	// Mirrors the auto-running tag so PlayerTick does not have to query the ability system every frame
+	bool bAutoRunning = false;
+
+	// Components hidden while the camera penetrates the view target, gathered once per view target and penetration
+	TSet<FPrimitiveComponentId> ViewTargetHiddenComponents;
+	TWeakObjectPtr<AActor> ViewTargetHiddenComponentsSource;
+	int32 ViewTargetHiddenComponentsSourceNum = 0;
+	bool bHidViewTargetPawnLastFrame = false;
 };
 
 
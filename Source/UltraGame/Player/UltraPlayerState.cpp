@@ -16,6 +16,7 @@
 #include "UltraPlayerController.h"
 #include "Messages/UltraVerbMessage.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraPlayerState)
 
@@ -25,6 +26,46 @@ class FLifetimeProperty;
 
 const FName AUltraPlayerState::NAME_UltraAbilityReady("UltraAbilitiesReady");
 
+FOnUltraPlayerStateNetUpdateFrequencyChanged AUltraPlayerState::OnNetUpdateFrequencyChanged;
+
+namespace UltraPlayerStateCVars
+{
+	static bool bAdaptiveNetUpdateFrequency = true;
+	static FAutoConsoleVariableRef CVarAdaptiveNetUpdateFrequency(
+		TEXT("Ultra.PlayerState.AdaptiveNetUpdateFrequency"),
+		bAdaptiveNetUpdateFrequency,
+		TEXT("If true, player states only replicate at MaxNetUpdateFrequency while they have pending replicated changes and decay toward MinNetUpdateFrequency when idle."),
+		ECVF_Default);
+
+	static float MaxNetUpdateFrequency = 100.0f;
+	static FAutoConsoleVariableRef CVarMaxNetUpdateFrequency(
+		TEXT("Ultra.PlayerState.MaxNetUpdateFrequency"),
+		MaxNetUpdateFrequency,
+		TEXT("Net update frequency used while the player state or its ability system component has pending replicated changes."),
+		ECVF_Default);
+
+	static float MinNetUpdateFrequency = 5.0f;
+	static FAutoConsoleVariableRef CVarMinNetUpdateFrequency(
+		TEXT("Ultra.PlayerState.MinNetUpdateFrequency"),
+		MinNetUpdateFrequency,
+		TEXT("Net update frequency an idle player state decays to."),
+		ECVF_Default);
+
+	static float NetUpdateFrequencyDecaySeconds = 2.0f;
+	static FAutoConsoleVariableRef CVarNetUpdateFrequencyDecaySeconds(
+		TEXT("Ultra.PlayerState.NetUpdateFrequencyDecaySeconds"),
+		NetUpdateFrequencyDecaySeconds,
+		TEXT("Seconds without replicated changes it takes to go from the max to the min net update frequency."),
+		ECVF_Default);
+
+	static float NetUpdateFrequencyCheckInterval = 0.1f;
+	static FAutoConsoleVariableRef CVarNetUpdateFrequencyCheckInterval(
+		TEXT("Ultra.PlayerState.NetUpdateFrequencyCheckInterval"),
+		NetUpdateFrequencyCheckInterval,
+		TEXT("How often (in seconds) the server checks player states for replicated changes. Applies to player states that begin play afterwards."),
+		ECVF_Default);
+};
+
 AUltraPlayerState::AUltraPlayerState(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, MyPlayerConnectionType(EUltraPlayerConnectionType::Player)
@@ -33,7 +74,8 @@ AUltraPlayerState::AUltraPlayerState(const FObjectInitializer& ObjectInitializer
 	AbilitySystemComponent->SetIsReplicated(true);
 	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
 
-	// AbilitySystemComponent needs to be updated at a high frequency.
+	// AbilitySystemComponent needs to be updated at a high frequency while it has changes, on the server this is
+	// lowered toward Ultra.PlayerState.MinNetUpdateFrequency when idle (see UpdateAdaptiveNetUpdateFrequency).
 	NetUpdateFrequency = 100.0f;
 
 	MyTeamID = FGenericTeamId::NoTeam;
@@ -158,6 +200,87 @@ void AUltraPlayerState::PostInitializeComponents()
 	}
 }
 
+void AUltraPlayerState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UWorld* World = GetWorld();
+	if (HasAuthority() && (GetNetMode() != NM_Standalone) && UltraPlayerStateCVars::bAdaptiveNetUpdateFrequency)
+	{
+		LastReplicatedStateKey = GetReplicatedStateKey();
+		LastReplicatedStateChangeTime = World->GetTimeSeconds();
+
+		const float CheckInterval = FMath::Max(UltraPlayerStateCVars::NetUpdateFrequencyCheckInterval, 0.01f);
+		World->GetTimerManager().SetTimer(AdaptiveNetUpdateTimerHandle, this, &ThisClass::UpdateAdaptiveNetUpdateFrequency, CheckInterval, /*bLoop=*/ true);
+	}
+}
+
+void AUltraPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AdaptiveNetUpdateTimerHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+uint32 AUltraPlayerState::GetReplicatedStateKey() const
+{
+	uint32 Key = ReplicatedPropertyChangeCount + (uint32)StatTags.ArrayReplicationKey;
+	if (AbilitySystemComponent)
+	{
+		Key += AbilitySystemComponent->GetReplicatedStateKey();
+	}
+	return Key;
+}
+
+void AUltraPlayerState::UpdateAdaptiveNetUpdateFrequency()
+{
+	const float MaxFrequency = FMath::Max(UltraPlayerStateCVars::MaxNetUpdateFrequency, 1.0f);
+
+	if (!UltraPlayerStateCVars::bAdaptiveNetUpdateFrequency)
+	{
+		// Turned off at runtime, go back to the fixed rate
+		GetWorld()->GetTimerManager().ClearTimer(AdaptiveNetUpdateTimerHandle);
+		SetAdaptiveNetUpdateFrequency(MaxFrequency);
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const uint32 StateKey = GetReplicatedStateKey();
+
+	if (StateKey != LastReplicatedStateKey)
+	{
+		LastReplicatedStateKey = StateKey;
+		LastReplicatedStateChangeTime = CurrentTime;
+
+		if (NetUpdateFrequency < MaxFrequency)
+		{
+			SetAdaptiveNetUpdateFrequency(MaxFrequency);
+
+			// The replication driver scheduled our next update using the idle rate, don't wait for it
+			ForceNetUpdate();
+		}
+		return;
+	}
+
+	const float MinFrequency = FMath::Clamp(UltraPlayerStateCVars::MinNetUpdateFrequency, 1.0f, MaxFrequency);
+	const float DecaySeconds = UltraPlayerStateCVars::NetUpdateFrequencyDecaySeconds;
+	const float IdleAlpha = (DecaySeconds > 0.0f) ? FMath::Clamp((float)(CurrentTime - LastReplicatedStateChangeTime) / DecaySeconds, 0.0f, 1.0f) : 1.0f;
+
+	SetAdaptiveNetUpdateFrequency(FMath::Lerp(MaxFrequency, MinFrequency, IdleAlpha));
+}
+
+void AUltraPlayerState::SetAdaptiveNetUpdateFrequency(float NewFrequency)
+{
+	if (NetUpdateFrequency != NewFrequency)
+	{
+		NetUpdateFrequency = NewFrequency;
+		OnNetUpdateFrequencyChanged.Broadcast(this);
+	}
+}
+
 void AUltraPlayerState::SetPawnData(const UUltraPawnData* InPawnData)
 {
 	check(InPawnData);
@@ -174,6 +297,7 @@ void AUltraPlayerState::SetPawnData(const UUltraPawnData* InPawnData)
 	}
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, PawnData, this);
+	++ReplicatedPropertyChangeCount;
 	PawnData = InPawnData;
 
 	for (const UUltraAbilitySet* AbilitySet : PawnData->AbilitySets)
@@ -196,6 +320,7 @@ void AUltraPlayerState::OnRep_PawnData()
 void AUltraPlayerState::SetPlayerConnectionType(EUltraPlayerConnectionType NewType)
 {
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, MyPlayerConnectionType, this);
+	++ReplicatedPropertyChangeCount;
 	MyPlayerConnectionType = NewType;
 }
 
@@ -204,6 +329,7 @@ void AUltraPlayerState::SetSquadID(int32 NewSquadId)
 	if (HasAuthority())
 	{
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, MySquadID, this);
+		++ReplicatedPropertyChangeCount;
 
 		MySquadID = NewSquadId;
 	}
@@ -216,6 +342,7 @@ void AUltraPlayerState::SetGenericTeamId(const FGenericTeamId& NewTeamID)
 		const FGenericTeamId OldTeamID = MyTeamID;
 
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, MyTeamID, this);
+		++ReplicatedPropertyChangeCount;
 		MyTeamID = NewTeamID;
 		ConditionalBroadcastTeamChanged(this, OldTeamID, NewTeamID);
 	}
@@ -13,6 +13,7 @@ struct FUltraVerbMessage;
 
 class AController;
 class AUltraPlayerController;
+class AUltraPlayerState;
 class APlayerState;
 class FName;
 class UAbilitySystemComponent;
@@ -40,6 +41,8 @@ enum class EUltraPlayerConnectionType : uint8
 	InactivePlayer
 };
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnUltraPlayerStateNetUpdateFrequencyChanged, AUltraPlayerState* /*PlayerState*/);
+
 /**
  * AUltraPlayerState
  *
@@ -68,6 +71,8 @@ public:
 	//~AActor interface
 	virtual void PreInitializeComponents() override;
 	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~End of AActor interface
 
 	//~APlayerState interface
@@ -126,9 +131,19 @@ public:
 	UFUNCTION(Client, Unreliable, BlueprintCallable, Category = "Ultra|PlayerState")
 	void ClientBroadcastMessage(const FUltraVerbMessage Message);
 
+	// Broadcast on the server whenever the adaptive NetUpdateFrequency of a player state changes, so the replication driver can pick it up
+	static FOnUltraPlayerStateNetUpdateFrequencyChanged OnNetUpdateFrequencyChanged;
+
 private:
 	void OnExperienceLoaded(const UUltraExperienceDefinition* CurrentExperience);
 
+	// Returns a value that changes whenever this player state or its ability system component has new state to replicate
+	uint32 GetReplicatedStateKey() const;
+
+	// Raises NetUpdateFrequency while there are replicated changes and decays it toward the floor when idle
+	void UpdateAdaptiveNetUpdateFrequency();
+	void SetAdaptiveNetUpdateFrequency(float NewFrequency);
+
 protected:
 	UFUNCTION()
 	void OnRep_PawnData();
@@ -159,6 +174,13 @@ private:
 	UPROPERTY(Replicated)
 	FGameplayTagStackContainer StatTags;
 
+	// Bumped by the setters of the push model properties above, part of GetReplicatedStateKey
+	uint32 ReplicatedPropertyChangeCount = 0;
+
+	uint32 LastReplicatedStateKey = 0;
+	double LastReplicatedStateChangeTime = 0.0;
+	FTimerHandle AdaptiveNetUpdateTimerHandle;
+
 private:
 	UFUNCTION()
 	void OnRep_MyTeamID(FGenericTeamId OldTeamID);
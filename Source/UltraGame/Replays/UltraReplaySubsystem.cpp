@@ -1,16 +1,55 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UltraReplaySubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 #include "Engine/DemoNetDriver.h"
+#include "HAL/IConsoleManager.h"
+#include "Messages/UltraVerbMessage.h"
+#include "UltraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraReplaySubsystem)
 
+namespace UltraReplay
+{
+	// Replay event group used for the Ultra event index
+	static const FString EventGroup = TEXT("UltraEvents");
+
+	// Separates the event tag from the description in the event metadata
+	static const TCHAR* EventMetadataSeparator = TEXT("|");
+}
+
 UUltraReplaySubsystem::UUltraReplaySubsystem()
 {
 }
 
+void UUltraReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	RecordingStartedHandle = FNetworkReplayDelegates::OnReplayRecordingStartAttempt.AddUObject(this, &ThisClass::HandleReplayRecordingStarted);
+	RecordingCompleteHandle = FNetworkReplayDelegates::OnReplayRecordingComplete.AddUObject(this, &ThisClass::HandleReplayRecordingComplete);
+	ReplayStartedHandle = FNetworkReplayDelegates::OnReplayStarted.AddUObject(this, &ThisClass::HandleReplayStarted);
+}
+
+void UUltraReplaySubsystem::Deinitialize()
+{
+	FNetworkReplayDelegates::OnReplayRecordingStartAttempt.Remove(RecordingStartedHandle);
+	FNetworkReplayDelegates::OnReplayRecordingComplete.Remove(RecordingCompleteHandle);
+	FNetworkReplayDelegates::OnReplayStarted.Remove(ReplayStartedHandle);
+
+	// The handles only keep a weak pointer to the message subsystem, so this is safe while the game instance shuts down
+	for (FGameplayMessageListenerHandle& Handle : ListenerHandles)
+	{
+		Handle.Unregister();
+	}
+	ListenerHandles.Reset();
+
+	Super::Deinitialize();
+}
+
 void UUltraReplaySubsystem::PlayReplay(UUltraReplayListEntry* Replay)
 {
 	if (Replay != nullptr)
@@ -27,6 +66,8 @@ void UUltraReplaySubsystem::PlayReplay(UUltraReplayListEntry* Replay)
 
 void UUltraReplaySubsystem::SeekInActiveReplay(float TimeInSeconds)
 {
+	LastSeekedEventIndex = INDEX_NONE;
+
 	if (UDemoNetDriver* DemoDriver = GetDemoDriver())
 	{
 		DemoDriver->GotoTimeInSeconds(TimeInSeconds);
@@ -51,6 +92,265 @@ float UUltraReplaySubsystem::GetReplayCurrentTime() const
 	return 0.0f;
 }
 
+bool UUltraReplaySubsystem::SeekToNextEvent(FGameplayTagContainer EventFilter)
+{
+	for (int32 EventIndex = GetFirstEventIndexToSearch(/*bForward=*/ true); EventIndex < ReplayEvents.Num(); ++EventIndex)
+	{
+		const FUltraReplayEvent& Event = ReplayEvents[EventIndex];
+		if (EventFilter.IsEmpty() || Event.EventTag.MatchesAny(EventFilter))
+		{
+			SeekToEvent(EventIndex);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UUltraReplaySubsystem::SeekToPreviousEvent(FGameplayTagContainer EventFilter)
+{
+	for (int32 EventIndex = GetFirstEventIndexToSearch(/*bForward=*/ false); EventIndex >= 0; --EventIndex)
+	{
+		const FUltraReplayEvent& Event = ReplayEvents[EventIndex];
+		if (EventFilter.IsEmpty() || Event.EventTag.MatchesAny(EventFilter))
+		{
+			SeekToEvent(EventIndex);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 UUltraReplaySubsystem::GetFirstEventIndexToSearch(bool bForward) const
+{
+	const float CurrentTime = GetReplayCurrentTime();
+
+	// While playback is still in the pre-roll of the event we last seeked to, step relative to that event.
+	// Searching by time would skip every event inside the pre-roll window.
+	if (ReplayEvents.IsValidIndex(LastSeekedEventIndex) && (CurrentTime <= ReplayEvents[LastSeekedEventIndex].TimeInSeconds))
+	{
+		return bForward ? (LastSeekedEventIndex + 1) : (LastSeekedEventIndex - 1);
+	}
+
+	if (bForward)
+	{
+		return Algo::UpperBoundBy(ReplayEvents, CurrentTime, &FUltraReplayEvent::TimeInSeconds);
+	}
+	return Algo::LowerBoundBy(ReplayEvents, CurrentTime, &FUltraReplayEvent::TimeInSeconds) - 1;
+}
+
+void UUltraReplaySubsystem::SeekToEvent(int32 EventIndex)
+{
+	SeekInActiveReplay(FMath::Max(ReplayEvents[EventIndex].TimeInSeconds - EventSeekPreRollSeconds, 0.0f));
+	LastSeekedEventIndex = EventIndex;
+}
+
+void UUltraReplaySubsystem::RecordReplayEvent(FGameplayTag EventTag, const FString& Description)
+{
+	UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if ((DemoDriver == nullptr) || !DemoDriver->IsRecording())
+	{
+		return;
+	}
+
+	const float EventTime = DemoDriver->GetDemoCurrentTime();
+	const FString Metadata = EventTag.ToString() + UltraReplay::EventMetadataSeparator + Description;
+	DemoDriver->AddEvent(UltraReplay::EventGroup, Metadata, TArray<uint8>());
+
+	FUltraReplayEvent& NewEvent = ReplayEvents.AddDefaulted_GetRef();
+	NewEvent.EventTag = EventTag;
+	NewEvent.TimeInSeconds = EventTime;
+	NewEvent.Description = Description;
+
+	UpdateAdaptiveCheckpoints(EventTime);
+}
+
+void UUltraReplaySubsystem::UpdateAdaptiveCheckpoints(float EventTime)
+{
+	if ((HighActivityEventCount <= 0) || ((EventTime - LastActivityCheckpointTime) < MinSecondsBetweenActivityCheckpoints))
+	{
+		return;
+	}
+
+	// Events are recorded in time order, so only the tail needs to be checked
+	int32 NumRecentEvents = 0;
+	for (int32 EventIndex = ReplayEvents.Num() - 1; EventIndex >= 0; --EventIndex)
+	{
+		if ((EventTime - ReplayEvents[EventIndex].TimeInSeconds) > HighActivityWindowSeconds)
+		{
+			break;
+		}
+		++NumRecentEvents;
+	}
+
+	if (NumRecentEvents >= HighActivityEventCount)
+	{
+		if (UDemoNetDriver* DemoDriver = GetDemoDriver())
+		{
+			UE_LOG(LogUltra, Verbose, TEXT("Requesting replay checkpoint at %.2f (%d events in the last %.1fs)"), EventTime, NumRecentEvents, HighActivityWindowSeconds);
+
+			DemoDriver->RequestCheckpoint();
+			LastActivityCheckpointTime = EventTime;
+		}
+	}
+}
+
+void UUltraReplaySubsystem::HandleReplayRecordingStarted(UWorld* World)
+{
+	if ((World == nullptr) || (World->GetGameInstance() != GetGameInstance()))
+	{
+		return;
+	}
+
+	HandleReplayRecordingComplete(World);
+
+	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
+	for (const FGameplayTag& Channel : RecordedEventChannels)
+	{
+		ListenerHandles.Add(MessageSubsystem.RegisterListener(Channel, this, &ThisClass::OnVerbMessage));
+	}
+}
+
+void UUltraReplaySubsystem::HandleReplayRecordingComplete(UWorld* World)
+{
+	for (FGameplayMessageListenerHandle& Handle : ListenerHandles)
+	{
+		Handle.Unregister();
+	}
+	ListenerHandles.Reset();
+
+	ReplayEvents.Reset();
+	LastSeekedEventIndex = INDEX_NONE;
+	LastActivityCheckpointTime = -FLT_MAX;
+}
+
+void UUltraReplaySubsystem::HandleReplayStarted(UWorld* World)
+{
+	if ((World == nullptr) || (World->GetGameInstance() != GetGameInstance()))
+	{
+		return;
+	}
+
+	ReplayEvents.Reset();
+	LastSeekedEventIndex = INDEX_NONE;
+
+	UDemoNetDriver* DemoDriver = World->GetDemoNetDriver();
+	if (DemoDriver == nullptr)
+	{
+		return;
+	}
+
+	// Fetch the event index that was recorded alongside the replay
+	DemoDriver->EnumerateEvents(UltraReplay::EventGroup, FEnumerateEventsCallback([WeakThis = TWeakObjectPtr<ThisClass>(this)](const FEnumerateEventsResult& Result)
+	{
+		UUltraReplaySubsystem* StrongThis = WeakThis.Get();
+		if ((StrongThis == nullptr) || !Result.WasSuccessful())
+		{
+			return;
+		}
+
+		for (const FReplayEventListItem& Item : Result.ReplayEventList.ReplayEvents)
+		{
+			FString TagString;
+			FString Description;
+			if (!Item.Metadata.Split(UltraReplay::EventMetadataSeparator, &TagString, &Description))
+			{
+				TagString = Item.Metadata;
+			}
+
+			FUltraReplayEvent& NewEvent = StrongThis->ReplayEvents.AddDefaulted_GetRef();
+			NewEvent.EventTag = FGameplayTag::RequestGameplayTag(*TagString, /*ErrorIfNotFound=*/ false);
+			NewEvent.TimeInSeconds = Item.Time1 / 1000.0f;
+			NewEvent.Description = Description;
+		}
+
+		StrongThis->ReplayEvents.StableSort([](const FUltraReplayEvent& A, const FUltraReplayEvent& B) { return A.TimeInSeconds < B.TimeInSeconds; });
+
+		UE_LOG(LogUltra, Log, TEXT("Loaded %d replay events"), StrongThis->ReplayEvents.Num());
+	}));
+}
+
+void UUltraReplaySubsystem::OnVerbMessage(FGameplayTag Channel, const FUltraVerbMessage& Payload)
+{
+	FString Description = FString::Printf(TEXT("%s -> %s"), *GetNameSafe(Payload.Instigator), *GetNameSafe(Payload.Target));
+	if (!Payload.ContextTags.IsEmpty())
+	{
+		Description += TEXT(" ") + Payload.ContextTags.ToStringSimple();
+	}
+
+	RecordReplayEvent(Payload.Verb.IsValid() ? Payload.Verb : Channel, Description);
+}
+
+void UUltraReplaySubsystem::RunSeekBenchmark(int32 NumSeeks)
+{
+	UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if ((DemoDriver == nullptr) || !DemoDriver->IsPlaying())
+	{
+		UE_LOG(LogUltra, Error, TEXT("Replay seek benchmark requires a replay to be playing"));
+		return;
+	}
+
+	BenchmarkSeekTimes.Reset();
+	BenchmarkSeekDurations.Reset();
+
+	// Prefer seeking to recorded events, which is what the review tooling does; fall back to evenly spaced times
+	if (ReplayEvents.Num() > 0)
+	{
+		for (int32 SeekIndex = 0; SeekIndex < NumSeeks; ++SeekIndex)
+		{
+			const FUltraReplayEvent& Event = ReplayEvents[SeekIndex % ReplayEvents.Num()];
+			BenchmarkSeekTimes.Add(FMath::Max(Event.TimeInSeconds - EventSeekPreRollSeconds, 0.0f));
+		}
+	}
+	else
+	{
+		const float TotalTime = DemoDriver->GetDemoTotalTime();
+		for (int32 SeekIndex = 0; SeekIndex < NumSeeks; ++SeekIndex)
+		{
+			BenchmarkSeekTimes.Add(TotalTime * (SeekIndex + 1) / (NumSeeks + 1));
+		}
+	}
+
+	// Seek in reverse so every seek has to go back to a checkpoint
+	Algo::Reverse(BenchmarkSeekTimes);
+
+	RunNextBenchmarkSeek();
+}
+
+void UUltraReplaySubsystem::RunNextBenchmarkSeek()
+{
+	UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if ((DemoDriver != nullptr) && (BenchmarkSeekDurations.Num() < BenchmarkSeekTimes.Num()))
+	{
+		BenchmarkSeekStartTime = FPlatformTime::Seconds();
+		DemoDriver->GotoTimeInSeconds(BenchmarkSeekTimes[BenchmarkSeekDurations.Num()], FOnGotoTimeDelegate::CreateWeakLambda(this, [this](const bool bWasSuccessful)
+		{
+			BenchmarkSeekDurations.Add(FPlatformTime::Seconds() - BenchmarkSeekStartTime);
+			if (!bWasSuccessful)
+			{
+				UE_LOG(LogUltra, Warning, TEXT("Replay seek benchmark: seek to %.2f failed"), BenchmarkSeekTimes[BenchmarkSeekDurations.Num() - 1]);
+			}
+			RunNextBenchmarkSeek();
+		}));
+		return;
+	}
+
+	if (BenchmarkSeekDurations.Num() > 0)
+	{
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		for (double Duration : BenchmarkSeekDurations)
+		{
+			TotalSeconds += Duration;
+			MaxSeconds = FMath::Max(MaxSeconds, Duration);
+		}
+
+		UE_LOG(LogUltra, Display, TEXT("Replay seek benchmark: %d seeks, avg %.2f ms, max %.2f ms (%d indexed events)"),
+			BenchmarkSeekDurations.Num(), (TotalSeconds / BenchmarkSeekDurations.Num()) * 1000.0, MaxSeconds * 1000.0, ReplayEvents.Num());
+	}
+}
+
 UDemoNetDriver* UUltraReplaySubsystem::GetDemoDriver() const
 {
 	if (UWorld* World = GetGameInstance()->GetWorld())
@@ -60,3 +360,19 @@ UDemoNetDriver* UUltraReplaySubsystem::GetDemoDriver() const
 	return nullptr;
 }
 
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs GUltraReplayBenchmarkSeeksCmd(
+	TEXT("Ultra.Replay.BenchmarkSeeks"),
+	TEXT("Seeks through the active replay (to each indexed event if there are any) and logs the seek latency. Usage: Ultra.Replay.BenchmarkSeeks [NumSeeks=20]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World)
+{
+	const int32 NumSeeks = (Params.Num() > 0) ? FCString::Atoi(*Params[0]) : 20;
+
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (UUltraReplaySubsystem* ReplaySubsystem = GameInstance ? GameInstance->GetSubsystem<UUltraReplaySubsystem>() : nullptr)
+	{
+		ReplaySubsystem->RunSeekBenchmark(FMath::Max(NumSeeks, 1));
+	}
+}));
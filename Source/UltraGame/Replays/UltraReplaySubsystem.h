@@ -2,13 +2,17 @@
 
 #pragma once
 
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameplayTagContainer.h"
 #include "NetworkReplayStreaming.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 
 #include "UltraReplaySubsystem.generated.h"
 
 class UDemoNetDriver;
+class UWorld;
 struct FFrame;
+struct FUltraVerbMessage;
 
 // An available replay
 UCLASS(BlueprintType)
@@ -51,7 +55,26 @@ public:
 	TArray<TObjectPtr<UUltraReplayListEntry>> Results;
 };
 
-UCLASS()
+// A gameplay event (elimination, phase change, etc...) recorded alongside a replay
+USTRUCT(BlueprintType)
+struct FUltraReplayEvent
+{
+	GENERATED_BODY()
+
+	// The verb of the message that caused this event
+	UPROPERTY(BlueprintReadOnly, Category=Replays)
+	FGameplayTag EventTag;
+
+	// Time into the replay of the event
+	UPROPERTY(BlueprintReadOnly, Category=Replays)
+	float TimeInSeconds = 0.0f;
+
+	// Extra context recorded with the event (e.g., instigator and target names, or the phase that started)
+	UPROPERTY(BlueprintReadOnly, Category=Replays)
+	FString Description;
+};
+
+UCLASS(Config=Game)
 class UUltraReplaySubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -59,6 +82,11 @@ class UUltraReplaySubsystem : public UGameInstanceSubsystem
 public:
 	UUltraReplaySubsystem();
 
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
 	UFUNCTION(BlueprintCallable, Category=Replays)
 	void PlayReplay(UUltraReplayListEntry* Replay);
 
@@ -73,6 +101,81 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Replays, BlueprintPure=false)
 	float GetReplayCurrentTime() const;
 
+	// Returns the event index of the active replay, sorted by time
+	UFUNCTION(BlueprintCallable, Category=Replays, BlueprintPure=false)
+	TArray<FUltraReplayEvent> GetReplayEvents() const { return ReplayEvents; }
+
+	// Seeks to the first event after the current time that matches the filter (any event if the filter is empty)
+	// Returns false if there is no such event
+	UFUNCTION(BlueprintCallable, Category=Replays)
+	bool SeekToNextEvent(FGameplayTagContainer EventFilter);
+
+	// Seeks to the last event before the current time that matches the filter (any event if the filter is empty)
+	// Returns false if there is no such event
+	UFUNCTION(BlueprintCallable, Category=Replays)
+	bool SeekToPreviousEvent(FGameplayTagContainer EventFilter);
+
+	// Adds an event to the index of the replay currently being recorded
+	void RecordReplayEvent(FGameplayTag EventTag, const FString& Description);
+
+	// Seeks to every indexed event in turn and logs how long each seek took
+	void RunSeekBenchmark(int32 NumSeeks);
+
 private:
 	UDemoNetDriver* GetDemoDriver() const;
+
+	// Returns the index of the first event SeekToNextEvent (or SeekToPreviousEvent if !bForward) should consider
+	int32 GetFirstEventIndexToSearch(bool bForward) const;
+
+	void SeekToEvent(int32 EventIndex);
+
+	void HandleReplayRecordingStarted(UWorld* World);
+	void HandleReplayRecordingComplete(UWorld* World);
+	void HandleReplayStarted(UWorld* World);
+
+	void OnVerbMessage(FGameplayTag Channel, const FUltraVerbMessage& Payload);
+
+	// Requests an extra checkpoint if enough events happened recently, so seeking around busy moments is cheap
+	void UpdateAdaptiveCheckpoints(float EventTime);
+
+	void RunNextBenchmarkSeek();
+
+private:
+	// Gameplay message channels (carrying FUltraVerbMessage) that are recorded into the replay event index
+	UPROPERTY(Config)
+	TArray<FGameplayTag> RecordedEventChannels;
+
+	// How many seconds before an event to land when seeking to it, so the lead-up is visible
+	UPROPERTY(Config)
+	float EventSeekPreRollSeconds = 2.0f;
+
+	// Number of events within HighActivityWindowSeconds that counts as a high-activity moment
+	UPROPERTY(Config)
+	int32 HighActivityEventCount = 3;
+
+	UPROPERTY(Config)
+	float HighActivityWindowSeconds = 5.0f;
+
+	// Minimum time between extra checkpoints requested for high-activity moments
+	UPROPERTY(Config)
+	float MinSecondsBetweenActivityCheckpoints = 5.0f;
+
+	// Events of the replay being recorded or played back, sorted by time
+	TArray<FUltraReplayEvent> ReplayEvents;
+
+	// Index into ReplayEvents of the event we last seeked to, reset by any other seek
+	int32 LastSeekedEventIndex = INDEX_NONE;
+
+	TArray<FGameplayMessageListenerHandle> ListenerHandles;
+
+	float LastActivityCheckpointTime = -FLT_MAX;
+
+	// Seek benchmark state
+	TArray<float> BenchmarkSeekTimes;
+	TArray<double> BenchmarkSeekDurations;
+	double BenchmarkSeekStartTime = 0.0;
+
+	FDelegateHandle RecordingStartedHandle;
+	FDelegateHandle RecordingCompleteHandle;
+	FDelegateHandle ReplayStartedHandle;
 };
@@ -20,6 +20,8 @@
 #include "DeviceProfiles/DeviceProfileManager.h"
 #include "DeviceProfiles/DeviceProfile.h"
 #include "HAL/PlatformFramePacer.h"
+#include "Misc/SecureHash.h"
+#include "RHI.h"
 #include "Development/UltraPlatformEmulationSettings.h"
 #include "SoundControlBus.h"
 #include "AudioModulationStatics.h"
@@ -908,6 +910,12 @@ bool UUltraSettingsLocal::ShouldRunAutoBenchmarkAtStartup() const
 		return false;
 	}
 
+	if (!SceneBenchmarkHardwareFingerprint.IsEmpty() && !HasSceneBenchmarkResultForCurrentHardware())
+	{
+		// The hardware changed since the scene benchmark was measured
+		return true;
+	}
+
 	if (LastCPUBenchmarkResult != -1)
 	{
 		// Already run and loaded
@@ -919,7 +927,19 @@ bool UUltraSettingsLocal::ShouldRunAutoBenchmarkAtStartup() const
 
 void UUltraSettingsLocal::RunAutoBenchmark(bool bSaveImmediately)
 {
-	RunHardwareBenchmark();
+	if (HasSceneBenchmarkResultForCurrentHardware())
+	{
+		// Prefer the level measured on real content over the synthetic hardware benchmark
+		SetOverallScalabilityLevel(SceneBenchmarkOverallQuality);
+	}
+	else
+	{
+		// Any scene result was measured on other hardware, forget it so startup stops asking for a rerun
+		SceneBenchmarkHardwareFingerprint.Reset();
+		SceneBenchmarkOverallQuality = -1;
+
+		RunHardwareBenchmark();
+	}
 
 	// Always apply, optionally save
 	ApplyScalabilitySettings();
@@ -935,6 +955,36 @@ void UUltraSettingsLocal::ApplyScalabilitySettings()
 	Scalability::SetQualityLevels(ScalabilityQuality);
 }
 
+FString UUltraSettingsLocal::GetHardwareFingerprint()
+{
+	const FString HardwareDescription = FString::Printf(TEXT("%s|%s|%d|%llu"),
+		*FPlatformMisc::GetCPUBrand().TrimStartAndEnd(),
+		*GRHIAdapterName,
+		FPlatformMisc::NumberOfCoresIncludingHyperthreads(),
+		(uint64)FPlatformMemory::GetConstants().TotalPhysicalGB);
+
+	return FMD5::HashAnsiString(*HardwareDescription);
+}
+
+bool UUltraSettingsLocal::HasSceneBenchmarkResultForCurrentHardware() const
+{
+	return (SceneBenchmarkOverallQuality >= 0) && (SceneBenchmarkHardwareFingerprint == GetHardwareFingerprint());
+}
+
+void UUltraSettingsLocal::SetSceneBenchmarkResult(int32 OverallQualityLevel, bool bSaveImmediately)
+{
+	SceneBenchmarkHardwareFingerprint = GetHardwareFingerprint();
+	SceneBenchmarkOverallQuality = FMath::Clamp(OverallQualityLevel, 0, 3);
+
+	SetOverallScalabilityLevel(SceneBenchmarkOverallQuality);
+	ApplyScalabilitySettings();
+
+	if (bSaveImmediately)
+	{
+		SaveSettings();
+	}
+}
+
 float UUltraSettingsLocal::GetOverallVolume() const
 {
 	return OverallVolume;
@@ -281,6 +281,26 @@ public:
 	/** Apply just the quality scalability settings */
 	void ApplyScalabilitySettings();
 
+	/** Returns a stable fingerprint of the CPU/GPU/memory configuration, used to decide if a stored scene benchmark result still applies */
+	static FString GetHardwareFingerprint();
+
+	/** Returns true if a scene benchmark result was stored for the current hardware */
+	bool HasSceneBenchmarkResultForCurrentHardware() const;
+
+	/** Stores the overall quality level picked by the scene benchmark for the current hardware and applies it */
+	void SetSceneBenchmarkResult(int32 OverallQualityLevel, bool bSaveImmediately);
+
+private:
+	/** Hardware fingerprint the stored scene benchmark result was measured on */
+	UPROPERTY(Config)
+	FString SceneBenchmarkHardwareFingerprint;
+
+	/** Overall quality level picked by the scene benchmark, or -1 if it has never run */
+	UPROPERTY(Config)
+	int32 SceneBenchmarkOverallQuality = -1;
+
+public:
+
 	UFUNCTION()
 	float GetOverallVolume() const;
 	UFUNCTION()
@@ -242,7 +242,8 @@ void UUltraAssetManager::DoAllStartupJobs()
 
 	StartupJobs.Empty();
 
-	UE_LOG(LogUltra, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+	StartupJobsCompletedTime = FPlatformTime::Seconds();
+	UE_LOG(LogUltra, Display, TEXT("All startup jobs took %.2f seconds to complete"), StartupJobsCompletedTime - AllStartupJobsStartTime);
 }
 
 void UUltraAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
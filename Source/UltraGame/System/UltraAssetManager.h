@@ -51,6 +51,9 @@ public:
 	const UUltraGameData& GetGameData();
 	const UUltraPawnData* GetDefaultPawnData() const;
 
+	// Time (FPlatformTime::Seconds) at which all startup jobs finished, or 0 if they have not run yet
+	double GetStartupJobsCompletedTime() const { return StartupJobsCompletedTime; }
+
 protected:
 	template <typename GameDataClass>
 	const GameDataClass& GetOrLoadTypedGameData(const TSoftObjectPtr<GameDataClass>& DataPath)
@@ -107,6 +110,8 @@ private:
 	// The list of tasks to execute on startup. Used to track startup progress.
 	TArray<FUltraAssetManagerStartupJob> StartupJobs;
 
+	double StartupJobsCompletedTime = 0.0;
+
 private:
 	
 	// Assets loaded and tracked by the asset manager.
@@ -39,6 +39,8 @@
 *		A custom node for handling player state replication. This replicates a small rolling set of player states (currently 2/frame). This is so player states replicate
 *		to simulated connections at a low, steady frequency, and to take advantage of serialization sharing. Auto proxy player states are replicated at higher frequency (to the
 *		owning connection only) via UUltraReplicationGraphNode_AlwaysRelevant_ForConnection.
+*		Player states also adapt their own NetUpdateFrequency to how much their ability system has to replicate. They broadcast
+*		AUltraPlayerState::OnNetUpdateFrequencyChanged and we push the new replication period into their global and per connection actor info.
 *
 *		UReplicationGraphNode_TearOff_ForConnection
 *		Connection specific node for handling tear off actors. This is created and managed in the base implementation of Replication Graph.
@@ -90,6 +92,7 @@
 #include "UltraReplicationGraphSettings.h"
 #include "Character/UltraCharacter.h"
 #include "Player/UltraPlayerController.h"
+#include "Player/UltraPlayerState.h"
 
 DEFINE_LOG_CATEGORY(LogUltraRepGraph);
 
@@ -132,6 +135,9 @@ namespace Ultra::RepGraph
 	int32 EnableFastSharedPath = 1;
 	static FAutoConsoleVariableRef CVarUltraRepEnableFastSharedPath(TEXT("Ultra.RepGraph.EnableFastSharedPath"), EnableFastSharedPath, TEXT(""), ECVF_Default);
 
+	int32 TrackPlayerStateRates = 0;
+	static FAutoConsoleVariableRef CVarUltraRepTrackPlayerStateRates(TEXT("Ultra.RepGraph.TrackPlayerStateRates"), TrackPlayerStateRates, TEXT("Count how often each player state replicates to each connection, see Ultra.RepGraph.PrintPlayerStateRates"), ECVF_Default);
+
 	UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
 	{
 		// Only create for GameNetDriver
@@ -139,6 +145,15 @@ namespace Ultra::RepGraph
 		{
 			const UUltraReplicationGraphSettings* UltraRepGraphSettings = GetDefault<UUltraReplicationGraphSettings>();
 
+#if UE_WITH_IRIS
+			// Iris replaces the replication driver entirely, its filters are configured in ObjectReplicationBridgeConfig
+			if (ForNetDriver->IsUsingIrisReplication())
+			{
+				UE_LOG(LogUltraRepGraph, Display, TEXT("Replication graph is disabled because %s is using Iris replication."), *GetNameSafe(ForNetDriver));
+				return nullptr;
+			}
+#endif
+
 			// Enable/Disable via developer settings
 			if (UltraRepGraphSettings && UltraRepGraphSettings->bDisableReplicationGraph)
 			{
@@ -176,11 +191,34 @@ UUltraReplicationGraph::UUltraReplicationGraph()
 	}
 }
 
+void UUltraReplicationGraph::BeginDestroy()
+{
+	AUltraPlayerState::OnNetUpdateFrequencyChanged.Remove(PlayerStateNetUpdateFrequencyChangedHandle);
+	PlayerStateNetUpdateFrequencyChangedHandle.Reset();
+
+	Super::BeginDestroy();
+}
+
+int32 UUltraReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 Result = Super::ServerReplicateActors(DeltaSeconds);
+	LastServerReplicateActorsSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (Ultra::RepGraph::TrackPlayerStateRates != 0)
+	{
+		TrackPlayerStateReplications();
+	}
+
+	return Result;
+}
+
 void UUltraReplicationGraph::ResetGameWorldState()
 {
 	Super::ResetGameWorldState();
 
 	AlwaysRelevantStreamingLevelActors.Empty();
+	PlayerStateRepStats.Reset();
 
 	for (UNetReplicationGraphConnection* ConnManager : Connections)
 	{
@@ -510,6 +548,9 @@ void UUltraReplicationGraph::InitGlobalActorClassSettings()
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &ThisClass::OnGameplayDebuggerOwnerChange);
 #endif
 
+	AUltraPlayerState::OnNetUpdateFrequencyChanged.Remove(PlayerStateNetUpdateFrequencyChangedHandle);
+	PlayerStateNetUpdateFrequencyChangedHandle = AUltraPlayerState::OnNetUpdateFrequencyChanged.AddUObject(this, &ThisClass::OnPlayerStateNetUpdateFrequencyChanged);
+
 	// Add to RPC_Multicast_OpenChannelForClass map
 	RPC_Multicast_OpenChannelForClass.Reset();
 	RPC_Multicast_OpenChannelForClass.Set(AActor::StaticClass(), true); // Open channels for multicast RPCs by default
@@ -680,6 +721,65 @@ void UUltraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicated
 #define CHECK_WORLDS(X)
 #endif
 
+void UUltraReplicationGraph::OnPlayerStateNetUpdateFrequencyChanged(AUltraPlayerState* PlayerState)
+{
+	CHECK_WORLDS(PlayerState);
+
+	// The period is normally fixed per class by InitClassReplicationInfo, apply the player state's own rate to it and every connection that already knows it
+	FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(PlayerState);
+	if (GlobalInfo == nullptr)
+	{
+		return;
+	}
+
+	const uint32 ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(PlayerState->NetUpdateFrequency);
+	GlobalInfo->Settings.ReplicationPeriodFrame = ReplicationPeriodFrame;
+
+	for (UNetReplicationGraphConnection* ConnManager : Connections)
+	{
+		if (FConnectionReplicationActorInfo* ConnectionActorInfo = ConnManager->ActorInfoMap.Find(PlayerState))
+		{
+			ConnectionActorInfo->ReplicationPeriodFrame = ReplicationPeriodFrame;
+		}
+	}
+}
+
+void UUltraReplicationGraph::TrackPlayerStateReplications()
+{
+	const AGameStateBase* GameState = GetWorld() ? GetWorld()->GetGameState() : nullptr;
+	if (GameState == nullptr)
+	{
+		return;
+	}
+
+	if (PlayerStateRatesStartTime == 0.0)
+	{
+		PlayerStateRatesStartTime = FPlatformTime::Seconds();
+	}
+
+	for (UNetReplicationGraphConnection* ConnManager : Connections)
+	{
+		TMap<TObjectKey<APlayerState>, FPlayerStateRepStats>& ConnectionStats = PlayerStateRepStats.FindOrAdd(ConnManager);
+
+		for (APlayerState* PS : GameState->PlayerArray)
+		{
+			const FConnectionReplicationActorInfo* ConnectionActorInfo = PS ? ConnManager->ActorInfoMap.Find(PS) : nullptr;
+			if (ConnectionActorInfo == nullptr)
+			{
+				continue;
+			}
+
+			// LastRepFrameNum only moves when the actor was actually replicated to this connection
+			FPlayerStateRepStats& Stats = ConnectionStats.FindOrAdd(PS);
+			if (ConnectionActorInfo->LastRepFrameNum != Stats.LastRepFrameNum)
+			{
+				Stats.LastRepFrameNum = ConnectionActorInfo->LastRepFrameNum;
+				++Stats.NumReplications;
+			}
+		}
+	}
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UUltraReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
@@ -987,3 +1087,67 @@ FAutoConsoleCommandWithWorldAndArgs ChangeFrequencyBucketsCmd(TEXT("Ultra.RepGra
 			Node->SetNonStreamingCollectionSize(Buckets);
 		}
 	}));
+
+// ------------------------------------------------------------------------------
+
+void UUltraReplicationGraph::PrintPlayerStateRates()
+{
+	if (Ultra::RepGraph::TrackPlayerStateRates == 0)
+	{
+		UE_LOG(LogUltraRepGraph, Display, TEXT("Player state rates are not being tracked, set Ultra.RepGraph.TrackPlayerStateRates 1 first."));
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double ElapsedSeconds = Now - PlayerStateRatesStartTime;
+	if ((PlayerStateRatesStartTime == 0.0) || (ElapsedSeconds <= 0.0))
+	{
+		return;
+	}
+
+	UE_LOG(LogUltraRepGraph, Display, TEXT("Player state replication rates over the last %.1fs:"), ElapsedSeconds);
+
+	for (UNetReplicationGraphConnection* ConnManager : Connections)
+	{
+		const TMap<TObjectKey<APlayerState>, FPlayerStateRepStats>* ConnectionStats = PlayerStateRepStats.Find(ConnManager);
+		if (ConnectionStats == nullptr)
+		{
+			continue;
+		}
+
+		UE_LOG(LogUltraRepGraph, Display, TEXT("  %s"), ConnManager->NetConnection ? *ConnManager->NetConnection->Describe() : *GetNameSafe(ConnManager));
+
+		for (const auto& KVP : *ConnectionStats)
+		{
+			if (const APlayerState* PS = KVP.Key.ResolveObjectPtr())
+			{
+				const bool bOwner = (PS->GetNetConnection() == ConnManager->NetConnection);
+				UE_LOG(LogUltraRepGraph, Display, TEXT("    %-32s %6.1f Hz achieved, %6.1f Hz target%s"),
+					*PS->GetPlayerName(), KVP.Value.NumReplications / ElapsedSeconds, PS->NetUpdateFrequency, bOwner ? TEXT(" (owner)") : TEXT(""));
+			}
+		}
+	}
+
+	// Keep LastRepFrameNum so the next window doesn't count a stale replication
+	for (auto& ConnectionKVP : PlayerStateRepStats)
+	{
+		for (auto& KVP : ConnectionKVP.Value)
+		{
+			KVP.Value.NumReplications = 0;
+		}
+	}
+	PlayerStateRatesStartTime = Now;
+}
+
+FAutoConsoleCommandWithWorldAndArgs UltraPrintPlayerStateRatesCmd(TEXT("Ultra.RepGraph.PrintPlayerStateRates"), TEXT("Prints how often each player state replicated to each connection since the last call (needs Ultra.RepGraph.TrackPlayerStateRates 1)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			for (TObjectIterator<UUltraReplicationGraph> It; It; ++It)
+			{
+				if (It->GetWorld() == World)
+				{
+					It->PrintPlayerStateRates();
+				}
+			}
+		})
+);
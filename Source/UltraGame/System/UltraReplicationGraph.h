@@ -7,6 +7,7 @@
 #include "UltraReplicationGraph.generated.h"
 
 class AGameplayDebuggerCategoryReplicator;
+class AUltraPlayerState;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogUltraRepGraph, Display, All);
 
@@ -19,6 +20,10 @@ class UUltraReplicationGraph : public UReplicationGraph
 public:
 	UUltraReplicationGraph();
 
+	//~UObject interface
+	virtual void BeginDestroy() override;
+	//~End of UObject interface
+
 	virtual void ResetGameWorldState() override;
 
 	virtual void InitGlobalActorClassSettings() override;
@@ -26,6 +31,10 @@ public:
 	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
 	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
 	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/** Wall time spent in the last ServerReplicateActors (gathering, prioritizing and replicating for every connection) */
+	double GetLastServerReplicateActorsSeconds() const { return LastServerReplicateActorsSeconds; }
 
 	UPROPERTY()
 	TArray<TObjectPtr<UClass>>	AlwaysRelevantClasses;
@@ -44,6 +53,9 @@ public:
 
 	void PrintRepNodePolicies();
 
+	/** Logs how often each player state actually replicated to each connection since the last call (needs Ultra.RepGraph.TrackPlayerStateRates) */
+	void PrintPlayerStateRates();
+
 private:
 	void AddClassRepInfo(UClass* Class, EClassRepNodeMapping Mapping);
 	void RegisterClassRepNodeMapping(UClass* Class);
@@ -55,12 +67,30 @@ private:
 
 	EClassRepNodeMapping GetMappingPolicy(UClass* Class);
 
+	void OnPlayerStateNetUpdateFrequencyChanged(AUltraPlayerState* PlayerState);
+	void TrackPlayerStateReplications();
+
 	bool IsSpatialized(EClassRepNodeMapping Mapping) const { return Mapping >= EClassRepNodeMapping::Spatialize_Static; }
 
 	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
 
+	/** Binding to the static AUltraPlayerState::OnNetUpdateFrequencyChanged, removed when the graph is destroyed */
+	FDelegateHandle PlayerStateNetUpdateFrequencyChangedHandle;
+
 	/** Classes that had their replication settings explictly set by code in UUltraReplicationGraph::InitGlobalActorClassSettings */
 	TArray<UClass*> ExplicitlySetClasses;
+
+	double LastServerReplicateActorsSeconds = 0.0;
+
+	struct FPlayerStateRepStats
+	{
+		uint32 LastRepFrameNum = 0;
+		int32 NumReplications = 0;
+	};
+
+	/** Per connection, how many times each player state went out since PlayerStateRatesStartTime */
+	TMap<TObjectKey<UNetReplicationGraphConnection>, TMap<TObjectKey<APlayerState>, FPlayerStateRepStats>> PlayerStateRepStats;
+	double PlayerStateRatesStartTime = 0.0;
 };
 
 UCLASS()
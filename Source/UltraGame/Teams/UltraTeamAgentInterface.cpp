@@ -2,7 +2,9 @@
 
 #include "Teams/UltraTeamAgentInterface.h"
 
+#include "Engine/World.h"
 #include "UltraLogChannels.h"
+#include "Teams/UltraTeamSubsystem.h"
 #include "UObject/ScriptInterface.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraTeamAgentInterface)
@@ -22,6 +24,12 @@ void IUltraTeamAgentInterface::ConditionalBroadcastTeamChanged(TScriptInterface<
 		UObject* ThisObj = This.GetObject();
 		UE_LOG(LogUltraTeams, Verbose, TEXT("[%s] %s assigned team %d"), *GetClientServerContextString(ThisObj), *GetPathNameSafe(ThisObj), NewTeamIndex);
 
+		// Any cached team lookups may depend on this agent (e.g., via instigators or controllers)
+		if (UUltraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<UUltraTeamSubsystem>(ThisObj ? ThisObj->GetWorld() : nullptr))
+		{
+			TeamSubsystem->InvalidateTeamMembershipCache();
+		}
+
 		This.GetInterface()->GetTeamChangedDelegateChecked().Broadcast(ThisObj, OldTeamIndex, NewTeamIndex);
 	}
 }
@@ -3,6 +3,8 @@
 #include "Teams/UltraTeamSubsystem.h"
 
 #include "AbilitySystemGlobals.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "UltraLogChannels.h"
@@ -17,10 +19,30 @@
 
 class FSubsystemCollectionBase;
 
+namespace UltraTeams
+{
+	static bool bUseTeamMembershipCache = true;
+	static FAutoConsoleVariableRef CVarUseTeamMembershipCache(
+		TEXT("Ultra.Teams.UseMembershipCache"),
+		bUseTeamMembershipCache,
+		TEXT("If true then actor to team and actor to player state lookups are cached until the next team or possession change."),
+		ECVF_Default);
+
+	static int32 MaxCachedTeamMemberships = 4096;
+	static FAutoConsoleVariableRef CVarMaxCachedTeamMemberships(
+		TEXT("Ultra.Teams.MaxCachedMemberships"),
+		MaxCachedTeamMemberships,
+		TEXT("Number of cached team memberships after which the cache is flushed (to avoid holding onto entries for destroyed actors)."),
+		ECVF_Default);
+
+	// Team IDs at or above this are not put in the resolved display asset table
+	static const int32 MaxResolvedTeamIds = 64;
+}
+
 //////////////////////////////////////////////////////////////////////
 // FUltraTeamTrackingInfo
 
-void FUltraTeamTrackingInfo::SetTeamInfo(AUltraTeamInfoBase* Info)
+bool FUltraTeamTrackingInfo::SetTeamInfo(AUltraTeamInfoBase* Info)
 {
 	if (AUltraTeamPublicInfo* NewPublicInfo = Cast<AUltraTeamPublicInfo>(Info))
 	{
@@ -30,10 +52,7 @@ void FUltraTeamTrackingInfo::SetTeamInfo(AUltraTeamInfoBase* Info)
 		UUltraTeamDisplayAsset* OldDisplayAsset = DisplayAsset;
 		DisplayAsset = NewPublicInfo->GetTeamDisplayAsset();
 
-		if (OldDisplayAsset != DisplayAsset)
-		{
-			OnTeamDisplayAssetChanged.Broadcast(DisplayAsset);
-		}
+		return (OldDisplayAsset != DisplayAsset);
 	}
 	else if (AUltraTeamPrivateInfo* NewPrivateInfo = Cast<AUltraTeamPrivateInfo>(Info))
 	{
@@ -44,6 +63,8 @@ void FUltraTeamTrackingInfo::SetTeamInfo(AUltraTeamInfoBase* Info)
 	{
 		checkf(false, TEXT("Expected a public or private team info but got %s"), *GetPathNameSafe(Info))
 	}
+
+	return false;
 }
 
 void FUltraTeamTrackingInfo::RemoveTeamInfo(AUltraTeamInfoBase* Info)
@@ -79,12 +100,29 @@ void UUltraTeamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	};
 
 	CheatManagerRegistrationHandle = UCheatManager::RegisterForOnCheatManagerCreated(FOnCheatManagerCreated::FDelegate::CreateLambda(AddTeamCheats));
+
+	// Possession changes can change the player state (and therefore team) an actor resolves to
+	if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		GameInstance->GetOnPawnControllerChanged().AddDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
 }
 
 void UUltraTeamSubsystem::Deinitialize()
 {
 	UCheatManager::UnregisterFromOnCheatManagerCreated(CheatManagerRegistrationHandle);
 
+	if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		GameInstance->GetOnPawnControllerChanged().RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+
+	TeamMembershipCache.Reset();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(DisplayAssetBroadcastHandle);
+	DisplayAssetBroadcastHandle.Reset();
+	PendingDisplayAssetBroadcasts.Reset();
+
 	Super::Deinitialize();
 }
 
@@ -99,7 +137,11 @@ bool UUltraTeamSubsystem::RegisterTeamInfo(AUltraTeamInfoBase* TeamInfo)
 	if (ensure(TeamId != INDEX_NONE))
 	{
 		FUltraTeamTrackingInfo& Entry = TeamMap.FindOrAdd(TeamId);
-		Entry.SetTeamInfo(TeamInfo);
+		if (Entry.SetTeamInfo(TeamInfo))
+		{
+			RebuildResolvedDisplayAssets();
+			QueueDisplayAssetChanged(TeamId);
+		}
 
 		return true;
 	}
@@ -151,6 +193,64 @@ bool UUltraTeamSubsystem::ChangeTeamForActor(AActor* ActorToChange, int32 NewTea
 }
 
 int32 UUltraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
+{
+	if ((TestObject == nullptr) || !UltraTeams::bUseTeamMembershipCache)
+	{
+		return FindTeamFromObjectUncached(TestObject);
+	}
+
+	return GetCachedTeamMembership(TestObject).TeamId;
+}
+
+const AUltraPlayerState* UUltraTeamSubsystem::FindPlayerStateFromActor(const AActor* PossibleTeamActor) const
+{
+	if ((PossibleTeamActor == nullptr) || !UltraTeams::bUseTeamMembershipCache)
+	{
+		return FindPlayerStateFromActorUncached(PossibleTeamActor);
+	}
+
+	return GetCachedTeamMembership(PossibleTeamActor).PlayerState.Get();
+}
+
+FUltraCachedTeamMembership UUltraTeamSubsystem::GetCachedTeamMembership(const UObject* TestObject) const
+{
+	const TObjectKey<UObject> CacheKey(TestObject);
+
+	if (const FUltraCachedTeamMembership* ExistingEntry = TeamMembershipCache.Find(CacheKey))
+	{
+		// A player state that has since been destroyed means the entry is out of date
+		if (!ExistingEntry->bHasPlayerState || ExistingEntry->PlayerState.IsValid())
+		{
+			return *ExistingEntry;
+		}
+	}
+
+	if (TeamMembershipCache.Num() >= UltraTeams::MaxCachedTeamMemberships)
+	{
+		TeamMembershipCache.Reset();
+	}
+
+	const AUltraPlayerState* PlayerState = FindPlayerStateFromActorUncached(Cast<const AActor>(TestObject));
+
+	FUltraCachedTeamMembership& NewEntry = TeamMembershipCache.FindOrAdd(CacheKey);
+	NewEntry.TeamId = FindTeamFromObjectUncached(TestObject);
+	NewEntry.PlayerState = PlayerState;
+	NewEntry.bHasPlayerState = (PlayerState != nullptr);
+
+	return NewEntry;
+}
+
+void UUltraTeamSubsystem::InvalidateTeamMembershipCache()
+{
+	TeamMembershipCache.Reset();
+}
+
+void UUltraTeamSubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* NewController)
+{
+	InvalidateTeamMembershipCache();
+}
+
+int32 UUltraTeamSubsystem::FindTeamFromObjectUncached(const UObject* TestObject) const
 {
 	// See if it's directly a team agent
 	if (const IUltraTeamAgentInterface* ObjectWithTeamInterface = Cast<IUltraTeamAgentInterface>(TestObject))
@@ -167,7 +267,7 @@ int32 UUltraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 		}
 
 		// Fall back to finding the associated player state
-		if (const AUltraPlayerState* UltraPS = FindPlayerStateFromActor(TestActor))
+		if (const AUltraPlayerState* UltraPS = FindPlayerStateFromActorUncached(TestActor))
 		{
 			return UltraPS->GetTeamId();
 		}
@@ -176,7 +276,7 @@ int32 UUltraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 	return INDEX_NONE;
 }
 
-const AUltraPlayerState* UUltraTeamSubsystem::FindPlayerStateFromActor(const AActor* PossibleTeamActor) const
+const AUltraPlayerState* UUltraTeamSubsystem::FindPlayerStateFromActorUncached(const AActor* PossibleTeamActor) const
 {
 	if (PossibleTeamActor != nullptr)
 	{
@@ -235,6 +335,26 @@ EUltraTeamComparison UUltraTeamSubsystem::CompareTeams(const UObject* A, const U
 	return CompareTeams(A, B, /*out*/ TeamIdA, /*out*/ TeamIdB);
 }
 
+void UUltraTeamSubsystem::CompareTeamsBatch(const UObject* Instigator, TConstArrayView<const UObject*> Targets, TArray<EUltraTeamComparison>& OutRelations) const
+{
+	OutRelations.Reset(Targets.Num());
+
+	const int32 InstigatorTeamId = FindTeamFromObject(Instigator);
+	for (const UObject* Target : Targets)
+	{
+		const int32 TargetTeamId = FindTeamFromObject(Target);
+
+		if ((InstigatorTeamId == INDEX_NONE) || (TargetTeamId == INDEX_NONE))
+		{
+			OutRelations.Add(EUltraTeamComparison::InvalidArgument);
+		}
+		else
+		{
+			OutRelations.Add((InstigatorTeamId == TargetTeamId) ? EUltraTeamComparison::OnSameTeam : EUltraTeamComparison::DifferentTeams);
+		}
+	}
+}
+
 void UUltraTeamSubsystem::FindTeamFromActor(const UObject* TestObject, bool& bIsPartOfTeam, int32& TeamId) const
 {
 	TeamId = FindTeamFromObject(TestObject);
@@ -364,10 +484,25 @@ bool UUltraTeamSubsystem::CanCauseScore(const UObject* Instigator, const UObject
 }
 
 UUltraTeamDisplayAsset* UUltraTeamSubsystem::GetTeamDisplayAsset(int32 TeamId, int32 ViewerTeamId)
+{
+	if ((TeamId >= 0) && (TeamId < NumResolvedTeamIds) && (ViewerTeamId >= INDEX_NONE) && (ViewerTeamId < NumResolvedTeamIds))
+	{
+		return ResolvedDisplayAssets[TeamId * (NumResolvedTeamIds + 1) + (ViewerTeamId + 1)];
+	}
+
+	return ResolveTeamDisplayAsset(TeamId, ViewerTeamId);
+}
+
+UUltraTeamDisplayAsset* UUltraTeamSubsystem::GetEffectiveTeamDisplayAsset(int32 TeamId, UObject* ViewerTeamAgent)
+{
+	return GetTeamDisplayAsset(TeamId, FindTeamFromObject(ViewerTeamAgent));
+}
+
+UUltraTeamDisplayAsset* UUltraTeamSubsystem::ResolveTeamDisplayAsset(int32 TeamId, int32 ViewerTeamId) const
 {
 	// Currently ignoring ViewerTeamId
 
-	if (FUltraTeamTrackingInfo* Entry = TeamMap.Find(TeamId))
+	if (const FUltraTeamTrackingInfo* Entry = TeamMap.Find(TeamId))
 	{
 		return Entry->DisplayAsset;
 	}
@@ -375,23 +510,95 @@ UUltraTeamDisplayAsset* UUltraTeamSubsystem::GetTeamDisplayAsset(int32 TeamId, i
 	return nullptr;
 }
 
-UUltraTeamDisplayAsset* UUltraTeamSubsystem::GetEffectiveTeamDisplayAsset(int32 TeamId, UObject* ViewerTeamAgent)
+void UUltraTeamSubsystem::RebuildResolvedDisplayAssets()
 {
-	return GetTeamDisplayAsset(TeamId, FindTeamFromObject(ViewerTeamAgent));
+	int32 MaxTeamId = INDEX_NONE;
+	for (const auto& KVP : TeamMap)
+	{
+		if (KVP.Key < UltraTeams::MaxResolvedTeamIds)
+		{
+			MaxTeamId = FMath::Max(MaxTeamId, KVP.Key);
+		}
+	}
+
+	NumResolvedTeamIds = MaxTeamId + 1;
+
+	const int32 NumViewerSlots = NumResolvedTeamIds + 1;
+	ResolvedDisplayAssets.SetNumZeroed(NumResolvedTeamIds * NumViewerSlots);
+	ResolvedDisplayAssetVersions.SetNumZeroed(NumResolvedTeamIds);
+
+	for (int32 TeamId = 0; TeamId < NumResolvedTeamIds; ++TeamId)
+	{
+		const FUltraTeamTrackingInfo* Entry = TeamMap.Find(TeamId);
+		ResolvedDisplayAssetVersions[TeamId] = Entry ? Entry->DisplayAssetVersion : 0;
+
+		for (int32 ViewerTeamId = INDEX_NONE; ViewerTeamId < NumResolvedTeamIds; ++ViewerTeamId)
+		{
+			ResolvedDisplayAssets[TeamId * NumViewerSlots + (ViewerTeamId + 1)] = ResolveTeamDisplayAsset(TeamId, ViewerTeamId);
+		}
+	}
+}
+
+uint32 UUltraTeamSubsystem::GetTeamDisplayAssetVersion(int32 TeamId) const
+{
+	if ((TeamId >= 0) && (TeamId < NumResolvedTeamIds))
+	{
+		return ResolvedDisplayAssetVersions[TeamId];
+	}
+
+	const FUltraTeamTrackingInfo* Entry = TeamMap.Find(TeamId);
+	return Entry ? Entry->DisplayAssetVersion : 0;
 }
 
-void UUltraTeamSubsystem::NotifyTeamDisplayAssetModified(UUltraTeamDisplayAsset* /*ModifiedAsset*/)
+void UUltraTeamSubsystem::NotifyTeamDisplayAssetModified(UUltraTeamDisplayAsset* ModifiedAsset)
 {
-	// Broadcasting to all observers when a display asset is edited right now, instead of only the edited one
 	for (const auto& KVP : TeamMap)
 	{
-		const int32 TeamId = KVP.Key;
-		const FUltraTeamTrackingInfo& TrackingInfo = KVP.Value;
+		if ((ModifiedAsset == nullptr) || (KVP.Value.DisplayAsset == ModifiedAsset))
+		{
+			QueueDisplayAssetChanged(KVP.Key);
+		}
+	}
+}
+
+void UUltraTeamSubsystem::QueueDisplayAssetChanged(int32 TeamId)
+{
+	if (FUltraTeamTrackingInfo* Entry = TeamMap.Find(TeamId))
+	{
+		++Entry->DisplayAssetVersion;
+		if ((TeamId >= 0) && (TeamId < NumResolvedTeamIds))
+		{
+			ResolvedDisplayAssetVersions[TeamId] = Entry->DisplayAssetVersion;
+		}
+	}
 
-		TrackingInfo.OnTeamDisplayAssetChanged.Broadcast(TrackingInfo.DisplayAsset);
+	// Several changes to the same team in one frame (e.g., dragging a color slider) only notify observers once
+	PendingDisplayAssetBroadcasts.AddUnique(TeamId);
+	if (!DisplayAssetBroadcastHandle.IsValid())
+	{
+		DisplayAssetBroadcastHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::BroadcastPendingDisplayAssetChanges));
 	}
 }
 
+bool UUltraTeamSubsystem::BroadcastPendingDisplayAssetChanges(float DeltaTime)
+{
+	DisplayAssetBroadcastHandle.Reset();
+
+	const TArray<int32> TeamIdsToBroadcast = MoveTemp(PendingDisplayAssetBroadcasts);
+	PendingDisplayAssetBroadcasts.Reset();
+
+	for (const int32 TeamId : TeamIdsToBroadcast)
+	{
+		if (const FUltraTeamTrackingInfo* Entry = TeamMap.Find(TeamId))
+		{
+			Entry->OnTeamDisplayAssetChanged.Broadcast(Entry->DisplayAsset);
+		}
+	}
+
+	// Only run once, the next change adds the ticker again
+	return false;
+}
+
 FOnUltraTeamDisplayAssetChangedDelegate& UUltraTeamSubsystem::GetTeamDisplayAssetChangedDelegate(int32 TeamId)
 {
 	return TeamMap.FindOrAdd(TeamId).OnTeamDisplayAssetChanged;
@@ -2,11 +2,15 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "UltraTeamSubsystem.generated.h"
 
 class AActor;
+class AController;
+class APawn;
 class AUltraPlayerState;
 class AUltraTeamInfoBase;
 class AUltraTeamPrivateInfo;
@@ -36,8 +40,12 @@ public:
 	UPROPERTY()
 	FOnUltraTeamDisplayAssetChangedDelegate OnTeamDisplayAssetChanged;
 
+	// Bumped every time the display asset changes or is edited
+	uint32 DisplayAssetVersion = 0;
+
 public:
-	void SetTeamInfo(AUltraTeamInfoBase* Info);
+	// Returns true if this changed the display asset
+	bool SetTeamInfo(AUltraTeamInfoBase* Info);
 	void RemoveTeamInfo(AUltraTeamInfoBase* Info);
 };
 
@@ -55,6 +63,19 @@ enum class EUltraTeamComparison : uint8
 	InvalidArgument
 };
 
+// Cached result of resolving the team membership of an object (see UUltraTeamSubsystem::FindTeamFromObject)
+struct FUltraCachedTeamMembership
+{
+	// The team ID the object resolved to, or INDEX_NONE if it is not part of a team
+	int32 TeamId = INDEX_NONE;
+
+	// The player state associated with the object, if any
+	TWeakObjectPtr<const AUltraPlayerState> PlayerState;
+
+	// Was a player state found when this entry was resolved? (used to detect the player state going away)
+	bool bHasPlayerState = false;
+};
+
 /** A subsystem for easy access to team information for team-based actors (e.g., pawns or player states) */
 UCLASS()
 class ULTRAGAME_API UUltraTeamSubsystem : public UWorldSubsystem
@@ -96,9 +117,15 @@ public:
 	// Compare the teams of two actors and returns a value indicating if they are on same teams, different teams, or one/both are invalid
 	EUltraTeamComparison CompareTeams(const UObject* A, const UObject* B) const;
 
+	// Compares the team of the instigator against each of the targets, writing one relation per target into OutRelations
+	void CompareTeamsBatch(const UObject* Instigator, TConstArrayView<const UObject*> Targets, TArray<EUltraTeamComparison>& OutRelations) const;
+
 	// Returns true if the instigator can add score to the target, taking into account the friendly fire settings
 	bool CanCauseScore(const UObject* Instigator, const UObject* Target, bool bAllowScoreToSelf = true) const;
 
+	// Throws away all cached team memberships; called whenever a team agent changes team or a pawn changes controller
+	void InvalidateTeamMembershipCache();
+
 	// Adds a specified number of stacks to the tag (does nothing if StackCount is below 1)
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Teams)
 	void AddTeamTagStack(int32 TeamId, FGameplayTag Tag, int32 StackCount);
@@ -133,15 +160,59 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure=false, Category=Teams)
 	TArray<int32> GetTeamIDs() const;
 
-	// Called when a team display asset has been edited, causes all team color observers to update
+	// Returns a number that changes whenever the display asset for the specified team changes or is edited,
+	// so anything caching values derived from it can cheaply check if they are stale
+	uint32 GetTeamDisplayAssetVersion(int32 TeamId) const;
+
+	// Called when a team display asset has been edited, causes the observers of teams using it to update
 	void NotifyTeamDisplayAssetModified(UUltraTeamDisplayAsset* ModifiedAsset);
 
 	// Register for a team display asset notification for the specified team ID
 	FOnUltraTeamDisplayAssetChangedDelegate& GetTeamDisplayAssetChangedDelegate(int32 TeamId);
 
+private:
+	// Returns the cached team membership for the object, resolving and caching it if needed
+	FUltraCachedTeamMembership GetCachedTeamMembership(const UObject* TestObject) const;
+
+	// Resolves the team of an object without going through the membership cache
+	int32 FindTeamFromObjectUncached(const UObject* TestObject) const;
+
+	// Resolves the player state of an actor without going through the membership cache
+	const AUltraPlayerState* FindPlayerStateFromActorUncached(const AActor* PossibleTeamActor) const;
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* NewController);
+
+	// Works out which display asset to show for a team to a viewer on another team, without using the resolved table
+	UUltraTeamDisplayAsset* ResolveTeamDisplayAsset(int32 TeamId, int32 ViewerTeamId) const;
+
+	// Refills ResolvedDisplayAssets after a team was added or its display asset changed
+	void RebuildResolvedDisplayAssets();
+
+	// Bumps the display asset version of a team and broadcasts the change to its observers on the next tick
+	void QueueDisplayAssetChanged(int32 TeamId);
+	bool BroadcastPendingDisplayAssetChanges(float DeltaTime);
+
 private:
 	UPROPERTY()
 	TMap<int32, FUltraTeamTrackingInfo> TeamMap;
 
+	// Display assets for every (team, viewer team) pair, indexed by TeamId * (NumResolvedTeamIds + 1) + (ViewerTeamId + 1)
+	// Team IDs outside [0, NumResolvedTeamIds) are resolved through TeamMap instead
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UUltraTeamDisplayAsset>> ResolvedDisplayAssets;
+
+	// Mirrors FUltraTeamTrackingInfo::DisplayAssetVersion, indexed by team ID
+	TArray<uint32> ResolvedDisplayAssetVersions;
+
+	int32 NumResolvedTeamIds = 0;
+
+	// Teams with a display asset change to broadcast on the next tick
+	TArray<int32> PendingDisplayAssetBroadcasts;
+	FTSTicker::FDelegateHandle DisplayAssetBroadcastHandle;
+
+	// Team membership of objects that have been queried since the last team or possession change
+	mutable TMap<TObjectKey<UObject>, FUltraCachedTeamMembership> TeamMembershipCache;
+
 	FDelegateHandle CheatManagerRegistrationHandle;
 };
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/Phases/UltraGamePhaseSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "NativeGameplayTags.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_GamePhase_Playing, "Test.GamePhase.Playing");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_GamePhase_Playing_WarmUp, "Test.GamePhase.Playing.WarmUp");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_GamePhase_Playing_SuddenDeath, "Test.GamePhase.Playing.SuddenDeath");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_GamePhase_PostGame, "Test.GamePhase.PostGame");
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUltraGamePhaseSubsystemTest, "Ultra.GamePhase.Subsystem", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FUltraGamePhaseSubsystemTest::RunTest(const FString& Parameters)
+{
+	UUltraGamePhaseSubsystem* Subsystem = NewObject<UUltraGamePhaseSubsystem>(GetTransientPackage());
+
+	// Does what OnBeginPhase does once the ability system has activated the phase ability, ending the phases it replaces
+	auto StartTestPhase = [Subsystem](const FGameplayTag& PhaseTag, TArray<FGameplayAbilitySpecHandle>* OutEndedPhases = nullptr)
+	{
+		TArray<FGameplayAbilitySpecHandle> PhasesToEnd;
+		Subsystem->GetPhasesEndedBy(PhaseTag, PhasesToEnd);
+		for (const FGameplayAbilitySpecHandle& HandleToEnd : PhasesToEnd)
+		{
+			Subsystem->RecordPhaseEnded(HandleToEnd);
+		}
+
+		if (OutEndedPhases)
+		{
+			*OutEndedPhases = PhasesToEnd;
+		}
+
+		FGameplayAbilitySpecHandle PhaseHandle;
+		PhaseHandle.GenerateNewHandle();
+		Subsystem->RecordPhaseStarted(PhaseHandle, PhaseTag);
+		return PhaseHandle;
+	};
+
+	int32 PlayingExactStarts = 0;
+	int32 PlayingPartialStarts = 0;
+	int32 WarmUpExactStarts = 0;
+	int32 WarmUpExactEnds = 0;
+	int32 PlayingExactEnds = 0;
+	int32 PlayingPartialEnds = 0;
+
+	auto MakeCounter = [](int32& Counter)
+	{
+		return FUltraGamePhaseTagDelegate::CreateLambda([&Counter](const FGameplayTag&) { ++Counter; });
+	};
+
+	Subsystem->WhenPhaseStartsOrIsActive(TAG_Test_GamePhase_Playing, EPhaseTagMatchType::ExactMatch, MakeCounter(PlayingExactStarts));
+	Subsystem->WhenPhaseStartsOrIsActive(TAG_Test_GamePhase_Playing, EPhaseTagMatchType::PartialMatch, MakeCounter(PlayingPartialStarts));
+	Subsystem->WhenPhaseStartsOrIsActive(TAG_Test_GamePhase_Playing_WarmUp, EPhaseTagMatchType::ExactMatch, MakeCounter(WarmUpExactStarts));
+	Subsystem->WhenPhaseEnds(TAG_Test_GamePhase_Playing_WarmUp, EPhaseTagMatchType::ExactMatch, MakeCounter(WarmUpExactEnds));
+	Subsystem->WhenPhaseEnds(TAG_Test_GamePhase_Playing, EPhaseTagMatchType::ExactMatch, MakeCounter(PlayingExactEnds));
+	Subsystem->WhenPhaseEnds(TAG_Test_GamePhase_Playing, EPhaseTagMatchType::PartialMatch, MakeCounter(PlayingPartialEnds));
+
+	TestEqual(TEXT("Observers registered before any phase do not fire"), PlayingExactStarts + PlayingPartialStarts + WarmUpExactStarts, 0);
+
+	// A child phase on its own keeps its parents active until it ends
+	{
+		const FGameplayAbilitySpecHandle WarmUpHandle = StartTestPhase(TAG_Test_GamePhase_Playing_WarmUp);
+		TestTrue(TEXT("Parent of a lone child phase is active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing));
+		TestEqual(TEXT("Partial observer of the parent fires once for the child"), PlayingPartialStarts, 1);
+		TestEqual(TEXT("Exact observer of the parent ignores the child"), PlayingExactStarts, 0);
+		TestEqual(TEXT("Exact observer of the child fires once"), WarmUpExactStarts, 1);
+
+		Subsystem->RecordPhaseEnded(WarmUpHandle);
+		TestFalse(TEXT("Parent of a removed lone child phase is no longer active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing));
+		TestFalse(TEXT("Removed child phase is no longer active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing_WarmUp));
+		TestEqual(TEXT("Exact end observer of the child fires once"), WarmUpExactEnds, 1);
+		TestEqual(TEXT("Partial end observer of the parent fires once for the child"), PlayingPartialEnds, 1);
+		TestEqual(TEXT("Exact end observer of the parent ignores the child"), PlayingExactEnds, 0);
+	}
+
+	PlayingExactStarts = PlayingPartialStarts = WarmUpExactStarts = 0;
+	WarmUpExactEnds = PlayingExactEnds = PlayingPartialEnds = 0;
+
+	// Nested phases, the parent stays active while a child starts and ends
+	TArray<FGameplayAbilitySpecHandle> EndedPhases;
+	const FGameplayAbilitySpecHandle PlayingHandle = StartTestPhase(TAG_Test_GamePhase_Playing, &EndedPhases);
+	TestEqual(TEXT("Starting the first phase ends nothing"), EndedPhases.Num(), 0);
+	TestEqual(TEXT("Exact observer of the parent fires once"), PlayingExactStarts, 1);
+	TestEqual(TEXT("Partial observer of the parent fires once"), PlayingPartialStarts, 1);
+
+	const FGameplayAbilitySpecHandle WarmUpHandle = StartTestPhase(TAG_Test_GamePhase_Playing_WarmUp, &EndedPhases);
+	TestEqual(TEXT("Starting a child phase does not end its parent"), EndedPhases.Num(), 0);
+	TestTrue(TEXT("Parent stays active while a child is active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing));
+	TestTrue(TEXT("Child phase is active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing_WarmUp));
+	TestEqual(TEXT("Exact observer of the parent does not fire again for the child"), PlayingExactStarts, 1);
+	TestEqual(TEXT("Partial observer of the parent fires once for the child"), PlayingPartialStarts, 2);
+	TestEqual(TEXT("Exact observer of the child fires once"), WarmUpExactStarts, 1);
+
+	// Sibling phases end each other, but not the shared parent
+	const FGameplayAbilitySpecHandle SuddenDeathHandle = StartTestPhase(TAG_Test_GamePhase_Playing_SuddenDeath, &EndedPhases);
+	TestEqual(TEXT("Starting a sibling ends exactly one phase"), EndedPhases.Num(), 1);
+	TestTrue(TEXT("Starting a sibling ends the other sibling"), EndedPhases.Contains(WarmUpHandle));
+	TestFalse(TEXT("Ended sibling is no longer active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing_WarmUp));
+	TestTrue(TEXT("New sibling is active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing_SuddenDeath));
+	TestTrue(TEXT("Parent survives a sibling change"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing));
+	TestEqual(TEXT("Exact end observer of the ended sibling fires once"), WarmUpExactEnds, 1);
+	TestEqual(TEXT("Exact end observer of the parent does not fire for a child"), PlayingExactEnds, 0);
+
+	// Ending the child leaves the parent phase itself active
+	Subsystem->RecordPhaseEnded(SuddenDeathHandle);
+	TestFalse(TEXT("Removed child phase is no longer active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing_SuddenDeath));
+	TestTrue(TEXT("Parent phase is still active after its child is removed"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing));
+
+	// Registering for an already active phase fires immediately, exactly once
+	int32 LateStarts = 0;
+	Subsystem->WhenPhaseStartsOrIsActive(TAG_Test_GamePhase_Playing, EPhaseTagMatchType::ExactMatch, MakeCounter(LateStarts));
+	TestEqual(TEXT("Observer registered for an active phase fires once"), LateStarts, 1);
+
+	// A phase outside the tree ends everything that is not one of its ancestors
+	StartTestPhase(TAG_Test_GamePhase_PostGame, &EndedPhases);
+	TestEqual(TEXT("Starting an unrelated phase ends the remaining phase"), EndedPhases.Num(), 1);
+	TestTrue(TEXT("Starting an unrelated phase ends the parent"), EndedPhases.Contains(PlayingHandle));
+	TestFalse(TEXT("Parent is no longer active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_Playing));
+	TestTrue(TEXT("Unrelated phase is active"), Subsystem->IsPhaseActive(TAG_Test_GamePhase_PostGame));
+	TestEqual(TEXT("Exact end observer of the parent fires once"), PlayingExactEnds, 1);
+	TestEqual(TEXT("Late observer is not called again"), LateStarts, 1);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/UltraPawnPoolSnapshot.h"
+
+#include "AbilitySystem/UltraAbilitySystemComponent.h"
+#include "Character/UltraDespawnComponent.h"
+#include "Character/UltraPawnData.h"
+#include "Character/UltraPawnExtensionComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Cosmetics/UltraPawnComponent_CharacterParts.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+FUltraPawnPoolSnapshot FUltraPawnPoolSnapshot::Capture(const APawn* Pawn)
+{
+	check(Pawn);
+
+	FUltraPawnPoolSnapshot Snapshot;
+	Snapshot.PawnClass = Pawn->GetClass();
+	Snapshot.bHidden = Pawn->IsHidden();
+	Snapshot.bActorTickEnabled = Pawn->IsActorTickEnabled();
+	Snapshot.NetDormancy = (uint8)Pawn->NetDormancy;
+
+	if (const UUltraPawnExtensionComponent* PawnExtComp = UUltraPawnExtensionComponent::FindPawnExtensionComponent(Pawn))
+	{
+		Snapshot.PawnData = PawnExtComp->GetPawnData<UUltraPawnData>();
+
+		if (const UUltraAbilitySystemComponent* UltraASC = PawnExtComp->GetUltraAbilitySystemComponent())
+		{
+			Snapshot.bIsAbilitySystemAvatar = (UltraASC->GetAvatarActor() == Pawn);
+			UltraASC->GetOwnedGameplayTags(Snapshot.OwnedTags);
+		}
+	}
+
+	if (const ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		const UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
+		Snapshot.bCapsuleCollisionEnabled = CapsuleComp->IsCollisionEnabled();
+		Snapshot.CapsuleCollisionProfile = CapsuleComp->GetCollisionProfileName();
+
+		const UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement();
+		Snapshot.MovementMode = (uint8)MoveComp->MovementMode;
+		Snapshot.bMovementTickEnabled = MoveComp->IsComponentTickEnabled();
+
+		const USkeletalMeshComponent* MeshComp = Character->GetMesh();
+		Snapshot.bMeshTickEnabled = MeshComp->IsComponentTickEnabled();
+		Snapshot.bMeshSimulatingPhysics = MeshComp->IsSimulatingPhysics();
+		Snapshot.MeshCollisionEnabled = (uint8)MeshComp->GetCollisionEnabled();
+		Snapshot.MeshCollisionProfile = MeshComp->GetCollisionProfileName();
+		Snapshot.bMeshAttachedToCapsule = (MeshComp->GetAttachParent() == CapsuleComp);
+		Snapshot.MeshRelativeTransform = MeshComp->GetRelativeTransform();
+	}
+
+	if (const UUltraDespawnComponent* DespawnComponent = UUltraDespawnComponent::FindDespawnComponent(Pawn))
+	{
+		Snapshot.DespawnState = (uint8)DespawnComponent->GetDespawnState();
+	}
+
+	if (const UUltraPawnComponent_CharacterParts* PartsComponent = Pawn->FindComponentByClass<UUltraPawnComponent_CharacterParts>())
+	{
+		Snapshot.NumCharacterParts = PartsComponent->GetCharacterPartActors().Num();
+	}
+
+	return Snapshot;
+}
+
+bool FUltraPawnPoolSnapshot::Compare(const FUltraPawnPoolSnapshot& Fresh, const FUltraPawnPoolSnapshot& Recycled, TFunctionRef<void(const TCHAR* What, const FString& FreshValue, const FString& RecycledValue)> OnMismatch)
+{
+	bool bMatches = true;
+
+	auto Check = [&bMatches, &OnMismatch](bool bEqual, const TCHAR* What, const FString& FreshValue, const FString& RecycledValue)
+	{
+		if (!bEqual)
+		{
+			OnMismatch(What, FreshValue, RecycledValue);
+			bMatches = false;
+		}
+	};
+
+	Check(Fresh.PawnClass == Recycled.PawnClass, TEXT("pawn class"), GetNameSafe(Fresh.PawnClass), GetNameSafe(Recycled.PawnClass));
+	Check(Fresh.PawnData == Recycled.PawnData, TEXT("pawn data"), GetNameSafe(Fresh.PawnData), GetNameSafe(Recycled.PawnData));
+	Check(Fresh.bHidden == Recycled.bHidden, TEXT("hidden"), LexToString(Fresh.bHidden), LexToString(Recycled.bHidden));
+	Check(Fresh.bActorTickEnabled == Recycled.bActorTickEnabled, TEXT("actor tick"), LexToString(Fresh.bActorTickEnabled), LexToString(Recycled.bActorTickEnabled));
+	Check(Fresh.bCapsuleCollisionEnabled == Recycled.bCapsuleCollisionEnabled, TEXT("capsule collision"), LexToString(Fresh.bCapsuleCollisionEnabled), LexToString(Recycled.bCapsuleCollisionEnabled));
+	Check(Fresh.CapsuleCollisionProfile == Recycled.CapsuleCollisionProfile, TEXT("capsule collision profile"), Fresh.CapsuleCollisionProfile.ToString(), Recycled.CapsuleCollisionProfile.ToString());
+	Check(Fresh.MovementMode == Recycled.MovementMode, TEXT("movement mode"), LexToString(Fresh.MovementMode), LexToString(Recycled.MovementMode));
+	Check(Fresh.bMovementTickEnabled == Recycled.bMovementTickEnabled, TEXT("movement tick"), LexToString(Fresh.bMovementTickEnabled), LexToString(Recycled.bMovementTickEnabled));
+	Check(Fresh.bMeshTickEnabled == Recycled.bMeshTickEnabled, TEXT("mesh tick"), LexToString(Fresh.bMeshTickEnabled), LexToString(Recycled.bMeshTickEnabled));
+	Check(Fresh.bMeshSimulatingPhysics == Recycled.bMeshSimulatingPhysics, TEXT("mesh physics simulation"), LexToString(Fresh.bMeshSimulatingPhysics), LexToString(Recycled.bMeshSimulatingPhysics));
+	Check(Fresh.MeshCollisionEnabled == Recycled.MeshCollisionEnabled, TEXT("mesh collision"), LexToString(Fresh.MeshCollisionEnabled), LexToString(Recycled.MeshCollisionEnabled));
+	Check(Fresh.MeshCollisionProfile == Recycled.MeshCollisionProfile, TEXT("mesh collision profile"), Fresh.MeshCollisionProfile.ToString(), Recycled.MeshCollisionProfile.ToString());
+	Check(Fresh.bMeshAttachedToCapsule == Recycled.bMeshAttachedToCapsule, TEXT("mesh attached to capsule"), LexToString(Fresh.bMeshAttachedToCapsule), LexToString(Recycled.bMeshAttachedToCapsule));
+	Check(Fresh.MeshRelativeTransform.Equals(Recycled.MeshRelativeTransform), TEXT("mesh relative transform"), Fresh.MeshRelativeTransform.ToString(), Recycled.MeshRelativeTransform.ToString());
+	Check(Fresh.DespawnState == Recycled.DespawnState, TEXT("despawn state"), LexToString(Fresh.DespawnState), LexToString(Recycled.DespawnState));
+	Check(Fresh.bIsAbilitySystemAvatar == Recycled.bIsAbilitySystemAvatar, TEXT("ability system avatar"), LexToString(Fresh.bIsAbilitySystemAvatar), LexToString(Recycled.bIsAbilitySystemAvatar));
+	Check(Fresh.OwnedTags == Recycled.OwnedTags, TEXT("owned tags"), Fresh.OwnedTags.ToStringSimple(), Recycled.OwnedTags.ToStringSimple());
+	Check(Fresh.NetDormancy == Recycled.NetDormancy, TEXT("net dormancy"), LexToString(Fresh.NetDormancy), LexToString(Recycled.NetDormancy));
+	Check(Fresh.NumCharacterParts == Recycled.NumCharacterParts, TEXT("character part count"), LexToString(Fresh.NumCharacterParts), LexToString(Recycled.NumCharacterParts));
+
+	return bMatches;
+}
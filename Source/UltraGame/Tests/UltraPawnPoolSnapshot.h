@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Templates/Function.h"
+
+class APawn;
+class UClass;
+class UUltraPawnData;
+
+/**
+ * FUltraPawnPoolSnapshot
+ *
+ *	The state of a pawn that has to be the same for a recycled pawn as for a freshly spawned one.
+ *	Shared by the pawn pool automation test and the UltraTestControllerPawnPool Gauntlet test.
+ */
+struct FUltraPawnPoolSnapshot
+{
+	const UClass* PawnClass = nullptr;
+	const UUltraPawnData* PawnData = nullptr;
+	bool bHidden = false;
+	bool bActorTickEnabled = false;
+	bool bCapsuleCollisionEnabled = false;
+	FName CapsuleCollisionProfile;
+	uint8 MovementMode = 0;
+	bool bMovementTickEnabled = false;
+	bool bMeshTickEnabled = false;
+	bool bMeshSimulatingPhysics = false;
+	uint8 MeshCollisionEnabled = 0;
+	FName MeshCollisionProfile;
+	bool bMeshAttachedToCapsule = false;
+	FTransform MeshRelativeTransform;
+	uint8 DespawnState = 0;
+	bool bIsAbilitySystemAvatar = false;
+	FGameplayTagContainer OwnedTags;
+	uint8 NetDormancy = 0;
+	int32 NumCharacterParts = 0;
+
+	static FUltraPawnPoolSnapshot Capture(const APawn* Pawn);
+
+	// Calls OnMismatch for every value that differs between the two snapshots, returns true if they all match
+	static bool Compare(const FUltraPawnPoolSnapshot& Fresh, const FUltraPawnPoolSnapshot& Recycled, TFunctionRef<void(const TCHAR* What, const FString& FreshValue, const FString& RecycledValue)> OnMismatch);
+};
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/UltraCharacter.h"
+#include "Character/UltraDespawnComponent.h"
+#include "Character/UltraPawnData.h"
+#include "Character/UltraPawnExtensionComponent.h"
+#include "Character/UltraPawnPoolSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/UltraPawnPoolSnapshot.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUltraPawnPoolTest, "Ultra.Character.PawnPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FUltraPawnPoolTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/ false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// Spawned characters begin play and register their tick functions like they would in a running game
+	World->InitializeActorsForPlay(FURL());
+	World->SetBegunPlay(true);
+
+	UUltraPawnData* PawnData = NewObject<UUltraPawnData>(GetTransientPackage());
+
+	auto SpawnTestCharacter = [World, PawnData]()
+	{
+		AUltraCharacter* Character = World->SpawnActor<AUltraCharacter>(AUltraCharacter::StaticClass(), FTransform::Identity);
+		if (Character)
+		{
+			UUltraPawnExtensionComponent::FindPawnExtensionComponent(Character)->SetPawnData(PawnData);
+		}
+		return Character;
+	};
+
+	AUltraCharacter* FreshCharacter = SpawnTestCharacter();
+	AUltraCharacter* RecycledCharacter = SpawnTestCharacter();
+	UUltraPawnPoolSubsystem* PawnPool = World->GetSubsystem<UUltraPawnPoolSubsystem>();
+
+	if (TestNotNull(TEXT("Fresh character spawned"), FreshCharacter) && TestNotNull(TEXT("Recycled character spawned"), RecycledCharacter) && TestNotNull(TEXT("Pawn pool subsystem exists"), PawnPool))
+	{
+		const FUltraPawnPoolSnapshot FreshSnapshot = FUltraPawnPoolSnapshot::Capture(FreshCharacter);
+
+		// Despawn the second character the way a death does, leaving its mesh as a detached ragdoll
+		UUltraDespawnComponent* DespawnComponent = UUltraDespawnComponent::FindDespawnComponent(RecycledCharacter);
+		DespawnComponent->StartDespawn();
+		DespawnComponent->FinishDespawn();
+
+		USkeletalMeshComponent* MeshComp = RecycledCharacter->GetMesh();
+		MeshComp->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		MeshComp->SetCollisionProfileName(TEXT("Ragdoll"));
+		MeshComp->SetSimulatePhysics(true);
+		MeshComp->SetWorldLocation(FVector(0.0, 0.0, -500.0));
+
+		PawnPool->ConfigurePool(/*bInRecyclePawns=*/ true, /*InMaxPooledPawnsPerType=*/ 4);
+		TestTrue(TEXT("Despawned character is taken into the pool"), PawnPool->TryRecyclePawn(RecycledCharacter));
+		TestTrue(TEXT("Pool reports the character as pooled"), PawnPool->IsPawnPooled(RecycledCharacter));
+
+		const FUltraPawnPoolSnapshot PooledSnapshot = FUltraPawnPoolSnapshot::Capture(RecycledCharacter);
+		TestTrue(TEXT("Pooled character is hidden"), PooledSnapshot.bHidden);
+		TestFalse(TEXT("Pooled character does not tick"), PooledSnapshot.bActorTickEnabled);
+		TestFalse(TEXT("Pooled character movement does not tick"), PooledSnapshot.bMovementTickEnabled);
+		TestFalse(TEXT("Pooled character mesh does not tick"), PooledSnapshot.bMeshTickEnabled);
+
+		AUltraCharacter* ReusedCharacter = PawnPool->AcquirePawn(AUltraCharacter::StaticClass(), PawnData, nullptr, FreshCharacter->GetActorTransform());
+		TestEqual(TEXT("Acquiring a pawn reuses the pooled character"), ReusedCharacter, RecycledCharacter);
+		TestFalse(TEXT("Reused character is no longer pooled"), PawnPool->IsPawnPooled(RecycledCharacter));
+
+		if (ReusedCharacter)
+		{
+			FUltraPawnPoolSnapshot::Compare(FreshSnapshot, FUltraPawnPoolSnapshot::Capture(ReusedCharacter), [this](const TCHAR* What, const FString& FreshValue, const FString& RecycledValue)
+			{
+				AddError(FString::Printf(TEXT("Recycled character %s differs, fresh [%s] recycled [%s]"), What, *FreshValue, *RecycledValue));
+			});
+		}
+
+		PawnPool->ConfigurePool(/*bInRecyclePawns=*/ false, /*InMaxPooledPawnsPerType=*/ 0);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(/*bInformEngineOfWorld=*/ false);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#include "Tests/UltraTestControllerAbilityGrantHitch.h"
+
+#include "Engine/World.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameModes/UltraBotCreationComponent.h"
+#include "GameModes/UltraExperienceManagerComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Tests/UltraTestReport.h"
+#include "UltraLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraTestControllerAbilityGrantHitch)
+
+namespace UltraAbilityGrantHitch
+{
+	static IConsoleVariable* FindBatchedCVar()
+	{
+		return IConsoleManager::Get().FindConsoleVariable(TEXT("Ultra.GameFeatures.AddAbilities.Batched"));
+	}
+};
+
+void UUltraTestControllerAbilityGrantHitch::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("AbilityHitchPlugin="), PluginName);
+	FParse::Value(CommandLine, TEXT("AbilityHitchBots="), NumBots);
+	FParse::Value(CommandLine, TEXT("AbilityHitchRuns="), NumRunsPerMode);
+	FParse::Value(CommandLine, TEXT("AbilityHitchSeconds="), MeasureSeconds);
+	FParse::Value(CommandLine, TEXT("AbilityHitchThresholdMs="), HitchThresholdMs);
+	NumBots = FMath::Max(NumBots, 0);
+	NumRunsPerMode = FMath::Max(NumRunsPerMode, 1);
+
+	if (IConsoleVariable* BatchedCVar = UltraAbilityGrantHitch::FindBatchedCVar())
+	{
+		bOriginalBatched = BatchedCVar->GetBool();
+	}
+
+	SetPhase(EPhase::WaitingForExperience);
+}
+
+UUltraBotCreationComponent* UUltraTestControllerAbilityGrantHitch::FindBotCreationComponent() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState == nullptr)
+	{
+		return nullptr;
+	}
+
+	const UUltraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<UUltraExperienceManagerComponent>();
+	if ((ExperienceComponent == nullptr) || !ExperienceComponent->IsExperienceLoaded())
+	{
+		return nullptr;
+	}
+
+	return GameState->FindComponentByClass<UUltraBotCreationComponent>();
+}
+
+void UUltraTestControllerAbilityGrantHitch::SetPhase(EPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void UUltraTestControllerAbilityGrantHitch::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (Phase == EPhase::Done)
+	{
+		return;
+	}
+
+#if WITH_SERVER_CODE
+	UUltraBotCreationComponent* BotComponent = FindBotCreationComponent();
+	if (BotComponent == nullptr)
+	{
+		if ((Phase != EPhase::WaitingForExperience) || ((FPlatformTime::Seconds() - PhaseStartTime) > 300.0))
+		{
+			UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: no loaded experience with a bot creation component in %s"), *GetCurrentMap());
+			Finish(false);
+		}
+		return;
+	}
+
+	MarkHeartbeatActive();
+
+	if ((Phase != EPhase::WaitingForExperience) && (Phase != EPhase::Measuring) && ((FPlatformTime::Seconds() - PhaseStartTime) > StepTimeoutSeconds))
+	{
+		UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: timed out in phase %d of run %d"), (int32)Phase, CurrentRun);
+		Finish(false);
+		return;
+	}
+
+	switch (Phase)
+	{
+	case EPhase::WaitingForExperience:
+		if (PluginName.IsEmpty() || !UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+		{
+			UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: unknown game feature plugin '%s', pass it with -AbilityHitchPlugin="), *PluginName);
+			Finish(false);
+			return;
+		}
+		SetPhase(EPhase::SpawningBots);
+		break;
+
+	case EPhase::SpawningBots:
+		for (int32 Count = 0; (Count < BotsPerFrame) && (BotComponent->GetNumSpawnedBots() < NumBots); ++Count)
+		{
+			BotComponent->Cheat_AddBot();
+		}
+		if (BotComponent->GetNumSpawnedBots() >= NumBots)
+		{
+			UE_LOG(LogUltra, Display, TEXT("AbilityGrantHitch: spawned %d bots"), BotComponent->GetNumSpawnedBots());
+			SetPhase(EPhase::Settling);
+		}
+		break;
+
+	case EPhase::Settling:
+		if ((FPlatformTime::Seconds() - PhaseStartTime) >= SettleSeconds)
+		{
+			StartRun();
+		}
+		break;
+
+	case EPhase::Measuring:
+		FrameMsSamples.Add(TimeDelta * 1000.0);
+		if ((FPlatformTime::Seconds() - ActivationRequestTime) >= MeasureSeconds)
+		{
+			if (!bPluginActive)
+			{
+				if ((FPlatformTime::Seconds() - PhaseStartTime) > StepTimeoutSeconds)
+				{
+					UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: %s did not finish activating"), *PluginName);
+					Finish(false);
+				}
+				break;
+			}
+			FinishRun();
+		}
+		break;
+
+	default:
+		break;
+	}
+#else
+	UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: must be run on a build with server code"));
+	Finish(false);
+#endif
+}
+
+void UUltraTestControllerAbilityGrantHitch::StartRun()
+{
+	const bool bBatched = IsCurrentRunBatched();
+	if (IConsoleVariable* BatchedCVar = UltraAbilityGrantHitch::FindBatchedCVar())
+	{
+		BatchedCVar->Set(bBatched ? 1 : 0, ECVF_SetByCode);
+	}
+
+	FrameMsSamples.Reset();
+	ActivationCompleteTime = 0.0;
+	ActivationRequestTime = FPlatformTime::Seconds();
+	SetPhase(EPhase::Measuring);
+
+	UE_LOG(LogUltra, Display, TEXT("AbilityGrantHitch: run %d, activating %s (%s)"), CurrentRun, *PluginName, bBatched ? TEXT("batched") : TEXT("unbatched"));
+	UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnPluginActivated));
+}
+
+void UUltraTestControllerAbilityGrantHitch::OnPluginActivated(const UE::GameFeatures::FResult& Result)
+{
+	if (Result.HasError())
+	{
+		UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: failed to activate %s: %s"), *PluginName, *Result.GetError());
+		Finish(false);
+		return;
+	}
+
+	bPluginActive = true;
+	ActivationCompleteTime = FPlatformTime::Seconds();
+}
+
+void UUltraTestControllerAbilityGrantHitch::FinishRun()
+{
+	FRunResult& Result = Results.AddDefaulted_GetRef();
+	Result.bBatched = IsCurrentRunBatched();
+	Result.NumFrames = FrameMsSamples.Num();
+	Result.ActivationMs = (ActivationCompleteTime - ActivationRequestTime) * 1000.0;
+
+	double FrameMsSum = 0.0;
+	for (double Sample : FrameMsSamples)
+	{
+		FrameMsSum += Sample;
+		Result.MaxFrameMs = FMath::Max(Result.MaxFrameMs, Sample);
+		Result.NumHitches += (Sample > HitchThresholdMs) ? 1 : 0;
+	}
+	Result.AvgFrameMs = (Result.NumFrames > 0) ? (FrameMsSum / Result.NumFrames) : 0.0;
+
+	UE_LOG(LogUltra, Display, TEXT("AbilityGrantHitch: run %d (%s) worst frame %.2fms, avg %.2fms, %d frames over %.0fms, activation took %.1fms"),
+		CurrentRun, Result.bBatched ? TEXT("batched") : TEXT("unbatched"), Result.MaxFrameMs, Result.AvgFrameMs, Result.NumHitches, HitchThresholdMs, Result.ActivationMs);
+
+	SetPhase(EPhase::Deactivating);
+	UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL, FGameFeaturePluginDeactivateComplete::CreateUObject(this, &ThisClass::OnPluginDeactivated));
+}
+
+void UUltraTestControllerAbilityGrantHitch::OnPluginDeactivated(const UE::GameFeatures::FResult& Result)
+{
+	if (Result.HasError())
+	{
+		UE_LOG(LogUltra, Error, TEXT("AbilityGrantHitch: failed to deactivate %s: %s"), *PluginName, *Result.GetError());
+		Finish(false);
+		return;
+	}
+
+	bPluginActive = false;
+
+	// Drop the granted classes so the next run has to load them again
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	++CurrentRun;
+	if (CurrentRun < (NumRunsPerMode * 2))
+	{
+		SetPhase(EPhase::Settling);
+	}
+	else
+	{
+		WriteReport();
+		Finish(true);
+	}
+}
+
+void UUltraTestControllerAbilityGrantHitch::Finish(bool bSuccess)
+{
+	if (IConsoleVariable* BatchedCVar = UltraAbilityGrantHitch::FindBatchedCVar())
+	{
+		BatchedCVar->Set(bOriginalBatched ? 1 : 0, ECVF_SetByCode);
+	}
+
+	SetPhase(EPhase::Done);
+	EndTest(bSuccess ? 0 : 1);
+}
+
+void UUltraTestControllerAbilityGrantHitch::WriteReport() const
+{
+	FString Report = TEXT("Run,Batched,Bots,Frames,ActivationMs,MaxFrameMs,AvgFrameMs,Hitches\n");
+	for (int32 RunIndex = 0; RunIndex < Results.Num(); ++RunIndex)
+	{
+		const FRunResult& Result = Results[RunIndex];
+		Report += FString::Printf(TEXT("%d,%d,%d,%d,%.3f,%.3f,%.3f,%d\n"),
+			RunIndex, Result.bBatched ? 1 : 0, NumBots, Result.NumFrames, Result.ActivationMs, Result.MaxFrameMs, Result.AvgFrameMs, Result.NumHitches);
+	}
+
+	UltraTestReport::WriteReport(TEXT("AbilityGrantHitch"), TEXT("csv"), Report);
+}
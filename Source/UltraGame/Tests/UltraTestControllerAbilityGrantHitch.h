@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#pragma once
+
+#include "GauntletTestController.h"
+
+#include "UltraTestControllerAbilityGrantHitch.generated.h"
+
+class UObject;
+class UUltraBotCreationComponent;
+namespace UE::GameFeatures { struct FResult; }
+
+/**
+ * Mid-match game feature activation hitch test.
+ *
+ * Run on a dedicated server, e.g. UltraServer <Map> -nullrhi -gauntlet=UltraTestControllerAbilityGrantHitch -AbilityHitchPlugin=<GameFeaturePlugin>
+ * The plugin should grant abilities through UGameFeatureAction_AddAbilities and must not already be activated by the experience.
+ * Once the experience has loaded -AbilityHitchBots bots are added (default 64), then the plugin is activated and deactivated
+ * -AbilityHitchRuns times (default 3) for each value of Ultra.GameFeatures.AddAbilities.Batched, alternating between them.
+ * Garbage is collected after each deactivation so every run has to load the granted classes again.
+ *
+ * For every run the frames from the activation request until -AbilityHitchSeconds later (default 5) are measured and one row
+ * is written to <ProfilingDir>/AbilityGrantHitch/ with the worst frame, average frame and the number of frames over
+ * -AbilityHitchThresholdMs (default 50), then the test exits.
+ */
+UCLASS()
+class UUltraTestControllerAbilityGrantHitch : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class EPhase : uint8
+	{
+		WaitingForExperience,
+		SpawningBots,
+		Settling,
+		Measuring,
+		Deactivating,
+		Done
+	};
+
+	struct FRunResult
+	{
+		bool bBatched = false;
+		int32 NumFrames = 0;
+		double ActivationMs = 0.0;
+		double MaxFrameMs = 0.0;
+		double AvgFrameMs = 0.0;
+		int32 NumHitches = 0;
+	};
+
+	UUltraBotCreationComponent* FindBotCreationComponent() const;
+
+	void SetPhase(EPhase NewPhase);
+	void StartRun();
+	void FinishRun();
+	void Finish(bool bSuccess);
+	void WriteReport() const;
+
+	void OnPluginActivated(const UE::GameFeatures::FResult& Result);
+	void OnPluginDeactivated(const UE::GameFeatures::FResult& Result);
+
+	bool IsCurrentRunBatched() const { return (CurrentRun % 2) == 1; }
+
+private:
+	FString PluginName;
+	FString PluginURL;
+
+	int32 NumBots = 64;
+	int32 NumRunsPerMode = 3;
+	double MeasureSeconds = 5.0;
+	double HitchThresholdMs = 50.0;
+	double SettleSeconds = 3.0;
+	double StepTimeoutSeconds = 120.0;
+	int32 BotsPerFrame = 4;
+
+	EPhase Phase = EPhase::WaitingForExperience;
+	double PhaseStartTime = 0.0;
+
+	// Runs alternate unbatched/batched, starting with unbatched
+	int32 CurrentRun = 0;
+	bool bPluginActive = false;
+	bool bOriginalBatched = true;
+
+	// Samples for the run being measured
+	double ActivationRequestTime = 0.0;
+	double ActivationCompleteTime = 0.0;
+	TArray<double> FrameMsSamples;
+
+	TArray<FRunResult> Results;
+};
@@ -2,30 +2,236 @@
 
 #include "Tests/UltraTestControllerBootTest.h"
 
+#include "Dom/JsonObject.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameModes/UltraExperienceDefinition.h"
+#include "GameModes/UltraExperienceManagerComponent.h"
+#include "GameModes/UltraUserFacingExperienceDefinition.h"
+#include "HAL/PlatformMemory.h"
+#include "LoadingScreenManager.h"
+#include "Misc/CommandLine.h"
+#include "Serialization/JsonSerializer.h"
+#include "System/UltraAssetManager.h"
+#include "Tests/UltraTestReport.h"
+#include "UI/Frontend/UltraFrontendStateComponent.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+#include "UltraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UltraTestControllerBootTest)
 
+void UUltraTestControllerBootTest::OnInit()
+{
+	Super::OnInit();
+
+	Milestones[(int32)EMilestone::AssetManagerStartup].Name = TEXT("AssetManagerStartup");
+	Milestones[(int32)EMilestone::FrontendExperienceLoaded].Name = TEXT("FrontendExperienceLoaded");
+	Milestones[(int32)EMilestone::LoadingScreenDismissed].Name = TEXT("LoadingScreenDismissed");
+	Milestones[(int32)EMilestone::ServerExperienceLoaded].Name = TEXT("ServerExperienceLoaded");
+
+	// Dedicated servers skip the frontend and go straight to the match experience
+	const bool bDedicatedServer = IsRunningDedicatedServer();
+	Milestones[(int32)EMilestone::FrontendExperienceLoaded].bRequired = !bDedicatedServer;
+	Milestones[(int32)EMilestone::LoadingScreenDismissed].bRequired = !bDedicatedServer;
+	Milestones[(int32)EMilestone::ServerExperienceLoaded].bRequired = bDedicatedServer;
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("BootTestBudgetAssetManager="), Milestones[(int32)EMilestone::AssetManagerStartup].BudgetSeconds);
+	FParse::Value(CommandLine, TEXT("BootTestBudgetFrontend="), Milestones[(int32)EMilestone::FrontendExperienceLoaded].BudgetSeconds);
+	FParse::Value(CommandLine, TEXT("BootTestBudgetLoadingScreen="), Milestones[(int32)EMilestone::LoadingScreenDismissed].BudgetSeconds);
+	FParse::Value(CommandLine, TEXT("BootTestBudgetServerExperience="), Milestones[(int32)EMilestone::ServerExperienceLoaded].BudgetSeconds);
+	FParse::Value(CommandLine, TEXT("BootTestMemoryBudgetMB="), MemoryBudgetMB);
+	FParse::Value(CommandLine, TEXT("BootTestTimeout="), TimeoutSeconds);
+	bAllowUserFacingLoads = FParse::Param(CommandLine, TEXT("BootTestAllowUserFacingLoads"));
+}
+
+void UUltraTestControllerBootTest::OnTick(float TimeDelta)
+{
+	// Not calling Super, it would end the test with success regardless of budgets
+	if (bFinished)
+	{
+		return;
+	}
+
+	UpdateMilestones();
+
+	const bool bTimedOut = GetTimeSinceProcessStart(FPlatformTime::Seconds()) > TimeoutSeconds;
+	if (IsBootProcessComplete() || bTimedOut)
+	{
+		bFinished = true;
+		const bool bPassed = WriteReportAndCheckBudgets(bTimedOut);
+		EndTest(bPassed ? 0 : 1);
+	}
+}
+
 bool UUltraTestControllerBootTest::IsBootProcessComplete() const
 {
-	static double StartTime = FPlatformTime::Seconds();
-	const double TimeSinceStart = FPlatformTime::Seconds() - StartTime;
+	return AreAllMilestonesReached() && (GetTimeSinceProcessStart(FPlatformTime::Seconds()) >= TestDelay);
+}
+
+void UUltraTestControllerBootTest::UpdateMilestones()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (!Milestones[(int32)EMilestone::AssetManagerStartup].IsReached())
+	{
+		// The startup jobs normally finish before Gauntlet starts ticking, so this uses the recorded time (memory and packages are sampled now)
+		const UUltraAssetManager& AssetManager = UUltraAssetManager::Get();
+		if (AssetManager.GetStartupJobsCompletedTime() > 0.0)
+		{
+			ReachMilestone(EMilestone::AssetManagerStartup, AssetManager.GetStartupJobsCompletedTime());
+		}
+	}
+
+	const UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	const AGameStateBase* GameState = World->GetGameState();
+	const UUltraExperienceManagerComponent* ExperienceComponent = GameState ? GameState->FindComponentByClass<UUltraExperienceManagerComponent>() : nullptr;
+	if (ExperienceComponent && ExperienceComponent->IsExperienceLoaded())
+	{
+		const bool bIsFrontend = (GameState->FindComponentByClass<UUltraFrontendStateComponent>() != nullptr);
+		if (bIsFrontend && !Milestones[(int32)EMilestone::FrontendExperienceLoaded].IsReached())
+		{
+			ReachMilestone(EMilestone::FrontendExperienceLoaded, Now);
+		}
+		else if (!bIsFrontend && Milestones[(int32)EMilestone::ServerExperienceLoaded].bRequired && !Milestones[(int32)EMilestone::ServerExperienceLoaded].IsReached())
+		{
+			ServerExperienceName = ExperienceComponent->GetCurrentExperienceChecked()->GetPrimaryAssetId().ToString();
+			NumUserFacingExperiencesLoaded = GetNumLoadedUserFacingExperiences();
+			ReachMilestone(EMilestone::ServerExperienceLoaded, Now);
+		}
+	}
+
+	if (Milestones[(int32)EMilestone::FrontendExperienceLoaded].IsReached() && !Milestones[(int32)EMilestone::LoadingScreenDismissed].IsReached())
+	{
+		// Servers have no loading screen manager, treat that as already dismissed
+		const UGameInstance* GameInstance = World->GetGameInstance();
+		const ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr;
+		if ((LoadingScreenManager == nullptr) || !LoadingScreenManager->GetLoadingScreenDisplayStatus())
+		{
+			ReachMilestone(EMilestone::LoadingScreenDismissed, Now);
+		}
+	}
+}
+
+void UUltraTestControllerBootTest::ReachMilestone(EMilestone Milestone, double PlatformTime)
+{
+	int32 NumLoadedPackages = 0;
+	for (TObjectIterator<UPackage> PackageIt; PackageIt; ++PackageIt)
+	{
+		++NumLoadedPackages;
+	}
+
+	FMilestoneRecord& Record = Milestones[(int32)Milestone];
+	Record.Time = GetTimeSinceProcessStart(PlatformTime);
+	Record.PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+	Record.NumLoadedPackages = NumLoadedPackages;
+
+	UE_LOG(LogUltra, Display, TEXT("BootTest: %s at %.2fs, peak memory %.1f MB, %d packages loaded"),
+		Record.Name, Record.Time, Record.PeakUsedPhysical / (1024.0 * 1024.0), Record.NumLoadedPackages);
+}
+
+bool UUltraTestControllerBootTest::AreAllMilestonesReached() const
+{
+	for (const FMilestoneRecord& Record : Milestones)
+	{
+		if (Record.bRequired && !Record.IsReached())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UUltraTestControllerBootTest::WriteReportAndCheckBudgets(bool bTimedOut) const
+{
+	bool bPassed = !bTimedOut;
+	if (bTimedOut)
+	{
+		UE_LOG(LogUltra, Error, TEXT("BootTest: not all milestones were reached within %.0f seconds"), TimeoutSeconds);
+	}
+
+	uint64 PeakUsedPhysical = 0;
+	TArray<TSharedPtr<FJsonValue>> MilestoneValues;
+	for (const FMilestoneRecord& Record : Milestones)
+	{
+		TSharedRef<FJsonObject> MilestoneObject = MakeShared<FJsonObject>();
+		MilestoneObject->SetStringField(TEXT("name"), Record.Name);
+		MilestoneObject->SetBoolField(TEXT("required"), Record.bRequired);
+		MilestoneObject->SetBoolField(TEXT("reached"), Record.IsReached());
+		MilestoneObject->SetNumberField(TEXT("seconds"), Record.Time);
+		MilestoneObject->SetNumberField(TEXT("budgetSeconds"), Record.BudgetSeconds);
+		MilestoneObject->SetNumberField(TEXT("peakUsedPhysicalMB"), Record.PeakUsedPhysical / (1024.0 * 1024.0));
+		MilestoneObject->SetNumberField(TEXT("loadedPackages"), Record.NumLoadedPackages);
+		MilestoneValues.Add(MakeShared<FJsonValueObject>(MilestoneObject));
+
+		PeakUsedPhysical = FMath::Max(PeakUsedPhysical, Record.PeakUsedPhysical);
+
+		if (Record.IsOverBudget())
+		{
+			UE_LOG(LogUltra, Error, TEXT("BootTest: %s took %.2fs, over the budget of %.2fs"), Record.Name, Record.Time, Record.BudgetSeconds);
+			bPassed = false;
+		}
+	}
 
-	if (TimeSinceStart >= TestDelay)
+	const double PeakUsedPhysicalMB = PeakUsedPhysical / (1024.0 * 1024.0);
+	if ((MemoryBudgetMB > 0.0) && (PeakUsedPhysicalMB > MemoryBudgetMB))
 	{
-		return true;
-//@TODO: actually do some useful testing here
-// 		if (const UWorld* World = GetWorld())
-// 		{
-// 			if (const UUltraGameInstance* GameInstance = Cast<UUltraGameInstance>(GetWorld()->GetGameInstance()))
-// 			{
-// 				if (GameInstance->GetCurrentState() == UltraGameInstanceState::WelcomeScreen ||
-// 					GameInstance->GetCurrentState() == UltraGameInstanceState::MainMenu)
-// 				{
-// 					return true;
-// 				}
-// 			}
-// 		}
+		UE_LOG(LogUltra, Error, TEXT("BootTest: peak memory %.1f MB is over the budget of %.1f MB"), PeakUsedPhysicalMB, MemoryBudgetMB);
+		bPassed = false;
 	}
 
-	return false;
+	const bool bDedicatedServer = Milestones[(int32)EMilestone::ServerExperienceLoaded].bRequired;
+	if (bDedicatedServer && (NumUserFacingExperiencesLoaded > 0) && !bAllowUserFacingLoads)
+	{
+		UE_LOG(LogUltra, Error, TEXT("BootTest: %d user facing experience definitions were loaded, they should be picked from the asset registry"), NumUserFacingExperiencesLoaded);
+		bPassed = false;
+	}
+
+	TSharedRef<FJsonObject> ReportObject = MakeShared<FJsonObject>();
+	ReportObject->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	ReportObject->SetStringField(TEXT("map"), GetCurrentMap());
+	ReportObject->SetBoolField(TEXT("dedicatedServer"), bDedicatedServer);
+	ReportObject->SetBoolField(TEXT("passed"), bPassed);
+	ReportObject->SetBoolField(TEXT("timedOut"), bTimedOut);
+	ReportObject->SetNumberField(TEXT("peakUsedPhysicalMB"), PeakUsedPhysicalMB);
+	ReportObject->SetNumberField(TEXT("memoryBudgetMB"), MemoryBudgetMB);
+	if (bDedicatedServer)
+	{
+		ReportObject->SetStringField(TEXT("experience"), ServerExperienceName);
+		ReportObject->SetNumberField(TEXT("loadedUserFacingExperiences"), NumUserFacingExperiencesLoaded);
+	}
+	ReportObject->SetArrayField(TEXT("milestones"), MilestoneValues);
+
+	FString Report;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Report);
+	FJsonSerializer::Serialize(ReportObject, Writer);
+
+	UltraTestReport::WriteReport(TEXT("BootTest"), TEXT("json"), Report);
+
+	return bPassed;
+}
+
+double UUltraTestControllerBootTest::GetTimeSinceProcessStart(double PlatformTime)
+{
+	return PlatformTime - GStartTime;
+}
+
+int32 UUltraTestControllerBootTest::GetNumLoadedUserFacingExperiences()
+{
+	int32 NumLoaded = 0;
+	for (TObjectIterator<UUltraUserFacingExperienceDefinition> It; It; ++It)
+	{
+		if (!It->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			++NumLoaded;
+		}
+	}
+	return NumLoaded;
 }
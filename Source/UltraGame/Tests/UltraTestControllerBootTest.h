@@ -8,6 +8,21 @@
 
 class UObject;
 
+/**
+ * Boot time test, run with -gauntlet=UltraTestControllerBootTest (works with -nullrhi).
+ *
+ * Records when the asset manager startup jobs finished, when the frontend experience loaded and when the
+ * loading screen was dismissed, along with the peak memory and number of loaded packages at each point.
+ * On a dedicated server (e.g. UltraServer -nullrhi -gauntlet=UltraTestControllerBootTest [-UserExperience=<Name>]) the frontend
+ * and loading screen milestones are replaced by the first match experience finishing loading, and the report also lists which
+ * experience it was and how many user-facing experience definitions were loaded along the way (picking the match should not need any).
+ * The results are written as JSON to <ProfilingDir>/BootTest/.
+ *
+ * Budgets in seconds since process start can be given with -BootTestBudgetAssetManager=, -BootTestBudgetFrontend=,
+ * -BootTestBudgetLoadingScreen= and -BootTestBudgetServerExperience=, and a peak memory budget with -BootTestMemoryBudgetMB=.
+ * The test fails if any budget is exceeded, if a dedicated server loaded a user-facing experience definition (unless
+ * -BootTestAllowUserFacingLoads is given) or if the milestones are not all reached within -BootTestTimeout= (default 300).
+ */
 UCLASS()
 class UUltraTestControllerBootTest : public UGauntletTestControllerBootTest
 {
@@ -20,7 +35,61 @@ protected:
 	//@TODO: Comment and delay copied from UltraGame.  Still needed?
 	const double TestDelay = 20.0f;
 
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
 	//~UGauntletTestControllerBootTest interface
 	virtual bool IsBootProcessComplete() const override;
 	//~End of UGauntletTestControllerBootTest interface
-};
\ No newline at end of file
+
+private:
+	enum class EMilestone : uint8
+	{
+		AssetManagerStartup,
+		FrontendExperienceLoaded,
+		LoadingScreenDismissed,
+		ServerExperienceLoaded,
+		Count
+	};
+
+	struct FMilestoneRecord
+	{
+		const TCHAR* Name = nullptr;
+
+		// Seconds since process start, negative until reached
+		double Time = -1.0;
+		uint64 PeakUsedPhysical = 0;
+		int32 NumLoadedPackages = 0;
+
+		// Zero means no budget
+		double BudgetSeconds = 0.0;
+
+		// Milestones that don't apply to this process (e.g. the frontend on a dedicated server) are not waited for
+		bool bRequired = true;
+
+		bool IsReached() const { return Time >= 0.0; }
+		bool IsOverBudget() const { return IsReached() && (BudgetSeconds > 0.0) && (Time > BudgetSeconds); }
+	};
+
+	void UpdateMilestones();
+	void ReachMilestone(EMilestone Milestone, double PlatformTime);
+	bool AreAllMilestonesReached() const;
+	bool WriteReportAndCheckBudgets(bool bTimedOut) const;
+
+	static double GetTimeSinceProcessStart(double PlatformTime);
+	static int32 GetNumLoadedUserFacingExperiences();
+
+private:
+	FMilestoneRecord Milestones[(int32)EMilestone::Count];
+
+	// Primary asset ID of the experience that reached ServerExperienceLoaded
+	FString ServerExperienceName;
+	int32 NumUserFacingExperiencesLoaded = 0;
+
+	double MemoryBudgetMB = 0.0;
+	double TimeoutSeconds = 300.0;
+	bool bAllowUserFacingLoads = false;
+	bool bFinished = false;
+};
@@ -0,0 +1,304 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#include "Tests/UltraTestControllerBotSoak.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AIController.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameModes/UltraBotCreationComponent.h"
+#include "GameModes/UltraExperienceManagerComponent.h"
+#include "Misc/CommandLine.h"
+#include "RenderCore.h"
+#include "System/UltraReplicationGraph.h"
+#include "Tests/UltraTestReport.h"
+#include "UltraLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraTestControllerBotSoak)
+
+void UUltraTestControllerBotSoak::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString StepsString(TEXT("8,16,32,64,128"));
+	FParse::Value(CommandLine, TEXT("BotSoakSteps="), StepsString);
+
+	TArray<FString> StepStrings;
+	StepsString.ParseIntoArray(StepStrings, TEXT(","));
+	for (const FString& StepString : StepStrings)
+	{
+		BotSteps.Add(FMath::Max(FCString::Atoi(*StepString), 0));
+	}
+
+	FParse::Value(CommandLine, TEXT("BotSoakStepSeconds="), StepSeconds);
+	FParse::Value(CommandLine, TEXT("BotSoakWarmupSeconds="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("BotSoakCommandInterval="), BotCommandIntervalSeconds);
+
+	FString AbilityTagString;
+	if (FParse::Value(CommandLine, TEXT("BotSoakAbilityTag="), AbilityTagString))
+	{
+		const FGameplayTag AbilityTag = FGameplayTag::RequestGameplayTag(FName(*AbilityTagString), /*ErrorIfNotFound=*/ false);
+		if (AbilityTag.IsValid())
+		{
+			AbilityTagsToActivate.AddTag(AbilityTag);
+		}
+		else
+		{
+			UE_LOG(LogUltra, Warning, TEXT("BotSoak: unknown ability tag %s, bots will only move"), *AbilityTagString);
+		}
+	}
+
+	// Seeded so every run issues the same sequence of commands
+	int32 Seed = 1234;
+	FParse::Value(CommandLine, TEXT("BotSoakSeed="), Seed);
+	RandomStream.Initialize(Seed);
+
+	SetPhase(EPhase::WaitingForExperience);
+}
+
+UUltraBotCreationComponent* UUltraTestControllerBotSoak::FindBotCreationComponent() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState == nullptr)
+	{
+		return nullptr;
+	}
+
+	const UUltraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<UUltraExperienceManagerComponent>();
+	if ((ExperienceComponent == nullptr) || !ExperienceComponent->IsExperienceLoaded())
+	{
+		return nullptr;
+	}
+
+	return GameState->FindComponentByClass<UUltraBotCreationComponent>();
+}
+
+void UUltraTestControllerBotSoak::SetPhase(EPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void UUltraTestControllerBotSoak::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (Phase == EPhase::Done)
+	{
+		return;
+	}
+
+#if WITH_SERVER_CODE
+	UUltraBotCreationComponent* BotComponent = FindBotCreationComponent();
+	if (BotComponent == nullptr)
+	{
+		if ((Phase != EPhase::WaitingForExperience) || ((FPlatformTime::Seconds() - PhaseStartTime) > 300.0))
+		{
+			UE_LOG(LogUltra, Error, TEXT("BotSoak: no loaded experience with a bot creation component in %s"), *GetCurrentMap());
+			SetPhase(EPhase::Done);
+			EndTest(1);
+		}
+		return;
+	}
+
+	MarkHeartbeatActive();
+
+	switch (Phase)
+	{
+	case EPhase::WaitingForExperience:
+		if (BotSteps.Num() == 0)
+		{
+			SetPhase(EPhase::Done);
+			EndTest(0);
+			return;
+		}
+		CurrentStepIndex = 0;
+		SetPhase(EPhase::Ramping);
+		break;
+
+	case EPhase::Ramping:
+		TickRamping(BotComponent);
+		break;
+
+	case EPhase::WarmingUp:
+		DriveBots(BotComponent);
+		if ((FPlatformTime::Seconds() - PhaseStartTime) >= WarmupSeconds)
+		{
+			GameThreadMsSamples.Reset();
+			FrameMsSum = 0.0;
+			ReplicationMsSum = 0.0;
+			ReplicationMsMax = 0.0;
+			BytesOutPerConnectionSum = 0.0;
+			MaxConnections = 0;
+			SetPhase(EPhase::Measuring);
+		}
+		break;
+
+	case EPhase::Measuring:
+		TickMeasuring(BotComponent, TimeDelta);
+		break;
+
+	default:
+		break;
+	}
+#else
+	UE_LOG(LogUltra, Error, TEXT("BotSoak: must be run on a build with server code"));
+	SetPhase(EPhase::Done);
+	EndTest(1);
+#endif
+}
+
+void UUltraTestControllerBotSoak::TickRamping(UUltraBotCreationComponent* BotComponent)
+{
+#if WITH_SERVER_CODE
+	// Spread spawning over several frames so a step doesn't start with a huge hitch
+	const int32 TargetBots = BotSteps[CurrentStepIndex];
+	for (int32 Count = 0; (Count < BotsPerFrame) && (BotComponent->GetNumSpawnedBots() != TargetBots); ++Count)
+	{
+		if (BotComponent->GetNumSpawnedBots() < TargetBots)
+		{
+			BotComponent->Cheat_AddBot();
+		}
+		else
+		{
+			BotComponent->Cheat_RemoveBot();
+		}
+	}
+
+	if (BotComponent->GetNumSpawnedBots() == TargetBots)
+	{
+		UE_LOG(LogUltra, Display, TEXT("BotSoak: reached %d bots, warming up for %.0fs"), TargetBots, WarmupSeconds);
+		LastBotCommandTime = 0.0;
+		SetPhase(EPhase::WarmingUp);
+	}
+#endif
+}
+
+void UUltraTestControllerBotSoak::TickMeasuring(UUltraBotCreationComponent* BotComponent, float TimeDelta)
+{
+	DriveBots(BotComponent);
+
+	UWorld* World = GetWorld();
+
+	GameThreadMsSamples.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	FrameMsSum += TimeDelta * 1000.0;
+
+	if (UNetDriver* NetDriver = World->GetNetDriver())
+	{
+		if (const UUltraReplicationGraph* RepGraph = Cast<UUltraReplicationGraph>(NetDriver->GetReplicationDriver()))
+		{
+			const double ReplicationMs = RepGraph->GetLastServerReplicateActorsSeconds() * 1000.0;
+			ReplicationMsSum += ReplicationMs;
+			ReplicationMsMax = FMath::Max(ReplicationMsMax, ReplicationMs);
+		}
+
+		const int32 NumConnections = NetDriver->ClientConnections.Num();
+		if (NumConnections > 0)
+		{
+			int64 BytesOut = 0;
+			for (const UNetConnection* Connection : NetDriver->ClientConnections)
+			{
+				BytesOut += Connection->OutBytesPerSecond;
+			}
+			BytesOutPerConnectionSum += (double)BytesOut / NumConnections;
+		}
+		MaxConnections = FMath::Max(MaxConnections, NumConnections);
+	}
+
+	if ((FPlatformTime::Seconds() - PhaseStartTime) >= StepSeconds)
+	{
+		FinishStep();
+	}
+}
+
+void UUltraTestControllerBotSoak::DriveBots(UUltraBotCreationComponent* BotComponent)
+{
+	const double Now = FPlatformTime::Seconds();
+	if ((Now - LastBotCommandTime) < BotCommandIntervalSeconds)
+	{
+		return;
+	}
+	LastBotCommandTime = Now;
+
+#if WITH_SERVER_CODE
+	for (AAIController* Bot : BotComponent->GetSpawnedBots())
+	{
+		APawn* Pawn = Bot ? Bot->GetPawn() : nullptr;
+		if (Pawn == nullptr)
+		{
+			continue;
+		}
+
+		const FVector2D Offset = FVector2D(RandomStream.FRandRange(-1500.0, 1500.0), RandomStream.FRandRange(-1500.0, 1500.0));
+		Bot->MoveToLocation(Pawn->GetActorLocation() + FVector(Offset, 0.0));
+
+		if (!AbilityTagsToActivate.IsEmpty())
+		{
+			if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn))
+			{
+				ASC->TryActivateAbilitiesByTag(AbilityTagsToActivate);
+			}
+		}
+	}
+#endif
+}
+
+void UUltraTestControllerBotSoak::FinishStep()
+{
+	FStepResult& Result = Results.AddDefaulted_GetRef();
+	Result.NumBots = BotSteps[CurrentStepIndex];
+	Result.NumFrames = GameThreadMsSamples.Num();
+	Result.NumConnections = MaxConnections;
+
+	if (Result.NumFrames > 0)
+	{
+		double GameThreadMsSum = 0.0;
+		for (double Sample : GameThreadMsSamples)
+		{
+			GameThreadMsSum += Sample;
+		}
+		GameThreadMsSamples.Sort();
+
+		Result.AvgGameThreadMs = GameThreadMsSum / Result.NumFrames;
+		Result.P95GameThreadMs = GameThreadMsSamples[FMath::Clamp(FMath::CeilToInt(0.95 * Result.NumFrames) - 1, 0, Result.NumFrames - 1)];
+		Result.AvgFrameMs = FrameMsSum / Result.NumFrames;
+		Result.AvgReplicationMs = ReplicationMsSum / Result.NumFrames;
+		Result.MaxReplicationMs = ReplicationMsMax;
+		Result.AvgBytesOutPerConnection = BytesOutPerConnectionSum / Result.NumFrames;
+	}
+
+	UE_LOG(LogUltra, Display, TEXT("BotSoak: %d bots, game thread avg %.2fms p95 %.2fms, replication avg %.2fms, %.0f bytes/s per connection"),
+		Result.NumBots, Result.AvgGameThreadMs, Result.P95GameThreadMs, Result.AvgReplicationMs, Result.AvgBytesOutPerConnection);
+
+	++CurrentStepIndex;
+	if (CurrentStepIndex < BotSteps.Num())
+	{
+		SetPhase(EPhase::Ramping);
+	}
+	else
+	{
+		WriteReport();
+		SetPhase(EPhase::Done);
+		EndTest(0);
+	}
+}
+
+void UUltraTestControllerBotSoak::WriteReport() const
+{
+	FString Report = TEXT("Bots,Frames,Connections,AvgGameThreadMs,P95GameThreadMs,AvgFrameMs,AvgReplicationMs,MaxReplicationMs,AvgBytesOutPerConnection\n");
+	for (const FStepResult& Result : Results)
+	{
+		Report += FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f\n"),
+			Result.NumBots, Result.NumFrames, Result.NumConnections, Result.AvgGameThreadMs, Result.P95GameThreadMs,
+			Result.AvgFrameMs, Result.AvgReplicationMs, Result.MaxReplicationMs, Result.AvgBytesOutPerConnection);
+	}
+
+	UltraTestReport::WriteReport(TEXT("BotSoak"), TEXT("csv"), Report);
+}
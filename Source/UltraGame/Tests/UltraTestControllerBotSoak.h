@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "GauntletTestController.h"
+
+#include "UltraTestControllerBotSoak.generated.h"
+
+class UObject;
+class UUltraBotCreationComponent;
+
+/**
+ * Server scaling soak test.
+ *
+ * Run on a dedicated server, e.g. UltraServer <Map> -nullrhi -gauntlet=UltraTestControllerBotSoak
+ * Once the experience has loaded it steps the number of bots through -BotSoakSteps (default 8,16,32,64,128),
+ * letting each step settle for -BotSoakWarmupSeconds and then measuring for -BotSoakStepSeconds.
+ * While measuring, bots are periodically sent to random nearby locations and, if -BotSoakAbilityTag is given,
+ * told to activate abilities with that tag.
+ *
+ * For every step one row is written to <ProfilingDir>/BotSoak/ with game thread time, frame time,
+ * replication graph time and outgoing bandwidth per client connection, then the test exits.
+ */
+UCLASS()
+class UUltraTestControllerBotSoak : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class EPhase : uint8
+	{
+		WaitingForExperience,
+		Ramping,
+		WarmingUp,
+		Measuring,
+		Done
+	};
+
+	struct FStepResult
+	{
+		int32 NumBots = 0;
+		int32 NumFrames = 0;
+		int32 NumConnections = 0;
+		double AvgGameThreadMs = 0.0;
+		double P95GameThreadMs = 0.0;
+		double AvgFrameMs = 0.0;
+		double AvgReplicationMs = 0.0;
+		double MaxReplicationMs = 0.0;
+		double AvgBytesOutPerConnection = 0.0;
+	};
+
+	UUltraBotCreationComponent* FindBotCreationComponent() const;
+
+	void SetPhase(EPhase NewPhase);
+	void TickRamping(UUltraBotCreationComponent* BotComponent);
+	void TickMeasuring(UUltraBotCreationComponent* BotComponent, float TimeDelta);
+	void DriveBots(UUltraBotCreationComponent* BotComponent);
+	void FinishStep();
+	void WriteReport() const;
+
+private:
+	TArray<int32> BotSteps;
+	int32 CurrentStepIndex = 0;
+
+	double StepSeconds = 60.0;
+	double WarmupSeconds = 15.0;
+	double BotCommandIntervalSeconds = 4.0;
+	int32 BotsPerFrame = 4;
+
+	FGameplayTagContainer AbilityTagsToActivate;
+	FRandomStream RandomStream;
+
+	EPhase Phase = EPhase::WaitingForExperience;
+	double PhaseStartTime = 0.0;
+	double LastBotCommandTime = 0.0;
+
+	// Samples for the step being measured
+	TArray<double> GameThreadMsSamples;
+	double FrameMsSum = 0.0;
+	double ReplicationMsSum = 0.0;
+	double ReplicationMsMax = 0.0;
+	double BytesOutPerConnectionSum = 0.0;
+	int32 MaxConnections = 0;
+
+	TArray<FStepResult> Results;
+};
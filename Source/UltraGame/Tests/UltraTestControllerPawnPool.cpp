@@ -0,0 +1,249 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#include "Tests/UltraTestControllerPawnPool.h"
+
+#include "AbilitySystem/UltraAbilitySystemComponent.h"
+#include "AIController.h"
+#include "Character/UltraCharacter.h"
+#include "Character/UltraDespawnComponent.h"
+#include "Character/UltraPawnExtensionComponent.h"
+#include "Character/UltraPawnPoolSubsystem.h"
+#include "Components/GameFrameworkComponentManager.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameModes/UltraBotCreationComponent.h"
+#include "GameModes/UltraExperienceManagerComponent.h"
+#include "GameModes/UltraGameMode.h"
+#include "Misc/CommandLine.h"
+#include "UltraGameplayTags.h"
+#include "UltraLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UltraTestControllerPawnPool)
+
+void UUltraTestControllerPawnPool::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("PawnPoolCycles="), NumCycles);
+	FParse::Value(CommandLine, TEXT("PawnPoolStepTimeout="), StepTimeoutSeconds);
+	NumCycles = FMath::Max(NumCycles, 1);
+
+	SetPhase(EPhase::WaitingForExperience);
+}
+
+UUltraBotCreationComponent* UUltraTestControllerPawnPool::FindBotCreationComponent() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState == nullptr)
+	{
+		return nullptr;
+	}
+
+	const UUltraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<UUltraExperienceManagerComponent>();
+	if ((ExperienceComponent == nullptr) || !ExperienceComponent->IsExperienceLoaded())
+	{
+		return nullptr;
+	}
+
+	return GameState->FindComponentByClass<UUltraBotCreationComponent>();
+}
+
+void UUltraTestControllerPawnPool::SetPhase(EPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+	ReadyTime = 0.0;
+}
+
+void UUltraTestControllerPawnPool::Finish(bool bSuccess)
+{
+	if (bSuccess)
+	{
+		UE_LOG(LogUltra, Display, TEXT("PawnPool: %d recycled pawns matched the freshly spawned pawn"), NumCycles);
+	}
+
+	SetPhase(EPhase::Done);
+	EndTest(bSuccess ? 0 : 1);
+}
+
+bool UUltraTestControllerPawnPool::IsPawnReady(APawn* Pawn) const
+{
+	if (Pawn == nullptr)
+	{
+		return false;
+	}
+
+	UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(Pawn);
+	if ((Manager == nullptr) || !Manager->HasFeatureReachedInitState(Pawn, UUltraPawnExtensionComponent::NAME_ActorFeatureName, UltraGameplayTags::InitState_GameplayReady))
+	{
+		return false;
+	}
+
+	const UUltraPawnExtensionComponent* PawnExtComp = UUltraPawnExtensionComponent::FindPawnExtensionComponent(Pawn);
+	const UUltraAbilitySystemComponent* UltraASC = PawnExtComp ? PawnExtComp->GetUltraAbilitySystemComponent() : nullptr;
+	return (UltraASC != nullptr) && (UltraASC->GetAvatarActor() == Pawn);
+}
+
+bool UUltraTestControllerPawnPool::CompareSnapshots(const FUltraPawnPoolSnapshot& Fresh, const FUltraPawnPoolSnapshot& Recycled) const
+{
+	return FUltraPawnPoolSnapshot::Compare(Fresh, Recycled, [this](const TCHAR* What, const FString& FreshValue, const FString& RecycledValue)
+	{
+		UE_LOG(LogUltra, Error, TEXT("PawnPool: cycle %d %s differs, fresh [%s] recycled [%s]"), CurrentCycle, What, *FreshValue, *RecycledValue);
+	});
+}
+
+void UUltraTestControllerPawnPool::DespawnBotPawn()
+{
+	APawn* Pawn = Bot.IsValid() ? Bot->GetPawn() : nullptr;
+	UUltraDespawnComponent* DespawnComponent = UUltraDespawnComponent::FindDespawnComponent(Pawn);
+	if (DespawnComponent == nullptr)
+	{
+		UE_LOG(LogUltra, Error, TEXT("PawnPool: bot pawn [%s] has no despawn component"), *GetNameSafe(Pawn));
+		Finish(false);
+		return;
+	}
+
+	DespawnedPawn = Pawn;
+	DespawnComponent->StartDespawn();
+	DespawnComponent->FinishDespawn();
+
+	SetPhase(EPhase::WaitingForPooling);
+}
+
+void UUltraTestControllerPawnPool::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (Phase == EPhase::Done)
+	{
+		return;
+	}
+
+#if WITH_SERVER_CODE
+	UWorld* World = GetWorld();
+	const double Now = FPlatformTime::Seconds();
+	const double Timeout = (Phase == EPhase::WaitingForExperience) ? 300.0 : StepTimeoutSeconds;
+	if ((Now - PhaseStartTime) > Timeout)
+	{
+		UE_LOG(LogUltra, Error, TEXT("PawnPool: timed out in phase %d of cycle %d"), (int32)Phase, CurrentCycle);
+		Finish(false);
+		return;
+	}
+
+	MarkHeartbeatActive();
+
+	switch (Phase)
+	{
+	case EPhase::WaitingForExperience:
+		if (UUltraBotCreationComponent* BotComponent = FindBotCreationComponent())
+		{
+			UUltraPawnPoolSubsystem* PawnPool = UWorld::GetSubsystem<UUltraPawnPoolSubsystem>(World);
+			if ((PawnPool == nullptr) || !World->GetAuthGameMode<AUltraGameMode>())
+			{
+				UE_LOG(LogUltra, Error, TEXT("PawnPool: must be run on the server with an Ultra game mode"));
+				Finish(false);
+				return;
+			}
+
+			if (!PawnPool->IsRecyclingEnabled())
+			{
+				PawnPool->ConfigurePool(true, 4);
+			}
+
+			const int32 NumBotsBefore = BotComponent->GetNumSpawnedBots();
+			BotComponent->Cheat_AddBot();
+			if (BotComponent->GetNumSpawnedBots() == NumBotsBefore)
+			{
+				UE_LOG(LogUltra, Error, TEXT("PawnPool: failed to add a bot"));
+				Finish(false);
+				return;
+			}
+
+			Bot = BotComponent->GetSpawnedBots().Last();
+			SetPhase(EPhase::WaitingForFreshPawn);
+		}
+		break;
+
+	case EPhase::WaitingForFreshPawn:
+	case EPhase::WaitingForRecycledPawn:
+	{
+		APawn* Pawn = Bot.IsValid() ? Bot->GetPawn() : nullptr;
+		if (!IsPawnReady(Pawn))
+		{
+			break;
+		}
+
+		if (ReadyTime == 0.0)
+		{
+			ReadyTime = Now;
+		}
+		if ((Now - ReadyTime) < SettleSeconds)
+		{
+			break;
+		}
+
+		if (Phase == EPhase::WaitingForFreshPawn)
+		{
+			FreshSnapshot = FUltraPawnPoolSnapshot::Capture(Pawn);
+			DespawnBotPawn();
+			break;
+		}
+
+		if (Pawn != DespawnedPawn.Get())
+		{
+			UE_LOG(LogUltra, Error, TEXT("PawnPool: cycle %d spawned a new pawn [%s] instead of reusing [%s]"), CurrentCycle, *GetNameSafe(Pawn), *GetNameSafe(DespawnedPawn.Get()));
+			Finish(false);
+			return;
+		}
+
+		if (!CompareSnapshots(FreshSnapshot, FUltraPawnPoolSnapshot::Capture(Pawn)))
+		{
+			Finish(false);
+			return;
+		}
+
+		UE_LOG(LogUltra, Display, TEXT("PawnPool: cycle %d reused [%s] and matches the fresh pawn"), CurrentCycle, *GetNameSafe(Pawn));
+
+		++CurrentCycle;
+		if (CurrentCycle >= NumCycles)
+		{
+			Finish(true);
+			return;
+		}
+
+		DespawnBotPawn();
+		break;
+	}
+
+	case EPhase::WaitingForPooling:
+		if (const UUltraPawnPoolSubsystem* PawnPool = UWorld::GetSubsystem<UUltraPawnPoolSubsystem>(World))
+		{
+			if (PawnPool->IsPawnPooled(DespawnedPawn.Get()))
+			{
+				const FUltraPawnPoolSnapshot PooledSnapshot = FUltraPawnPoolSnapshot::Capture(DespawnedPawn.Get());
+				if (PooledSnapshot.bActorTickEnabled || PooledSnapshot.bMovementTickEnabled || PooledSnapshot.bMeshTickEnabled)
+				{
+					UE_LOG(LogUltra, Error, TEXT("PawnPool: cycle %d pooled pawn [%s] is still ticking"), CurrentCycle, *GetNameSafe(DespawnedPawn.Get()));
+					Finish(false);
+					return;
+				}
+
+				if (AUltraGameMode* GameMode = World->GetAuthGameMode<AUltraGameMode>())
+				{
+					GameMode->RequestPlayerRestartNextFrame(Bot.Get());
+				}
+				SetPhase(EPhase::WaitingForRecycledPawn);
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+#else
+	UE_LOG(LogUltra, Error, TEXT("PawnPool: must be run on a build with server code"));
+	Finish(false);
+#endif
+}
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#pragma once
+
+#include "GauntletTestController.h"
+#include "Tests/UltraPawnPoolSnapshot.h"
+
+#include "UltraTestControllerPawnPool.generated.h"
+
+class AAIController;
+class APawn;
+class UObject;
+class UUltraBotCreationComponent;
+
+/**
+ * Pawn recycling equivalence test.
+ *
+ * Run on a server or standalone game, e.g. UltraServer <Map> -nullrhi -gauntlet=UltraTestControllerPawnPool
+ * Once the experience has loaded it turns on pawn recycling, adds a bot and records the state of its freshly spawned pawn.
+ * The bot is then despawned and restarted -PawnPoolCycles times (default 5). Every restart must reuse the pooled pawn,
+ * and once initialized the recycled pawn must match the fresh one (see FUltraPawnPoolSnapshot). While pooled the pawn must not tick.
+ * The same equivalence is covered without a running game by the Ultra.Character.PawnPool automation test.
+ * Each step has to finish within -PawnPoolStepTimeout seconds (default 30). Any mismatch or timeout fails the test.
+ */
+UCLASS()
+class UUltraTestControllerPawnPool : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class EPhase : uint8
+	{
+		WaitingForExperience,
+		WaitingForFreshPawn,
+		WaitingForPooling,
+		WaitingForRecycledPawn,
+		Done
+	};
+
+	UUltraBotCreationComponent* FindBotCreationComponent() const;
+	bool IsPawnReady(APawn* Pawn) const;
+	bool CompareSnapshots(const FUltraPawnPoolSnapshot& Fresh, const FUltraPawnPoolSnapshot& Recycled) const;
+
+	void SetPhase(EPhase NewPhase);
+	void DespawnBotPawn();
+	void Finish(bool bSuccess);
+
+private:
+	int32 NumCycles = 5;
+	double StepTimeoutSeconds = 30.0;
+
+	// Time to let a ready pawn settle (land, run on spawn abilities) before it is captured
+	double SettleSeconds = 1.0;
+
+	EPhase Phase = EPhase::WaitingForExperience;
+	double PhaseStartTime = 0.0;
+	double ReadyTime = 0.0;
+
+	int32 CurrentCycle = 0;
+
+	TWeakObjectPtr<AAIController> Bot;
+	TWeakObjectPtr<APawn> DespawnedPawn;
+
+	FUltraPawnPoolSnapshot FreshSnapshot;
+};
@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/UltraTestReport.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UltraLogChannels.h"
+
+bool UltraTestReport::WriteReport(const TCHAR* TestName, const TCHAR* Extension, const FString& Contents)
+{
+	const FString OutputDir = FPaths::ProfilingDir() / TestName;
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	const FString ReportFilename = OutputDir / FString::Printf(TEXT("%s_%s.%s"), TestName, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), Extension);
+	if (!FFileHelper::SaveStringToFile(Contents, *ReportFilename))
+	{
+		UE_LOG(LogUltra, Error, TEXT("%s: failed to write report to %s"), TestName, *ReportFilename);
+		return false;
+	}
+
+	UE_LOG(LogUltra, Display, TEXT("%s: wrote report to %s"), TestName, *IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*ReportFilename));
+	return true;
+}
@@ -0,0 +1,14 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/UnrealString.h"
+
+namespace UltraTestReport
+{
+	/**
+	 * Writes the report of a Gauntlet test to <ProfilingDir>/<TestName>/<TestName>_<date>_<time>.<Extension> and logs where it went.
+	 * Returns false if the file could not be written.
+	 */
+	bool WriteReport(const TCHAR* TestName, const TCHAR* Extension, const FString& Contents);
+}
@@ -73,6 +73,7 @@ public class UltraGame : ModuleRules
 				"AudioModulation",
 				"EngineSettings",
 				"DTLSHandlerComponent",
+				"Json",
 			}
 		);
 
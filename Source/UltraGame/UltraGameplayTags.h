@@ -36,6 +36,7 @@ namespace UltraGameplayTags
 	ULTRAGAME_API	UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEvent_RequestReset);
 
 	ULTRAGAME_API	UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_Score);
+	ULTRAGAME_API	UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_ResolvedScore);
 
 	ULTRAGAME_API	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cheat_GodMode);
 	ULTRAGAME_API	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cheat_UnlimitedHealth);